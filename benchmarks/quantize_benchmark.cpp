@@ -0,0 +1,142 @@
+// Measures local quantization of a full-precision GGUF against downloading the quantized
+// variant it replaces. The source is a synthetic F16 model with llama-like tensor shapes;
+// the download side is the time to fetch the produced file at a few link speeds.
+//
+// Usage: quantize_benchmark [layers] [threads]
+
+#include "model/quantizer.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+
+namespace
+{
+    constexpr uint64_t EMBEDDING = 2048;
+    constexpr uint64_t FEED_FORWARD = 5632;
+    constexpr uint64_t VOCABULARY = 32000;
+    constexpr int DEFAULT_LAYERS = 4;
+    constexpr double LINK_SPEEDS_MBPS[] = { 50.0, 100.0, 500.0, 1000.0 };
+
+    void addTensor(Model::GgufHeader& header, const std::string& name, std::vector<uint64_t> dims, Model::GgmlType type)
+    {
+        Model::GgufTensorInfo tensor;
+        tensor.name = name;
+        tensor.dims = std::move(dims);
+        tensor.type = static_cast<uint32_t>(type);
+        header.tensors.push_back(std::move(tensor));
+    }
+
+    // Writes a model of the given depth filled with normally distributed weights
+    uint64_t writeSourceModel(const std::string& path, int layers)
+    {
+        using Model::GgmlType;
+
+        Model::GgufHeader header;
+        header.metadata.push_back(Model::GgufIO::makeUInt32Entry("general.file_type", 1));
+        addTensor(header, "token_embd.weight", { EMBEDDING, VOCABULARY }, GgmlType::F16);
+        for (int layer = 0; layer < layers; ++layer)
+        {
+            const std::string prefix = "blk." + std::to_string(layer) + ".";
+            addTensor(header, prefix + "attn_norm.weight", { EMBEDDING }, GgmlType::F32);
+            for (const char* name : { "attn_q.weight", "attn_k.weight", "attn_v.weight", "attn_output.weight" })
+                addTensor(header, prefix + name, { EMBEDDING, EMBEDDING }, GgmlType::F16);
+            addTensor(header, prefix + "ffn_norm.weight", { EMBEDDING }, GgmlType::F32);
+            addTensor(header, prefix + "ffn_gate.weight", { EMBEDDING, FEED_FORWARD }, GgmlType::F16);
+            addTensor(header, prefix + "ffn_up.weight", { EMBEDDING, FEED_FORWARD }, GgmlType::F16);
+            addTensor(header, prefix + "ffn_down.weight", { FEED_FORWARD, EMBEDDING }, GgmlType::F16);
+        }
+        addTensor(header, "output_norm.weight", { EMBEDDING }, GgmlType::F32);
+        addTensor(header, "output.weight", { EMBEDDING, VOCABULARY }, GgmlType::F16);
+
+        uint64_t offset = 0;
+        for (auto& tensor : header.tensors)
+        {
+            offset = Model::alignGgufOffset(offset, header.alignment);
+            tensor.offset = offset;
+            offset += tensor.getByteSize(tensor.type);
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        const uint64_t dataOffset = Model::GgufIO::writeHeader(file, header);
+
+        std::mt19937 rng(42);
+        std::normal_distribution<float> distribution(0.0F, 0.02F);
+        std::vector<uint8_t> bytes;
+        for (const auto& tensor : header.tensors)
+        {
+            const uint64_t count = tensor.getElementCount();
+            const bool isHalf = tensor.type == static_cast<uint32_t>(GgmlType::F16);
+            bytes.resize(tensor.getByteSize(tensor.type));
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                const float value = distribution(rng);
+                if (isHalf)
+                {
+                    const uint16_t half = Model::Quantization::floatToFp16(value);
+                    std::memcpy(bytes.data() + i * 2, &half, sizeof(half));
+                }
+                else
+                {
+                    std::memcpy(bytes.data() + i * 4, &value, sizeof(value));
+                }
+            }
+            file.seekp(dataOffset + tensor.offset);
+            file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+        return dataOffset + offset;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int layers = argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_LAYERS;
+    const unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 0;
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "kolosal_quantize_benchmark";
+    std::filesystem::create_directories(directory);
+    const std::string sourcePath = (directory / "model-f16.gguf").string();
+
+    std::cout << "Writing synthetic F16 model (" << layers << " layers)...\n";
+    const uint64_t sourceBytes = writeSourceModel(sourcePath, layers);
+    std::cout << "Source: " << std::fixed << std::setprecision(1) << sourceBytes / 1048576.0 << " MiB, threads: "
+        << (threads == 0 ? std::thread::hardware_concurrency() : threads) << "\n\n";
+
+    std::cout << std::left << std::setw(10) << "Variant"
+        << std::right << std::setw(12) << "Size (MiB)" << std::setw(14) << "Quantize (s)" << std::setw(12) << "MiB/s";
+    for (double mbps : LINK_SPEEDS_MBPS)
+        std::cout << std::setw(10) << ("DL@" + std::to_string(static_cast<int>(mbps)) + "M");
+    std::cout << "\n";
+
+    for (Model::GgmlType type : { Model::GgmlType::Q8_0, Model::GgmlType::Q4_K })
+    {
+        const std::string targetPath = (directory / (type == Model::GgmlType::Q8_0 ? "model-q8_0.gguf" : "model-q4_k.gguf")).string();
+        Model::QuantizationResult result = Model::ModelQuantizer::quantizeFile(sourcePath, targetPath, type, nullptr, nullptr, threads);
+        if (!result.succeeded)
+        {
+            std::cerr << "Quantization failed: " << result.error << "\n";
+            return 1;
+        }
+
+        std::cout << std::left << std::setw(10) << (type == Model::GgmlType::Q8_0 ? "Q8_0" : "Q4_K")
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << result.outputBytes / 1048576.0
+            << std::setw(14) << std::setprecision(2) << result.seconds
+            << std::setw(12) << std::setprecision(0) << result.inputBytes / 1048576.0 / result.seconds;
+
+        // Seconds to download the same file; quantizing wins wherever this is larger
+        for (double mbps : LINK_SPEEDS_MBPS)
+            std::cout << std::setw(9) << std::setprecision(2) << result.outputBytes * 8.0 / (mbps * 1e6) << "s";
+        std::cout << "\n";
+
+        std::filesystem::remove(targetPath);
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
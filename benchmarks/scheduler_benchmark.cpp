@@ -0,0 +1,223 @@
+// Measures interactive time-to-first-token under background load, with and without the
+// inference scheduler, against a stand-in engine that decodes one job at a time in
+// submission order (the behaviour of the real engine).
+
+#include "model/inference_scheduler.hpp"
+
+#include <map>
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <condition_variable>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int PREFILL_MS_PER_MESSAGE = 4;
+    constexpr int DECODE_MS_PER_TOKEN = 2;
+    constexpr int BACKGROUND_JOBS = 8;
+    constexpr int BACKGROUND_TOKENS = 64;
+    constexpr int INTERACTIVE_TOKENS = 32;
+
+    class StandInEngine : public IInferenceEngine
+    {
+    public:
+        StandInEngine() : m_worker(&StandInEngine::run, this) {}
+
+        ~StandInEngine() override
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+            m_worker.join();
+        }
+
+        bool loadModel(const char*, const int) override { return true; }
+
+        int submitCompletionsJob(const CompletionParameters&) override { return -1; }
+
+        int submitChatCompletionsJob(const ChatCompletionParameters& params) override
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            int jobId = m_nextJobId++;
+            m_jobs[jobId] = { params, Clock::now(), {}, {}, false };
+            m_queue.push_back(jobId);
+            m_condition.notify_all();
+            return jobId;
+        }
+
+        bool isJobFinished(int jobId) override
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_jobs.at(jobId).finished;
+        }
+
+        CompletionResult getJobResult(int) override { return {}; }
+
+        void waitForJob(int jobId) override
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [&]() { return m_jobs.at(jobId).finished; });
+        }
+
+        bool hasJobError(int) override { return false; }
+        std::string getJobError(int) override { return ""; }
+
+        // Milliseconds from submission to the first decoded token
+        double firstTokenLatencyMs(int jobId)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const Job& job = m_jobs.at(jobId);
+            return std::chrono::duration<double, std::milli>(job.firstToken - job.submitted).count();
+        }
+
+        Clock::time_point finishedAt(int jobId)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_jobs.at(jobId).finishedAt;
+        }
+
+    private:
+        struct Job
+        {
+            ChatCompletionParameters params;
+            Clock::time_point submitted;
+            Clock::time_point firstToken;
+            Clock::time_point finishedAt;
+            bool finished;
+        };
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                m_condition.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+                if (m_stop)
+                    return;
+
+                int jobId = m_queue.front();
+                m_queue.pop_front();
+                ChatCompletionParameters params = m_jobs.at(jobId).params;
+                lock.unlock();
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(
+                    PREFILL_MS_PER_MESSAGE * static_cast<int>(params.messages.size())));
+                for (int token = 0; token < params.maxNewTokens; ++token)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(DECODE_MS_PER_TOKEN));
+                    if (token == 0)
+                    {
+                        std::lock_guard<std::mutex> guard(m_mutex);
+                        m_jobs.at(jobId).firstToken = Clock::now();
+                    }
+                }
+
+                lock.lock();
+                m_jobs.at(jobId).finished = true;
+                m_jobs.at(jobId).finishedAt = Clock::now();
+                m_condition.notify_all();
+            }
+        }
+
+        std::map<int, Job> m_jobs;
+        std::deque<int> m_queue;
+        int m_nextJobId = 0;
+        bool m_stop = false;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::thread m_worker;
+    };
+
+    ChatCompletionParameters makeParams(int maxNewTokens, size_t messages)
+    {
+        ChatCompletionParameters params;
+        for (size_t i = 0; i < messages; ++i)
+        {
+            params.messages.push_back({ i % 2 == 0 ? "user" : "assistant", "message" });
+        }
+        params.maxNewTokens = maxNewTokens;
+        return params;
+    }
+
+    struct Result
+    {
+        double interactiveTtftMs;
+        double backgroundDrainMs;   // until the last background job finished
+        bool backgroundInOrder;
+    };
+
+    Result runScenario(bool useScheduler)
+    {
+        StandInEngine engine;
+        Model::InferenceScheduler scheduler;
+        scheduler.setEngine(&engine);
+
+        auto start = Clock::now();
+        std::vector<std::future<int>> backgroundJobs;
+        std::vector<int> directJobs;
+        for (int i = 0; i < BACKGROUND_JOBS; ++i)
+        {
+            if (useScheduler)
+                backgroundJobs.push_back(scheduler.submitBackground(makeParams(BACKGROUND_TOKENS, 2)));
+            else
+                directJobs.push_back(engine.submitChatCompletionsJob(makeParams(BACKGROUND_TOKENS, 2)));
+        }
+
+        // The user sends a message shortly after background work was queued
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        int interactiveJob = useScheduler
+            ? scheduler.submitInteractive(&engine, makeParams(INTERACTIVE_TOKENS, 8))
+            : engine.submitChatCompletionsJob(makeParams(INTERACTIVE_TOKENS, 8));
+        engine.waitForJob(interactiveJob);
+
+        for (auto& jobId : backgroundJobs)
+        {
+            directJobs.push_back(jobId.get());
+        }
+
+        Clock::time_point previous = start;
+        bool inOrder = true;
+        for (int jobId : directJobs)
+        {
+            engine.waitForJob(jobId);
+            inOrder = inOrder && engine.finishedAt(jobId) >= previous;
+            previous = engine.finishedAt(jobId);
+        }
+
+        return {
+            engine.firstTokenLatencyMs(interactiveJob),
+            std::chrono::duration<double, std::milli>(previous - start).count(),
+            inOrder
+        };
+    }
+} // namespace
+
+int main()
+{
+    std::cout << "Stand-in engine: " << PREFILL_MS_PER_MESSAGE << " ms/message prefill, "
+        << DECODE_MS_PER_TOKEN << " ms/token decode; " << BACKGROUND_JOBS << " background jobs of "
+        << BACKGROUND_TOKENS << " tokens\n\n";
+
+    std::cout << std::left << std::setw(16) << "Mode"
+        << std::right << std::setw(20) << "Interactive TTFT" << std::setw(20) << "Background drain"
+        << std::setw(12) << "FIFO" << "\n";
+
+    for (bool useScheduler : { false, true })
+    {
+        Result result = runScenario(useScheduler);
+        std::cout << std::left << std::setw(16) << (useScheduler ? "scheduler" : "direct")
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(17) << result.interactiveTtftMs << " ms"
+            << std::setw(17) << result.backgroundDrainMs << " ms"
+            << std::setw(12) << (result.backgroundInOrder ? "yes" : "no") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,383 @@
+// Renders the real playground (chat history sidebar, preset sidebar and chat window) without
+// a window or GPU and reports the cost of a frame for large synthetic states: many chats, a
+// long conversation, a reply streaming into it, and the performance overlay. Exits non-zero
+// when a phase goes over its PhaseLimits, so it can guard against regressions.
+//
+// ImGui runs with no platform or renderer backend; the font atlas is built but never
+// uploaded, so frames stop at ImGui::Render() and the draw data is only measured.
+
+#include "config.hpp"
+#include "ui/fonts.hpp"
+#include "ui/playground.hpp"
+#include "ui/performance_overlay.hpp"
+#include "chat/chat_manager.hpp"
+#include "profiling/memory_tracker.hpp"
+
+#include <imgui.h>
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <future>
+#include <functional>
+#include <numeric>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+    std::atomic<uint64_t> g_allocations{ 0 };
+}
+
+// Every heap allocation of the process is counted, including those of worker threads
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+// Every form of delete frees through the one function that pairs with operator new above.
+// GCC inlines it into library code and, not seeing the replaced new, flags the free.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { operator delete(ptr); }
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int CHAT_COUNT = 10000;
+    constexpr int LONG_CHAT_MESSAGES = 5000;
+    constexpr int SHORT_CHAT_MESSAGES = 6;
+    constexpr double STREAM_TOKENS_PER_SECOND = 50.0;
+    constexpr float FRAME_SECONDS = 1.0F / 60.0F;
+    constexpr int WARMUP_FRAMES = 10;
+    constexpr int DEFAULT_FRAMES = 240;
+    constexpr int STREAM_JOB_ID = 1 << 30;  // never handed out by the engine
+    const ImVec2 DISPLAY_SIZE(1600.0F, 900.0F);
+
+    // A phase fails when its mean frame exceeds these. Times leave room for slow machines;
+    // allocations are counted exactly. Streaming is held to the same limits: only the text of
+    // the growing reply is copied into the open chat's snapshot, never the whole chat.
+    struct PhaseLimits
+    {
+        double meanFrameMs;
+        double meanAllocations;
+    };
+    constexpr PhaseLimits FRAME_LIMITS{ 5.0, 64.0 };
+
+    const char* const TOPICS[] = {
+        "Quarterly report", "Rust lifetimes", "Trip to Kyoto", "Sourdough starter", "Resume review",
+        "GPU drivers", "Tax questions", "Unit test ideas", "Poem about rain", "SQL index tuning",
+        "Birthday gift", "Docker networking", "Marathon plan", "Essay outline", "Budget spreadsheet",
+    };
+
+    const char* const USER_LINES[] = {
+        "Can you explain how this works in a bit more detail?",
+        "Rewrite the previous answer as a short bulleted list.",
+        "What would change if the input were ten times larger?",
+        "Give me an example in C++ please.",
+    };
+
+    const char* const ASSISTANT_PARAGRAPHS[] = {
+        "Sure. The short version is that the work is split into independent pieces, each piece is "
+        "handled on its own, and the partial results are merged at the end. Most of the cost is in "
+        "the first step, so that is where it pays to be careful.",
+        "There are a few things to keep in mind:\n\n- **Memory** grows with the input size.\n"
+        "- *Latency* depends on the slowest piece.\n- Merging is cheap compared to the rest.",
+        "Here is a small example:\n\n```cpp\nstd::vector<int> values(1000);\n"
+        "std::iota(values.begin(), values.end(), 0);\nint sum = std::accumulate(values.begin(), values.end(), 0);\n```\n\n"
+        "The same idea carries over to larger inputs.",
+        "If the input were ten times larger the first step would dominate even more. Caching the "
+        "intermediate results and processing them in batches keeps the overhead manageable.",
+    };
+
+    const char* const STREAM_WORDS[] = {
+        "The ", "result ", "depends ", "on ", "how ", "the ", "data ", "is ", "laid ", "out ",
+        "in ", "memory, ", "so ", "we ", "first ", "look ", "at ", "access ", "patterns.\n\n",
+        "- ", "**Reads** ", "are ", "sequential ", "here.\n",
+    };
+
+    Chat::Message makeMessage(const std::string& role, const std::string& content, std::chrono::system_clock::time_point timestamp)
+    {
+        Chat::Message message;
+        message.role = role;
+        message.content = content;
+        message.timestamp = timestamp;
+        return message;
+    }
+
+    Chat::ChatHistory makeChat(int id, int lastModified, const std::string& name, int messageCount)
+    {
+        Chat::ChatHistory chat(id, lastModified, name);
+        const auto start = std::chrono::system_clock::from_time_t(lastModified) - std::chrono::seconds(messageCount * 30);
+        chat.messages.reserve(messageCount);
+        for (int i = 0; i < messageCount; ++i)
+        {
+            const auto timestamp = start + std::chrono::seconds(i * 30);
+            if (i % 2 == 0)
+            {
+                chat.appendMessage(makeMessage("user", USER_LINES[(i / 2) % 4], timestamp));
+            }
+            else
+            {
+                chat.appendMessage(makeMessage("assistant", ASSISTANT_PARAGRAPHS[(i / 2) % 4], timestamp));
+            }
+        }
+        return chat;
+    }
+
+    /**
+     * @brief Hands the chat manager a fixed set of synthetic chats and discards writes.
+     *
+     * The long chat is the most recent one; every other chat is short.
+     */
+    class SyntheticChatPersistence : public Chat::IChatPersistence
+    {
+    public:
+        std::future<bool> saveChat(const Chat::ChatHistory&) override { return ready(true); }
+        std::future<bool> deleteChat(const std::string&) override { return ready(true); }
+
+        std::future<std::vector<Chat::ChatHistory>> loadAllChats() override
+        {
+            std::vector<Chat::ChatHistory> chats;
+            chats.reserve(CHAT_COUNT);
+
+            const int now = static_cast<int>(std::time(nullptr));
+            for (int i = 1; i < CHAT_COUNT; ++i)
+            {
+                std::string name = std::string(TOPICS[i % 15]) + " #" + std::to_string(i);
+                chats.push_back(makeChat(i, now - (CHAT_COUNT - i) * 60, name, SHORT_CHAT_MESSAGES));
+            }
+            chats.push_back(makeChat(CHAT_COUNT, now, "Long conversation", LONG_CHAT_MESSAGES));
+
+            std::promise<std::vector<Chat::ChatHistory>> promise;
+            promise.set_value(std::move(chats));
+            return promise.get_future();
+        }
+
+    private:
+        static std::future<bool> ready(bool value)
+        {
+            std::promise<bool> promise;
+            promise.set_value(value);
+            return promise.get_future();
+        }
+    };
+
+    struct FrameSample
+    {
+        double wallMs;
+        double cpuMs;
+        uint64_t allocations;
+        int vertices;
+        int indices;
+        int drawLists;
+        int drawCommands;
+    };
+
+    FrameSample renderFrame(float& chatHistorySidebarWidth, float& modelPresetSidebarWidth, bool withOverlay)
+    {
+        ImGuiIO& imguiIO = ImGui::GetIO();
+        imguiIO.DisplaySize = DISPLAY_SIZE;
+        imguiIO.DeltaTime = FRAME_SECONDS;
+
+        const uint64_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+        const std::clock_t cpuBefore = std::clock();
+        const auto wallBefore = Clock::now();
+
+        ImGui::NewFrame();
+        renderPlayground(chatHistorySidebarWidth, modelPresetSidebarWidth);
+        if (withOverlay)
+        {
+            renderPerformanceOverlay(true);
+        }
+        ImGui::Render();
+
+        FrameSample sample{};
+        sample.wallMs = std::chrono::duration<double, std::milli>(Clock::now() - wallBefore).count();
+        sample.cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuBefore) / CLOCKS_PER_SEC;
+        sample.allocations = g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        sample.vertices = drawData->TotalVtxCount;
+        sample.indices = drawData->TotalIdxCount;
+        sample.drawLists = drawData->CmdListsCount;
+        for (const ImDrawList* drawList : drawData->CmdLists)
+        {
+            sample.drawCommands += drawList->CmdBuffer.Size;
+        }
+        return sample;
+    }
+
+    double percentile(std::vector<double> values, double fraction)
+    {
+        std::sort(values.begin(), values.end());
+        const size_t index = static_cast<size_t>(fraction * (values.size() - 1) + 0.5);
+        return values[index];
+    }
+
+    // Prints a row of the table; returns false if the phase is over its limits
+    bool report(const char* phase, const std::vector<FrameSample>& samples, const PhaseLimits& limits)
+    {
+        std::vector<double> wall, cpu, allocations, vertices, commands;
+        for (const FrameSample& sample : samples)
+        {
+            wall.push_back(sample.wallMs);
+            cpu.push_back(sample.cpuMs);
+            allocations.push_back(static_cast<double>(sample.allocations));
+            vertices.push_back(sample.vertices);
+            commands.push_back(sample.drawCommands);
+        }
+        auto mean = [](const std::vector<double>& values) {
+            return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+            };
+
+        std::cout << std::left << std::setw(22) << phase << std::right << std::fixed << std::setprecision(2)
+            << std::setw(9) << mean(wall) << std::setw(9) << percentile(wall, 0.5)
+            << std::setw(9) << percentile(wall, 0.95) << std::setw(9) << *std::max_element(wall.begin(), wall.end())
+            << std::setw(9) << mean(cpu)
+            << std::setprecision(0)
+            << std::setw(10) << mean(allocations)
+            << std::setw(10) << mean(vertices)
+            << std::setw(8) << mean(commands)
+            << std::setw(7) << samples.back().drawLists << "\n";
+
+        const bool withinLimits = mean(wall) <= limits.meanFrameMs && mean(allocations) <= limits.meanAllocations;
+        if (!withinLimits)
+        {
+            std::cerr << phase << ": over the limit of " << limits.meanFrameMs << " ms and "
+                << limits.meanAllocations << " allocations per frame\n";
+        }
+        return withinLimits;
+    }
+
+    std::vector<FrameSample> runPhase(int frames, float& leftWidth, float& rightWidth, const std::function<void(int)>& beforeFrame,
+        bool withOverlay = false)
+    {
+        for (int i = 0; i < WARMUP_FRAMES; ++i)
+        {
+            beforeFrame(-1);
+            renderFrame(leftWidth, rightWidth, withOverlay);
+        }
+
+        std::vector<FrameSample> samples;
+        samples.reserve(frames);
+        for (int i = 0; i < frames; ++i)
+        {
+            beforeFrame(i);
+            samples.push_back(renderFrame(leftWidth, rightWidth, withOverlay));
+        }
+        return samples;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_FRAMES;
+
+    // The managers create their folders and files in the working directory
+    const std::filesystem::path workDir = std::filesystem::temp_directory_path() / "kolosal_ui_frame_benchmark";
+    std::filesystem::remove_all(workDir);
+    std::filesystem::create_directories(workDir);
+    std::filesystem::current_path(workDir);
+
+    ImGui::CreateContext();
+    ImGuiIO& imguiIO = ImGui::GetIO();
+    imguiIO.IniFilename = nullptr;
+    imguiIO.DisplaySize = DISPLAY_SIZE;
+
+    // Load the fonts the app uses and build the atlas; it is never uploaded
+    FontsManager::GetInstance();
+    unsigned char* pixels = nullptr;
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    imguiIO.Fonts->GetTexDataAsRGBA32(&pixels, &atlasWidth, &atlasHeight);
+    imguiIO.Fonts->SetTexID(static_cast<ImTextureID>(1));
+
+    const auto loadStart = Clock::now();
+    Chat::initializeChatManagerWithCustomPersistence(std::make_unique<SyntheticChatPersistence>());
+    const double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - loadStart).count();
+
+    auto& chatManager = Chat::ChatManager::getInstance();
+    float chatHistorySidebarWidth = Config::ChatHistorySidebar::SIDEBAR_WIDTH;
+    float modelPresetSidebarWidth = Config::ModelPresetSidebar::SIDEBAR_WIDTH;
+
+    std::cout << "Headless playground at " << DISPLAY_SIZE.x << "x" << DISPLAY_SIZE.y << ", " << frames
+        << " frames per phase; " << CHAT_COUNT << " chats loaded in " << std::fixed << std::setprecision(0)
+        << loadMs << " ms\n\n";
+    std::cout << std::left << std::setw(22) << "Phase" << std::right
+        << std::setw(9) << "mean" << std::setw(9) << "p50" << std::setw(9) << "p95" << std::setw(9) << "max"
+        << std::setw(9) << "cpu" << std::setw(10) << "allocs" << std::setw(10) << "vertices"
+        << std::setw(8) << "cmds" << std::setw(7) << "lists" << "\n";
+    std::cout << std::left << std::setw(22) << "" << std::right << std::setw(36) << "frame ms"
+        << std::setw(9) << "ms" << std::setw(35) << "per frame" << "\n";
+
+    // A short chat open with the full chat list in the sidebar
+    chatManager.switchToChat(std::string(TOPICS[1]) + " #1");
+    bool passed = report("10,000 chats",
+        runPhase(frames, chatHistorySidebarWidth, modelPresetSidebarWidth, [](int) {}), FRAME_LIMITS);
+
+    chatManager.switchToChat("Long conversation");
+    passed &= report("5,000 messages",
+        runPhase(frames, chatHistorySidebarWidth, modelPresetSidebarWidth, [](int) {}), FRAME_LIMITS);
+
+    // A reply growing at a steady token rate in simulated time, as DrainTokenStreams applies it
+    chatManager.setJobId(CHAT_COUNT, STREAM_JOB_ID);
+    double pendingTokens = 0.0;
+    size_t nextWord = 0;
+    chatManager.appendJobOutput(STREAM_JOB_ID, STREAM_WORDS[0]);
+    passed &= report("streaming 50 tok/s", runPhase(frames, chatHistorySidebarWidth, modelPresetSidebarWidth,
+        [&](int) {
+            pendingTokens += STREAM_TOKENS_PER_SECOND * FRAME_SECONDS;
+            std::string delta;
+            for (; pendingTokens >= 1.0; pendingTokens -= 1.0)
+            {
+                delta += STREAM_WORDS[++nextWord % (sizeof(STREAM_WORDS) / sizeof(STREAM_WORDS[0]))];
+            }
+            if (!delta.empty())
+            {
+                chatManager.appendJobOutput(STREAM_JOB_ID, delta);
+            }
+        }), FRAME_LIMITS);
+    chatManager.finishJob(STREAM_JOB_ID);
+
+    // The performance overlay open over the long conversation
+    passed &= report("performance overlay",
+        runPhase(frames, chatHistorySidebarWidth, modelPresetSidebarWidth, [](int) {}, true), FRAME_LIMITS);
+
+    // Every phase above charges the chat history counters; none may end over its budget
+    const auto overBudget = Profiling::MemoryTracker::getInstance().checkBudgets();
+    for (const auto& usage : overBudget)
+    {
+        std::cerr << "Over memory budget: " << Profiling::getMemorySubsystemName(usage.subsystem) << " at "
+            << Profiling::MemoryTracker::toMiB(usage.currentBytes) << " MiB of "
+            << Profiling::MemoryTracker::toMiB(usage.budgetBytes) << " MiB\n";
+    }
+
+    ImGui::DestroyContext();
+    return passed && overBudget.empty() ? 0 : 1;
+}
@@ -0,0 +1,249 @@
+// Counts heap allocations per frame of the widget layer: a list of rows drawn through the
+// config structs (ButtonConfig, LabelConfig) against the same rows drawn through
+// Button::draw and Label::draw. Exits with 1 if the second form allocates after warm-up.
+//
+// ImGui's own allocations go through its allocator functions and are counted separately;
+// they stop once its buffers have grown to the size of a frame.
+
+#include "config.hpp"
+#include "ui/fonts.hpp"
+#include "ui/widgets.hpp"
+
+#include <imgui.h>
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <functional>
+
+namespace
+{
+    std::atomic<uint64_t> g_allocations{ 0 };
+    std::atomic<uint64_t> g_imguiAllocations{ 0 };
+
+    void* imguiAlloc(size_t size, void*)
+    {
+        g_imguiAllocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size);
+    }
+
+    void imguiFree(void* ptr, void*)
+    {
+        std::free(ptr);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+// Every form of delete frees through the one function that pairs with operator new above.
+// GCC inlines it into library code and, not seeing the replaced new, flags the free.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { operator delete(ptr); }
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int ROWS = 200;
+    constexpr int WARMUP_FRAMES = 10;
+    constexpr int FRAMES = 500;
+    constexpr float ROW_WIDTH = 240.0F;
+
+    struct Row
+    {
+        int id;
+        std::string name;
+        std::string tooltip;
+    };
+
+    int g_clicks = 0;
+
+    // A sidebar row: a selectable button with a long label, a delete button and a caption
+    void drawRowsWithConfigs(const std::vector<Row>& rows, int selectedId)
+    {
+        for (const Row& row : rows)
+        {
+            ButtonConfig rowButton;
+            rowButton.id = "##row" + std::to_string(row.id);
+            rowButton.label = row.name;
+            rowButton.icon = ICON_CI_COMMENT;
+            rowButton.size = ImVec2(ROW_WIDTH, 0);
+            rowButton.gap = 10.0F;
+            rowButton.state = row.id == selectedId ? ButtonState::ACTIVE : ButtonState::NORMAL;
+            rowButton.alignment = Alignment::LEFT;
+            rowButton.tooltip = row.tooltip;
+            rowButton.onClick = [id = row.id, name = row.name]() { g_clicks += id + static_cast<int>(name.size()); };
+            Button::render(rowButton);
+
+            ImGui::SameLine();
+
+            ButtonConfig deleteButton;
+            deleteButton.id = "##delete" + std::to_string(row.id);
+            deleteButton.icon = ICON_CI_TRASH;
+            deleteButton.size = ImVec2(24, 0);
+            deleteButton.tooltip = "Delete Chat";
+            deleteButton.onClick = [id = row.id]() { g_clicks -= id; };
+            Button::render(deleteButton);
+
+            LabelConfig caption;
+            caption.id = "##caption" + std::to_string(row.id);
+            caption.label = "Message " + std::to_string(row.id) + " of " + std::to_string(ROWS);
+            caption.fontSize = FontsManager::SM;
+            Label::render(caption);
+        }
+    }
+
+    void drawRowsWithStyles(const std::vector<Row>& rows, int selectedId)
+    {
+        for (const Row& row : rows)
+        {
+            ButtonStyle rowButton;
+            rowButton.icon = ICON_CI_COMMENT;
+            rowButton.gap = 10.0F;
+            rowButton.state = row.id == selectedId ? ButtonState::ACTIVE : ButtonState::NORMAL;
+            rowButton.alignment = Alignment::LEFT;
+            rowButton.tooltip = row.tooltip.c_str();
+            if (Button::draw(makeWidgetId("##row", row.id), row.name, ImVec2(ROW_WIDTH, 0), rowButton))
+            {
+                g_clicks += row.id + static_cast<int>(row.name.size());
+            }
+
+            ImGui::SameLine();
+
+            ButtonStyle deleteButton;
+            deleteButton.icon = ICON_CI_TRASH;
+            deleteButton.tooltip = "Delete Chat";
+            if (Button::draw(makeWidgetId("##delete", row.id), {}, ImVec2(24, 0), deleteButton))
+            {
+                g_clicks -= row.id;
+            }
+
+            char caption[64];
+            const int captionLength = std::snprintf(caption, sizeof(caption), "Message %d of %d", row.id, ROWS);
+            LabelStyle captionStyle;
+            captionStyle.fontSize = FontsManager::SM;
+            Label::draw(std::string_view(caption, captionLength), captionStyle);
+        }
+    }
+
+    struct Result
+    {
+        double frameMs;
+        double allocationsPerFrame;
+        double imguiAllocationsPerFrame;
+    };
+
+    Result run(const std::vector<Row>& rows, const std::function<void(const std::vector<Row>&, int)>& drawRows)
+    {
+        ImGuiIO& imguiIO = ImGui::GetIO();
+
+        auto frame = [&](int index) {
+            imguiIO.DeltaTime = 1.0F / 60.0F;
+            // Move the mouse over the rows so hover states and tooltips are exercised
+            imguiIO.AddMousePosEvent(ROW_WIDTH / 2, static_cast<float>((index * 7) % 600));
+
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0, 0));
+            ImGui::SetNextWindowSize(imguiIO.DisplaySize);
+            ImGui::Begin("Rows", nullptr, ImGuiWindowFlags_NoDecoration);
+            drawRows(rows, index % ROWS);
+            ImGui::End();
+            ImGui::Render();
+        };
+
+        for (int i = 0; i < WARMUP_FRAMES; ++i)
+        {
+            frame(i);
+        }
+
+        const uint64_t allocationsBefore = g_allocations.load();
+        const uint64_t imguiAllocationsBefore = g_imguiAllocations.load();
+        const auto start = Clock::now();
+        for (int i = 0; i < FRAMES; ++i)
+        {
+            frame(i);
+        }
+
+        Result result;
+        result.frameMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / FRAMES;
+        result.allocationsPerFrame = static_cast<double>(g_allocations.load() - allocationsBefore) / FRAMES;
+        result.imguiAllocationsPerFrame = static_cast<double>(g_imguiAllocations.load() - imguiAllocationsBefore) / FRAMES;
+        return result;
+    }
+}
+
+int main()
+{
+    ImGui::SetAllocatorFunctions(imguiAlloc, imguiFree);
+    ImGui::CreateContext();
+    ImGuiIO& imguiIO = ImGui::GetIO();
+    imguiIO.IniFilename = nullptr;
+    imguiIO.DisplaySize = ImVec2(1280.0F, 720.0F);
+
+    FontsManager::GetInstance();
+    unsigned char* pixels = nullptr;
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    imguiIO.Fonts->GetTexDataAsRGBA32(&pixels, &atlasWidth, &atlasHeight);
+    imguiIO.Fonts->SetTexID(static_cast<ImTextureID>(1));
+
+    std::vector<Row> rows;
+    for (int i = 0; i < ROWS; ++i)
+    {
+        rows.push_back({ i + 1, "A chat with a name long enough to be cut short in the sidebar #" + std::to_string(i + 1),
+            "Last modified: Mon Jan  1 00:00:00 2024" });
+    }
+
+    std::cout << ROWS << " rows of two buttons and a label, " << FRAMES << " frames\n\n";
+    std::cout << std::left << std::setw(28) << "API" << std::right
+        << std::setw(12) << "frame ms" << std::setw(16) << "allocs/frame" << std::setw(16) << "ImGui/frame" << "\n";
+
+    const Result configs = run(rows, drawRowsWithConfigs);
+    const Result styles = run(rows, drawRowsWithStyles);
+
+    for (const auto& [name, result] : { std::make_pair("ButtonConfig / LabelConfig", configs),
+        std::make_pair("Button::draw / Label::draw", styles) })
+    {
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(12) << result.frameMs
+            << std::setprecision(1) << std::setw(16) << result.allocationsPerFrame
+            << std::setw(16) << result.imguiAllocationsPerFrame << "\n";
+    }
+
+    ImGui::DestroyContext();
+
+    if (styles.allocationsPerFrame > 0.0)
+    {
+        std::cerr << "\nButton::draw / Label::draw allocated on the heap\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,527 @@
+#pragma once
+
+#include "config.hpp"
+#include "chat_manager.hpp"
+#include "model/model_manager.hpp"
+#include "model/preset_manager.hpp"
+#include "profiling/trace.hpp"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_set>
+#include <condition_variable>
+#include <iostream>
+
+namespace Chat
+{
+    /**
+     * @brief Answers a prompt about a file too large to paste into the chat.
+     *
+     * The file is read in fixed-size blocks and cut into parts that fit the model's context,
+     * preferring paragraph and line breaks. Documents that fit in one part are answered
+     * directly. Longer ones go through map-reduce: each part is sent as its own job as soon as
+     * it has been read, with a bounded number in flight so the engine can overlap them and
+     * memory stays flat however large the file is. The notes taken on every part are merged,
+     * in rounds if they do not fit together, and the final answer streams into the chat like
+     * any other reply. Until then, the reply shows progress and the notes gathered so far.
+     */
+    class AttachmentProcessor
+    {
+    public:
+        static AttachmentProcessor& getInstance()
+        {
+            static AttachmentProcessor instance;
+            return instance;
+        }
+
+        AttachmentProcessor(const AttachmentProcessor&) = delete;
+        AttachmentProcessor& operator=(const AttachmentProcessor&) = delete;
+
+        /**
+         * @brief Queues a file to be answered with the prompt into the chat with the given id.
+         *
+         * The user message is expected to be in the chat already; the reply is appended to it.
+         * Call from the UI thread: the current preset is copied here, as the sidebar edits it
+         * in place while the worker runs.
+         */
+        void process(int chatId, const std::string& path, const std::string& prompt)
+        {
+            auto currentPreset = Model::PresetManager::getInstance().getCurrentPreset();
+            Model::ModelPreset preset = currentPreset.has_value() ? currentPreset->get() : Model::ModelPreset();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back({ chatId, path, prompt, std::move(preset) });
+            m_activeChatIds.insert(chatId);
+
+            if (!m_worker.joinable())
+            {
+                m_worker = std::thread(&AttachmentProcessor::run, this);
+            }
+            m_condition.notify_one();
+        }
+
+        // True from queuing until the final answer has been submitted
+        bool isProcessing(int chatId) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_activeChatIds.count(chatId) > 0;
+        }
+
+        bool isBusy() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return !m_activeChatIds.empty();
+        }
+
+        /**
+         * @brief Stops reading the chat's attachment. Jobs already in the engine run to
+         * completion, as the engine cannot cancel them, but their output is discarded.
+         */
+        void cancel(int chatId)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto queued = std::find_if(m_queue.begin(), m_queue.end(),
+                [chatId](const Request& request) { return request.chatId == chatId; });
+            if (queued != m_queue.end())
+            {
+                m_queue.erase(queued);
+                m_activeChatIds.erase(chatId);
+                return;
+            }
+            if (m_currentChatId == chatId)
+            {
+                m_cancelCurrent = true;
+            }
+        }
+
+    private:
+        struct Request
+        {
+            int chatId;
+            std::string path;
+            std::string prompt;
+            Model::ModelPreset preset;  // as selected when the file was attached
+        };
+
+        // Map or reduce job whose output is collected rather than streamed
+        struct PendingJob
+        {
+            int jobId;
+            size_t slot;
+        };
+
+        struct Progress
+        {
+            std::string fileName;
+            size_t totalParts;          // estimated from the file size until it has been read
+            size_t completedParts = 0;
+            std::string phase = "Reading";
+        };
+
+        class Cancelled {};
+
+        AttachmentProcessor() = default;
+
+        ~AttachmentProcessor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+            if (m_worker.joinable())
+            {
+                m_worker.join();
+            }
+        }
+
+        void run()
+        {
+            KOLOSAL_TRACE_THREAD_NAME("AttachmentProcessor");
+
+            while (true)
+            {
+                Request request;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+                    if (m_stop)
+                    {
+                        return;
+                    }
+                    request = std::move(m_queue.front());
+                    m_queue.pop_front();
+                    m_currentChatId = request.chatId;
+                    m_cancelCurrent = false;
+                }
+
+                std::string error;
+                try
+                {
+                    if (!processRequest(request, error))
+                    {
+                        std::cerr << "[AttachmentProcessor] " << request.path << ": " << error << std::endl;
+                        ChatManager::getInstance().setPendingReply(request.chatId,
+                            "Could not read " + getFileName(request.path) + ": " + error);
+                        ChatManager::getInstance().saveChatById(request.chatId);
+                    }
+                }
+                catch (const Cancelled&)
+                {
+                    ChatManager::getInstance().setPendingReply(request.chatId,
+                        "Stopped reading " + getFileName(request.path) + ".");
+                    ChatManager::getInstance().saveChatById(request.chatId);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "[AttachmentProcessor] " << request.path << ": " << e.what() << std::endl;
+                    ChatManager::getInstance().setPendingReply(request.chatId,
+                        "Could not process " + getFileName(request.path) + ": " + e.what());
+                    ChatManager::getInstance().saveChatById(request.chatId);
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_activeChatIds.erase(request.chatId);
+                m_currentChatId = -1;
+            }
+        }
+
+        bool processRequest(const Request& request, std::string& error)
+        {
+            KOLOSAL_TRACE_SCOPE("AttachmentProcessor::processRequest", "chat");
+
+            std::ifstream file(request.path, std::ios::binary);
+            if (!file.is_open())
+            {
+                error = "cannot open the file";
+                return false;
+            }
+
+            std::error_code ec;
+            const uint64_t fileBytes = std::filesystem::file_size(request.path, ec);
+            const size_t estimatedParts = ec ? 0
+                : static_cast<size_t>(std::max<uint64_t>(1, (fileBytes + CHUNK_CHARS - 1) / CHUNK_CHARS));
+
+            Progress progress{ getFileName(request.path), estimatedParts };
+            std::vector<std::string> notes;
+            std::deque<PendingJob> inFlight;
+            std::vector<char> block(Config::Attachment::READ_BUFFER_BYTES);
+            std::string pending;
+            bool firstBlock = true;
+
+            // Map: send each part as soon as it is read, keeping a bounded window in flight
+            while (file)
+            {
+                file.read(block.data(), block.size());
+                const size_t count = static_cast<size_t>(file.gcount());
+                if (firstBlock && std::find(block.begin(), block.begin() + count, '\0') != block.begin() + count)
+                {
+                    error = "not a text file";
+                    return false;
+                }
+                firstBlock = false;
+                pending.append(block.data(), count);
+
+                while (pending.size() >= CHUNK_CHARS)
+                {
+                    const size_t cut = findChunkEnd(pending);
+                    submitMapJob(request, pending.substr(0, cut), notes, inFlight, progress);
+                    pending.erase(0, cut);
+                }
+            }
+
+            // Short documents are answered directly from their text
+            if (notes.empty() && inFlight.empty())
+            {
+                if (pending.find_first_not_of(" \t\r\n") == std::string::npos)
+                {
+                    error = "the file is empty";
+                    return false;
+                }
+                return submitFinalJob(request, request.prompt + "\n\nContents of " + progress.fileName +
+                    ":\n\n" + pending, error);
+            }
+
+            if (pending.find_first_not_of(" \t\r\n") != std::string::npos)
+            {
+                submitMapJob(request, pending, notes, inFlight, progress);
+            }
+            std::string().swap(pending);
+
+            progress.totalParts = notes.size();
+            while (!inFlight.empty())
+            {
+                collectOldest(request, notes, inFlight, progress);
+            }
+
+            // Reduce: merge neighbouring notes until all of them fit in one prompt
+            while (getTotalLength(notes) > CHUNK_CHARS && notes.size() > 1)
+            {
+                progress.phase = "Merging notes";
+                progress.completedParts = 0;
+                std::vector<std::string> merged;
+                for (size_t begin = 0; begin < notes.size();)
+                {
+                    // Every group takes at least two notes so each round shrinks the list
+                    size_t end = begin + 1;
+                    size_t length = notes[begin].size();
+                    while (end < notes.size() && (end - begin < 2 || length + notes[end].size() <= CHUNK_CHARS))
+                    {
+                        length += notes[end].size();
+                        ++end;
+                    }
+
+                    std::string combined;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        combined += notes[i] + "\n\n";
+                    }
+                    merged.emplace_back();
+                    const size_t slot = merged.size() - 1;
+                    submitCollectedJob(request, buildReduceParameters(request.prompt, combined), slot, merged, inFlight, progress);
+                    begin = end;
+                }
+                progress.totalParts = merged.size();
+                while (!inFlight.empty())
+                {
+                    collectOldest(request, merged, inFlight, progress);
+                }
+                notes.swap(merged);
+            }
+
+            std::string combined;
+            for (size_t i = 0; i < notes.size(); ++i)
+            {
+                combined += "[Notes " + std::to_string(i + 1) + "]\n" + notes[i] + "\n\n";
+            }
+            return submitFinalJob(request, request.prompt + "\n\n" + progress.fileName +
+                " was too long to read at once, so it was read in parts. These are the notes taken on it, in order:\n\n" +
+                combined, error);
+        }
+
+        void submitMapJob(const Request& request, std::string chunk, std::vector<std::string>& notes,
+            std::deque<PendingJob>& inFlight, Progress& progress)
+        {
+            notes.emplace_back();
+            const size_t part = notes.size();
+            progress.totalParts = std::max(progress.totalParts, part);
+
+            ChatCompletionParameters params;
+            params.messages.push_back({ "system",
+                "You read one part of a longer document and take notes for a later step that answers a request about "
+                "the whole document. Keep every fact, name, number and argument relevant to the request. "
+                "Reply with the notes only." });
+            params.messages.push_back({ "user",
+                "Request: " + request.prompt + "\n\nPart " + std::to_string(part) + " of " +
+                progress.fileName + ":\n\n" + chunk });
+            params.maxNewTokens = Config::Attachment::NOTE_MAX_NEW_TOKENS;
+            params.minLength = 1;
+            params.temperature = Config::Attachment::TEMPERATURE;
+            params.streaming = false;
+
+            submitCollectedJob(request, params, part - 1, notes, inFlight, progress);
+        }
+
+        static ChatCompletionParameters buildReduceParameters(const std::string& prompt, const std::string& combined)
+        {
+            ChatCompletionParameters params;
+            params.messages.push_back({ "system",
+                "You merge notes taken on consecutive parts of a document into one shorter set of notes. "
+                "Keep everything relevant to the request and drop repetition. Reply with the notes only." });
+            params.messages.push_back({ "user", "Request: " + prompt + "\n\nNotes:\n\n" + combined });
+            params.maxNewTokens = Config::Attachment::NOTE_MAX_NEW_TOKENS;
+            params.minLength = 1;
+            params.temperature = Config::Attachment::TEMPERATURE;
+            params.streaming = false;
+            return params;
+        }
+
+        void submitCollectedJob(const Request& request, const ChatCompletionParameters& params, size_t slot,
+            std::vector<std::string>& results, std::deque<PendingJob>& inFlight, Progress& progress)
+        {
+            // Backpressure: reading waits here while the window is full
+            while (inFlight.size() >= Config::Attachment::MAX_JOBS_IN_FLIGHT)
+            {
+                collectOldest(request, results, inFlight, progress);
+            }
+            throwIfCancelled();
+
+            const int jobId = Model::ModelManager::getInstance().submitChatCompletionJob(params);
+            if (jobId < 0)
+            {
+                throw std::runtime_error("the model did not accept the job");
+            }
+            inFlight.push_back({ jobId, slot });
+        }
+
+        // The engine runs jobs in submission order, so the oldest one finishes first
+        void collectOldest(const Request& request, std::vector<std::string>& results,
+            std::deque<PendingJob>& inFlight, Progress& progress)
+        {
+            Model::ModelManager& modelManager = Model::ModelManager::getInstance();
+            const PendingJob job = inFlight.front();
+            inFlight.pop_front();
+
+            while (!modelManager.isJobFinished(job.jobId) && !modelManager.hasJobError(job.jobId))
+            {
+                throwIfCancelled();
+                std::this_thread::sleep_for(std::chrono::milliseconds(Config::Attachment::POLL_INTERVAL_MS));
+            }
+            if (modelManager.hasJobError(job.jobId))
+            {
+                throw std::runtime_error(modelManager.getJobError(job.jobId));
+            }
+
+            results[job.slot] = trim(modelManager.getJobResult(job.jobId).text);
+            ++progress.completedParts;
+            reportProgress(request, results, progress);
+        }
+
+        // Shows how far the map or reduce step is, followed by the notes gathered so far
+        void reportProgress(const Request& request, const std::vector<std::string>& results, const Progress& progress)
+        {
+            std::string text = progress.phase + " " + progress.fileName + ": " +
+                std::to_string(progress.completedParts) + " of " + std::to_string(progress.totalParts) +
+                " parts done\n";
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                if (!results[i].empty())
+                {
+                    text += "\n> **Part " + std::to_string(i + 1) + ":** " + excerpt(results[i]) + "\n";
+                }
+            }
+
+            if (!ChatManager::getInstance().setPendingReply(request.chatId, text))
+            {
+                // The chat was deleted while its attachment was being read
+                throw Cancelled();
+            }
+        }
+
+        bool submitFinalJob(const Request& request, const std::string& userContent, std::string& error)
+        {
+            throwIfCancelled();
+
+            const Model::ModelPreset& preset = request.preset;
+            ChatCompletionParameters params;
+            params.messages.push_back({ "system", preset.systemPrompt });
+            params.messages.push_back({ "user", userContent });
+            params.randomSeed   = preset.random_seed;
+            params.maxNewTokens = static_cast<int>(preset.max_new_tokens);
+            params.minLength    = static_cast<int>(preset.min_length);
+            params.temperature  = preset.temperature;
+            params.topP         = preset.top_p;
+            params.streaming    = true;
+
+            // The answer replaces the progress text and streams in like any reply
+            ChatManager& chatManager = ChatManager::getInstance();
+            if (!chatManager.setPendingReply(request.chatId, ""))
+            {
+                throw Cancelled();
+            }
+            const int chatId = request.chatId;
+            const int jobId = Model::ModelManager::getInstance().startChatCompletionJob(params,
+                [&chatManager, chatId](const int submittedJobId) {
+                    chatManager.setJobId(chatId, submittedJobId);
+                },
+                preset.stop_sequences);
+            if (jobId < 0)
+            {
+                error = "the model did not accept the job";
+                return false;
+            }
+            return true;
+        }
+
+        void throwIfCancelled()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop || m_cancelCurrent)
+            {
+                throw Cancelled();
+            }
+        }
+
+        // Cuts at the last paragraph break in the second half of the chunk, else at a line or
+        // word break, else at a UTF-8 character boundary
+        static size_t findChunkEnd(const std::string& text)
+        {
+            const size_t limit = CHUNK_CHARS;
+            const size_t minimum = limit / 2;
+            for (const char* separator : { "\n\n", "\n", " " })
+            {
+                const size_t found = text.rfind(separator, limit - std::char_traits<char>::length(separator));
+                if (found != std::string::npos && found >= minimum)
+                {
+                    return found + std::char_traits<char>::length(separator);
+                }
+            }
+
+            size_t cut = limit;
+            while (cut > minimum && (static_cast<unsigned char>(text[cut]) & 0xC0) == 0x80)
+            {
+                --cut;
+            }
+            return cut;
+        }
+
+        static size_t getTotalLength(const std::vector<std::string>& notes)
+        {
+            size_t length = 0;
+            for (const auto& note : notes)
+            {
+                length += note.size();
+            }
+            return length;
+        }
+
+        static std::string trim(std::string text)
+        {
+            text.erase(0, text.find_first_not_of(" \t\r\n"));
+            text.erase(text.find_last_not_of(" \t\r\n") + 1);
+            return text;
+        }
+
+        static std::string excerpt(const std::string& note)
+        {
+            std::string line = note.substr(0, note.find('\n'));
+            if (line.size() <= Config::Attachment::PROGRESS_EXCERPT_LENGTH)
+            {
+                return line;
+            }
+            size_t cut = Config::Attachment::PROGRESS_EXCERPT_LENGTH;
+            while (cut > 0 && (static_cast<unsigned char>(line[cut]) & 0xC0) == 0x80)
+            {
+                --cut;
+            }
+            return line.substr(0, cut) + "...";
+        }
+
+        static std::string getFileName(const std::string& path)
+        {
+            return std::filesystem::u8path(path).filename().u8string();
+        }
+
+        static constexpr size_t CHUNK_CHARS = Config::Attachment::CHUNK_TOKENS * Config::Attachment::CHARS_PER_TOKEN;
+
+        std::deque<Request> m_queue;
+        std::unordered_set<int> m_activeChatIds;
+        int m_currentChatId = -1;
+        bool m_cancelCurrent = false;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::thread m_worker;
+        bool m_stop = false;
+    };
+
+} // namespace Chat
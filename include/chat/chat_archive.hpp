@@ -0,0 +1,471 @@
+#pragma once
+
+#include "config.hpp"
+#include "chat_history.hpp"
+#include "chat_manager.hpp"
+#include "crypto/crypto.hpp"
+#include "profiling/trace.hpp"
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <optional>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <json.hpp>
+
+namespace Chat
+{
+    enum class ArchiveFormat : uint8_t
+    {
+        Jsonl = 0,   // each record holds one line of JSON
+        Binary = 1   // each record holds the chat as CBOR
+    };
+
+    /**
+     * @brief Exports chats to, and imports them from, a single passphrase-protected archive.
+     *
+     * Chats on disk are encrypted with a key tied to the device, so they cannot be copied to
+     * another machine as they are. An archive instead uses a key derived from a passphrase
+     * with PBKDF2 and a random salt stored in its header.
+     *
+     * Layout: an unencrypted header (magic, version, format, PBKDF2 iterations, salt), then one
+     * record per chat, then an end record holding the chat count so a truncated archive is
+     * detected. A record is a type byte, a little-endian length and an AES-GCM blob. Each chat
+     * is encrypted on its own, so records are encoded and decoded on a bounded number of
+     * parallel tasks while the file is streamed in order; memory use does not grow with the
+     * size of the archive.
+     */
+    class ChatArchiver
+    {
+    public:
+        static ChatArchiver& getInstance()
+        {
+            static ChatArchiver instance;
+            return instance;
+        }
+
+        ChatArchiver(const ChatArchiver&) = delete;
+        ChatArchiver& operator=(const ChatArchiver&) = delete;
+
+        /**
+         * @brief Writes every chat to an archive at the given path.
+         *
+         * The archive is written next to the target and renamed into place once complete.
+         */
+        std::future<bool> exportChats(const std::filesystem::path& path, const std::string& passphrase,
+            const ArchiveFormat format)
+        {
+            if (m_busy.exchange(true))
+            {
+                return std::async(std::launch::deferred, []() { return false; });
+            }
+
+            return std::async(std::launch::async, [this, path, passphrase, format]() {
+                bool exported = exportInternal(path, passphrase, format);
+                m_busy.store(false);
+                return exported;
+                });
+        }
+
+        /**
+         * @brief Adds every chat in the archive to the chat manager, which persists each one.
+         *
+         * Chats whose name already exists are imported under a numbered name.
+         */
+        std::future<bool> importChats(const std::filesystem::path& path, const std::string& passphrase)
+        {
+            if (m_busy.exchange(true))
+            {
+                return std::async(std::launch::deferred, []() { return false; });
+            }
+
+            return std::async(std::launch::async, [this, path, passphrase]() {
+                bool imported = importInternal(path, passphrase);
+                m_busy.store(false);
+                return imported;
+                });
+        }
+
+        bool isBusy() const { return m_busy.load(); }
+        size_t getProcessedCount() const { return m_processedCount.load(); }
+        size_t getTotalCount() const { return m_totalCount.load(); }
+
+        std::string getStatus() const
+        {
+            std::lock_guard<std::mutex> lock(m_statusMutex);
+            return m_status;
+        }
+
+    private:
+        ChatArchiver() = default;
+
+        static constexpr char MAGIC[8] = { 'K', 'O', 'L', 'C', 'H', 'A', 'T', 'S' };
+        static constexpr uint32_t VERSION = 1;
+        static constexpr uint8_t CHAT_RECORD = 'C';
+        static constexpr uint8_t END_RECORD = 'E';
+
+        struct ArchiveHeader
+        {
+            uint32_t version = VERSION;
+            ArchiveFormat format = ArchiveFormat::Jsonl;
+            uint32_t iterations = Crypto::PBKDF2_ITERATIONS;
+            std::array<uint8_t, Crypto::SALT_SIZE> salt{};
+        };
+
+        void setStatus(const std::string& status)
+        {
+            std::lock_guard<std::mutex> lock(m_statusMutex);
+            m_status = status;
+        }
+
+        static size_t getMaxInFlight()
+        {
+            return std::max(1u, std::thread::hardware_concurrency()) * Config::ChatArchive::CHATS_PER_WORKER;
+        }
+
+        static void writeUint32(std::ostream& out, uint32_t value)
+        {
+            uint8_t bytes[4] = {
+                static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24) };
+            out.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+        }
+
+        static bool readUint32(std::istream& in, uint32_t& value)
+        {
+            uint8_t bytes[4];
+            if (!in.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+            {
+                return false;
+            }
+            value = static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+            return true;
+        }
+
+        static void writeHeader(std::ostream& out, const ArchiveHeader& header)
+        {
+            const uint8_t format = static_cast<uint8_t>(header.format);
+            const uint8_t reserved[3] = {};
+            out.write(MAGIC, sizeof(MAGIC));
+            writeUint32(out, header.version);
+            out.write(reinterpret_cast<const char*>(&format), 1);
+            out.write(reinterpret_cast<const char*>(reserved), sizeof(reserved));
+            writeUint32(out, header.iterations);
+            out.write(reinterpret_cast<const char*>(header.salt.data()), header.salt.size());
+        }
+
+        static bool readHeader(std::istream& in, ArchiveHeader& header)
+        {
+            char magic[sizeof(MAGIC)];
+            uint8_t format = 0;
+            uint8_t reserved[3];
+            if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+                !readUint32(in, header.version) ||
+                !in.read(reinterpret_cast<char*>(&format), 1) ||
+                !in.read(reinterpret_cast<char*>(reserved), sizeof(reserved)) ||
+                !readUint32(in, header.iterations) ||
+                !in.read(reinterpret_cast<char*>(header.salt.data()), header.salt.size()))
+            {
+                return false;
+            }
+            header.format = static_cast<ArchiveFormat>(format);
+            return header.version == VERSION &&
+                (header.format == ArchiveFormat::Jsonl || header.format == ArchiveFormat::Binary) &&
+                header.iterations > 0 && header.iterations <= 10 * Crypto::PBKDF2_ITERATIONS;
+        }
+
+        static void writeRecord(std::ostream& out, uint8_t type, const std::vector<uint8_t>& payload)
+        {
+            out.write(reinterpret_cast<const char*>(&type), 1);
+            writeUint32(out, static_cast<uint32_t>(payload.size()));
+            out.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+        }
+
+        static std::vector<uint8_t> encodeChat(const ChatHistory& chat, const ArchiveFormat format,
+            const std::array<uint8_t, Crypto::KEY_SIZE>& key)
+        {
+            nlohmann::json chatJson;
+            to_json(chatJson, chat);
+
+            std::vector<uint8_t> plaintext;
+            if (format == ArchiveFormat::Binary)
+            {
+                plaintext = nlohmann::json::to_cbor(chatJson);
+            }
+            else
+            {
+                std::string line = chatJson.dump();
+                line.push_back('\n');
+                plaintext.assign(line.begin(), line.end());
+            }
+            return Crypto::encrypt(plaintext, key);
+        }
+
+        static ChatHistory decodeChat(const std::vector<uint8_t>& record, const ArchiveFormat format,
+            const std::array<uint8_t, Crypto::KEY_SIZE>& key)
+        {
+            std::vector<uint8_t> plaintext = Crypto::decrypt(record, key);
+            nlohmann::json chatJson = format == ArchiveFormat::Binary
+                ? nlohmann::json::from_cbor(plaintext)
+                : nlohmann::json::parse(plaintext.begin(), plaintext.end());
+
+            ChatHistory chat;
+            from_json(chatJson, chat);
+            return chat;
+        }
+
+        bool exportInternal(const std::filesystem::path& path, const std::string& passphrase,
+            const ArchiveFormat format)
+        {
+            KOLOSAL_TRACE_SCOPE("ChatArchiver::export", "persistence");
+            ChatManager& chatManager = ChatManager::getInstance();
+            const size_t chatCount = chatManager.getChatsSize();
+            m_processedCount.store(0);
+            m_totalCount.store(chatCount);
+            setStatus("Deriving key...");
+
+            ArchiveHeader header;
+            header.format = format;
+            std::array<uint8_t, Crypto::KEY_SIZE> key;
+            try
+            {
+                header.salt = Crypto::generateSalt();
+                key = Crypto::deriveKeyFromPassphrase(passphrase, header.salt, header.iterations);
+            }
+            catch (const std::exception& e)
+            {
+                setStatus(std::string("Export failed: ") + e.what());
+                return false;
+            }
+
+            std::filesystem::path partialPath = path;
+            partialPath += ".part";
+            std::ofstream file(partialPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                setStatus("Export failed: cannot write " + partialPath.string());
+                return false;
+            }
+
+            writeHeader(file, header);
+            setStatus("Exporting...");
+
+            // Records are encoded in parallel but written in order; an empty result marks a
+            // chat that was deleted while exporting
+            std::deque<std::future<std::vector<uint8_t>>> inFlight;
+            const size_t maxInFlight = getMaxInFlight();
+            uint64_t written = 0;
+            bool failed = false;
+
+            auto writeOldest = [&]() {
+                try
+                {
+                    std::vector<uint8_t> record = inFlight.front().get();
+                    if (!record.empty())
+                    {
+                        writeRecord(file, CHAT_RECORD, record);
+                        ++written;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "[ChatArchiver] Failed to encode chat: " << e.what() << std::endl;
+                    failed = true;
+                }
+                inFlight.pop_front();
+                m_processedCount.fetch_add(1);
+            };
+
+            for (size_t i = 0; i < chatCount; ++i)
+            {
+                if (inFlight.size() >= maxInFlight)
+                {
+                    writeOldest();
+                }
+
+                inFlight.push_back(std::async(std::launch::async, [&chatManager, &key, format, i]() {
+                    auto chat = chatManager.getChat(static_cast<int>(i));
+                    return chat.has_value() ? encodeChat(chat.value(), format, key) : std::vector<uint8_t>();
+                    }));
+            }
+            while (!inFlight.empty())
+            {
+                writeOldest();
+            }
+
+            std::vector<uint8_t> count(8);
+            for (size_t b = 0; b < count.size(); ++b)
+            {
+                count[b] = static_cast<uint8_t>(written >> (8 * b));
+            }
+            writeRecord(file, END_RECORD, Crypto::encrypt(count, key));
+            file.close();
+
+            std::error_code ec;
+            if (failed || !file)
+            {
+                std::filesystem::remove(partialPath, ec);
+                setStatus("Export failed while writing " + path.string());
+                return false;
+            }
+
+            std::filesystem::rename(partialPath, path, ec);
+            if (ec)
+            {
+                setStatus("Export failed: " + ec.message());
+                return false;
+            }
+
+            setStatus("Exported " + std::to_string(written) + " chats to " + path.string());
+            std::cout << "[ChatArchiver] Exported " << written << " chats to " << path.string() << std::endl;
+            return true;
+        }
+
+        bool importInternal(const std::filesystem::path& path, const std::string& passphrase)
+        {
+            KOLOSAL_TRACE_SCOPE("ChatArchiver::import", "persistence");
+            m_processedCount.store(0);
+            m_totalCount.store(0);
+
+            std::ifstream file(path, std::ios::binary);
+            ArchiveHeader header;
+            if (!file || !readHeader(file, header))
+            {
+                setStatus("Import failed: " + path.string() + " is not a chat archive");
+                return false;
+            }
+
+            setStatus("Deriving key...");
+            std::array<uint8_t, Crypto::KEY_SIZE> key;
+            try
+            {
+                key = Crypto::deriveKeyFromPassphrase(passphrase, header.salt, header.iterations);
+            }
+            catch (const std::exception& e)
+            {
+                setStatus(std::string("Import failed: ") + e.what());
+                return false;
+            }
+
+            setStatus("Importing...");
+            ChatManager& chatManager = ChatManager::getInstance();
+            std::deque<std::future<bool>> inFlight;
+            const size_t maxInFlight = getMaxInFlight();
+            size_t imported = 0;
+            size_t failures = 0;
+            std::string lastError;
+
+            auto finishOldest = [&]() {
+                try
+                {
+                    if (inFlight.front().get())
+                        ++imported;
+                    else
+                        ++failures;
+                }
+                catch (const std::exception& e)
+                {
+                    lastError = e.what();
+                    ++failures;
+                }
+                inFlight.pop_front();
+                m_processedCount.fetch_add(1);
+            };
+
+            std::optional<uint64_t> expectedCount;
+            while (true)
+            {
+                uint8_t type = 0;
+                uint32_t length = 0;
+                if (!file.read(reinterpret_cast<char*>(&type), 1) || !readUint32(file, length) ||
+                    length > Config::ChatArchive::MAX_RECORD_BYTES)
+                {
+                    break;
+                }
+
+                std::vector<uint8_t> record(length);
+                if (!file.read(reinterpret_cast<char*>(record.data()), length))
+                {
+                    break;
+                }
+
+                if (type == END_RECORD)
+                {
+                    try
+                    {
+                        std::vector<uint8_t> count = Crypto::decrypt(record, key);
+                        uint64_t value = 0;
+                        for (size_t b = 0; b < count.size() && b < 8; ++b)
+                        {
+                            value |= static_cast<uint64_t>(count[b]) << (8 * b);
+                        }
+                        expectedCount = value;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        lastError = e.what();
+                    }
+                    break;
+                }
+                if (type != CHAT_RECORD)
+                {
+                    continue;
+                }
+
+                if (inFlight.size() >= maxInFlight)
+                {
+                    finishOldest();
+                }
+
+                m_totalCount.fetch_add(1);
+                inFlight.push_back(std::async(std::launch::async,
+                    [&chatManager, &key, format = header.format, record = std::move(record)]() {
+                        return chatManager.importChat(decodeChat(record, format, key)).get();
+                    }));
+            }
+            while (!inFlight.empty())
+            {
+                finishOldest();
+            }
+
+            // Every record failing to authenticate almost always means a wrong passphrase
+            if (imported == 0 && (failures > 0 || !expectedCount.has_value()))
+            {
+                setStatus("Import failed: wrong passphrase or corrupted archive");
+                std::cerr << "[ChatArchiver] Import of " << path.string() << " failed: " << lastError << std::endl;
+                return false;
+            }
+
+            std::string status = "Imported " + std::to_string(imported) + " chats";
+            if (failures > 0)
+            {
+                status += ", " + std::to_string(failures) + " failed";
+            }
+            if (!expectedCount.has_value() || expectedCount.value() != imported + failures)
+            {
+                status += " (archive is incomplete)";
+            }
+            setStatus(status);
+            std::cout << "[ChatArchiver] " << status << " from " << path.string() << std::endl;
+            return failures == 0 && expectedCount.has_value();
+        }
+
+        std::atomic<bool> m_busy{ false };
+        std::atomic<size_t> m_processedCount{ 0 };
+        std::atomic<size_t> m_totalCount{ 0 };
+        mutable std::mutex m_statusMutex;
+        std::string m_status;
+    };
+
+} // namespace Chat
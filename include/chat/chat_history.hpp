@@ -7,6 +7,8 @@
 #include <chrono>
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
+#include <unordered_map>
 
 // nlohmann/json library
 #include "json.hpp"
@@ -18,6 +20,7 @@ namespace Chat
     struct Message
     {
         int id;
+        int parentId; // 0 for the first message of a conversation
         bool isLiked;
         bool isDisliked;
         std::string role;
@@ -30,8 +33,10 @@ namespace Chat
             const std::string& content = "",
             bool isLiked = false,
             bool isDisliked = false,
-            const std::chrono::system_clock::time_point& timestamp = std::chrono::system_clock::now())
+            const std::chrono::system_clock::time_point& timestamp = std::chrono::system_clock::now(),
+            int parentId = 0)
             : id(id)
+            , parentId(parentId)
             , isLiked(isLiked)
             , isDisliked(isDisliked)
             , role((role == "user" || role == "assistant") // Check if the role is either user or assistant
@@ -46,6 +51,7 @@ namespace Chat
     {
         j = json{
             {"id", msg.id},
+            {"parentId", msg.parentId},
             {"isLiked", msg.isLiked},
             {"isDisliked", msg.isDisliked},
             {"role", msg.role},
@@ -56,6 +62,7 @@ namespace Chat
     inline void from_json(const json& j, Message& msg)
     {
         msg.id = j.at("id").get<int>();
+        msg.parentId = j.value("parentId", -1); // -1: chat saved before branching, resolved by ChatHistory
         msg.isLiked = j.at("isLiked").get<bool>();
         msg.isDisliked = j.at("isDisliked").get<bool>();
         msg.role = j.at("role").get<std::string>();
@@ -64,22 +71,220 @@ namespace Chat
         msg.timestamp = stringToTimePoint(timestampStr);
     }
 
+    /**
+     * @brief Summary standing in for the start of a conversation's active path in prompts.
+     *
+     * It covers every message up to and including throughMessageId. Only applies while that
+     * message is on the active path; editing or regenerating an earlier message leaves the
+     * summary unused until a new one is written for the new path.
+     */
+    struct ChatMemory
+    {
+        int throughMessageId = 0;   // 0 if nothing has been summarized
+        std::string summary;
+    };
+
+    inline void to_json(json& j, const ChatMemory& memory)
+    {
+        j = json{
+            {"throughMessageId", memory.throughMessageId},
+            {"summary", memory.summary} };
+    }
+
+    inline void from_json(const json& j, ChatMemory& memory)
+    {
+        j.at("throughMessageId").get_to(memory.throughMessageId);
+        j.at("summary").get_to(memory.summary);
+    }
+
+    /**
+     * @brief A conversation stored as a message tree.
+     *
+     * `messages` holds the active path from the root to the current leaf, so code that only
+     * cares about the visible conversation can keep treating it as a flat list. Every node that
+     * is not on the active path (older edits and regenerations) lives in `branches`. Each node
+     * stores its parent id, which is all that is needed to rebuild any path.
+     */
     struct ChatHistory
     {
         int id;
         int lastModified;
         std::string name;
         std::vector<Message> messages;
+        std::vector<Message> branches;
+        ChatMemory memory;
 
         ChatHistory(
             const int id = 0,
             const int lastModified = 0,
             const std::string& name = "untitled",
-            const std::vector<Message>& messages = {})
+            const std::vector<Message>& messages = {},
+            const std::vector<Message>& branches = {})
             : id(id)
             , lastModified(lastModified)
             , name(name)
-            , messages(messages) {
+            , messages(messages)
+            , branches(branches) {
+        }
+
+        // Number of messages at the start of the active path that the memory summarizes
+        size_t summarizedLength() const
+        {
+            if (memory.throughMessageId == 0)
+                return 0;
+            for (size_t i = 0; i < messages.size(); ++i)
+            {
+                if (messages[i].id == memory.throughMessageId)
+                    return i + 1;
+            }
+            return 0;
+        }
+
+        int nextMessageId() const
+        {
+            int maxId = 0;
+            for (const auto& message : messages)
+                maxId = std::max(maxId, message.id);
+            for (const auto& message : branches)
+                maxId = std::max(maxId, message.id);
+            return maxId + 1;
+        }
+
+        // Appends a message to the end of the active path, assigning its id and parent.
+        int appendMessage(Message message)
+        {
+            message.id = nextMessageId();
+            message.parentId = messages.empty() ? 0 : messages.back().id;
+            messages.push_back(std::move(message));
+            return messages.back().id;
+        }
+
+        /**
+         * @brief Starts a new branch that replaces the active path from pathIndex onwards.
+         *
+         * The replaced messages are kept in `branches`; the new message becomes a sibling of
+         * messages[pathIndex]. Returns the id of the new message, or 0 if pathIndex is invalid.
+         */
+        int fork(size_t pathIndex, Message message)
+        {
+            if (pathIndex > messages.size())
+                return 0;
+
+            message.id = nextMessageId();
+            message.parentId = pathIndex == 0 ? 0 : messages[pathIndex - 1].id;
+
+            branches.insert(branches.end(),
+                std::make_move_iterator(messages.begin() + pathIndex),
+                std::make_move_iterator(messages.end()));
+            messages.erase(messages.begin() + pathIndex, messages.end());
+
+            messages.push_back(std::move(message));
+            return messages.back().id;
+        }
+
+        /**
+         * @brief Makes siblingId part of the active path in place of the message at pathIndex.
+         *
+         * Below the sibling the most recent child is followed at every level, which restores the
+         * branch as it was last extended.
+         */
+        bool switchBranch(size_t pathIndex, int siblingId)
+        {
+            if (pathIndex >= messages.size() || messages[pathIndex].id == siblingId)
+                return false;
+
+            // One pass over the stored branches finds the sibling and the newest child of each node
+            const int parentId = messages[pathIndex].parentId;
+            size_t start = branches.size();
+            std::unordered_map<int, size_t> newestChild;
+            for (size_t i = 0; i < branches.size(); ++i)
+            {
+                const Message& m = branches[i];
+                if (m.id == siblingId && m.parentId == parentId)
+                    start = i;
+                auto [child, inserted] = newestChild.try_emplace(m.parentId, i);
+                if (!inserted && m.id > branches[child->second].id)
+                    child->second = i;
+            }
+            if (start == branches.size())
+                return false;
+
+            std::vector<bool> onPath(branches.size(), false);
+            std::vector<Message> path;
+            for (size_t i = start; ; )
+            {
+                onPath[i] = true;
+                path.push_back(std::move(branches[i]));
+                auto child = newestChild.find(path.back().id);
+                if (child == newestChild.end())
+                    break;
+                i = child->second;
+            }
+
+            // Close the gaps left by the new path, then store the replaced path in its place
+            size_t kept = 0;
+            for (size_t i = 0; i < branches.size(); ++i)
+            {
+                if (!onPath[i])
+                {
+                    if (kept != i)
+                        branches[kept] = std::move(branches[i]);
+                    ++kept;
+                }
+            }
+            branches.erase(branches.begin() + kept, branches.end());
+
+            branches.insert(branches.end(),
+                std::make_move_iterator(messages.begin() + pathIndex),
+                std::make_move_iterator(messages.end()));
+            messages.erase(messages.begin() + pathIndex, messages.end());
+            messages.insert(messages.end(), std::make_move_iterator(path.begin()), std::make_move_iterator(path.end()));
+            return true;
+        }
+
+        /**
+         * @brief Drops the reply at the end of the active path if it is still empty.
+         *
+         * For a regenerated reply whose job produced nothing: the newest earlier reply to the
+         * same message, if any, takes its place again. Returns false if there was nothing to drop.
+         */
+        bool discardEmptyReply()
+        {
+            if (messages.empty() || messages.back().role != "assistant" || !messages.back().content.empty())
+                return false;
+
+            const int placeholderId = messages.back().id;
+            const int parentId = messages.back().parentId;
+            int newestSibling = 0;
+            for (const auto& message : branches)
+            {
+                if (message.parentId == parentId && message.id > newestSibling)
+                    newestSibling = message.id;
+            }
+
+            if (newestSibling == 0 || !switchBranch(messages.size() - 1, newestSibling))
+            {
+                messages.pop_back();
+                return true;
+            }
+
+            // The placeholder was moved into branches by the switch
+            branches.erase(std::remove_if(branches.begin(), branches.end(),
+                [placeholderId](const Message& m) { return m.id == placeholderId; }), branches.end());
+            return true;
+        }
+
+        // Maps each parent id to the ids of its children across the whole tree, in creation order.
+        std::unordered_map<int, std::vector<int>> buildChildIndex() const
+        {
+            std::unordered_map<int, std::vector<int>> children;
+            for (const auto& message : messages)
+                children[message.parentId].push_back(message.id);
+            for (const auto& message : branches)
+                children[message.parentId].push_back(message.id);
+            for (auto& [parentId, ids] : children)
+                std::sort(ids.begin(), ids.end());
+            return children;
         }
     };
 
@@ -89,7 +294,9 @@ namespace Chat
             {"id", chatHistory.id},
             {"lastModified", chatHistory.lastModified},
             {"name", chatHistory.name},
-            {"messages", chatHistory.messages} };
+            {"messages", chatHistory.messages},
+            {"branches", chatHistory.branches},
+            {"memory", chatHistory.memory} };
     }
 
     inline void from_json(const json& j, ChatHistory& chatHistory)
@@ -98,6 +305,17 @@ namespace Chat
         j.at("lastModified").get_to(chatHistory.lastModified);
         j.at("name").get_to(chatHistory.name);
         j.at("messages").get_to(chatHistory.messages);
+        chatHistory.branches = j.value("branches", std::vector<Message>{});
+        chatHistory.memory = j.value("memory", ChatMemory{});
+
+        // Chats saved before branching existed are a single linear path
+        for (size_t i = 0; i < chatHistory.messages.size(); ++i)
+        {
+            if (chatHistory.messages[i].parentId < 0)
+            {
+                chatHistory.messages[i].parentId = i == 0 ? 0 : chatHistory.messages[i - 1].id;
+            }
+        }
     }
 
 } // namespace Chat
\ No newline at end of file
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "config.hpp"
+#include "chat_manager.hpp"
+#include "model/model_manager.hpp"
+#include "model/preset_manager.hpp"
+#include "profiling/trace.hpp"
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <future>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+
+namespace Chat
+{
+    /**
+     * @brief Folds the oldest turns of long chats into their ChatMemory in the background.
+     *
+     * Enabled per preset with summarize_history. After a reply completes, a chat whose prompt
+     * would exceed Config::HistorySummary::TRIGGER_TOKENS has its oldest complete exchanges,
+     * together with the previous summary, rewritten into a new summary by a background job.
+     * The latest messages are always left verbatim. Prompts then carry the summary in place
+     * of the turns it covers, see buildChatCompletionParameters.
+     *
+     * Each summary job evicts the chat's evaluated prefix from the engine, and a new summary
+     * changes the system message, so the next turn evaluates its whole prompt again. Folding
+     * therefore continues down to Config::HistorySummary::TARGET_TOKENS, well below the
+     * trigger, so that this happens once every several turns rather than after every reply.
+     */
+    class ChatHistorySummarizer
+    {
+    public:
+        static ChatHistorySummarizer& getInstance()
+        {
+            static ChatHistorySummarizer instance;
+            return instance;
+        }
+
+        ChatHistorySummarizer(const ChatHistorySummarizer&) = delete;
+        ChatHistorySummarizer& operator=(const ChatHistorySummarizer&) = delete;
+
+        // Queues a chat to be checked against the summary threshold
+        void onResponseCompleted(const std::string& chatName)
+        {
+            // Read here, on the UI thread, as the sidebar edits the preset in place
+            m_enabled = isEnabled();
+            if (chatName.empty() || !m_enabled)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (std::find(m_queue.begin(), m_queue.end(), chatName) != m_queue.end())
+            {
+                return;
+            }
+            m_queue.push_back(chatName);
+
+            if (!m_worker.joinable())
+            {
+                m_worker = std::thread(&ChatHistorySummarizer::run, this);
+            }
+            m_condition.notify_one();
+        }
+
+    private:
+        ChatHistorySummarizer() = default;
+
+        ~ChatHistorySummarizer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+            if (m_worker.joinable())
+            {
+                m_worker.join();
+            }
+        }
+
+        static bool isEnabled()
+        {
+            auto preset = Model::PresetManager::getInstance().getCurrentPreset();
+            return preset.has_value() && preset->get().summarize_history;
+        }
+
+        void run()
+        {
+            KOLOSAL_TRACE_THREAD_NAME("ChatHistorySummarizer");
+
+            while (true)
+            {
+                std::string chatName;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+                    if (m_stop)
+                    {
+                        return;
+                    }
+                    chatName = m_queue.front();
+                    m_queue.pop_front();
+                }
+
+                // Each pass folds at least one exchange, so this ends below the target
+                size_t thresholdTokens = Config::HistorySummary::TRIGGER_TOKENS;
+                while (!isStopping() && summarizeOnce(chatName, thresholdTokens))
+                {
+                    thresholdTokens = Config::HistorySummary::TARGET_TOKENS;
+                }
+            }
+        }
+
+        bool isStopping()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stop;
+        }
+
+        static size_t estimateTokens(size_t characters)
+        {
+            return characters / Config::HistorySummary::CHARS_PER_TOKEN;
+        }
+
+        // Returns true if the chat's memory was extended; nothing is done below thresholdTokens
+        bool summarizeOnce(const std::string& chatName, size_t thresholdTokens)
+        {
+            KOLOSAL_TRACE_SCOPE("ChatHistorySummarizer::summarizeOnce", "chat");
+
+            // The chat may have been renamed or deleted while waiting
+            auto chat = ChatManager::getInstance().getChat(chatName);
+            if (!chat.has_value() || !m_enabled)
+            {
+                return false;
+            }
+
+            const std::vector<Message>& messages = chat->messages;
+            const size_t start = chat->summarizedLength();
+            const std::string& previousSummary = start > 0 ? chat->memory.summary : std::string();
+            if (messages.size() <= start + Config::HistorySummary::KEEP_RECENT_MESSAGES)
+            {
+                return false;
+            }
+
+            size_t promptCharacters = previousSummary.size();
+            for (size_t i = start; i < messages.size(); ++i)
+            {
+                promptCharacters += messages[i].content.size();
+            }
+            if (estimateTokens(promptCharacters) < thresholdTokens)
+            {
+                return false;
+            }
+
+            // Oldest turns that fit in one job, ending with a reply so the raw part starts with the user
+            const size_t budget = Config::HistorySummary::MAX_INPUT_TOKENS * Config::HistorySummary::CHARS_PER_TOKEN;
+            const size_t limit = messages.size() - Config::HistorySummary::KEEP_RECENT_MESSAGES;
+            size_t used = 0;
+            size_t end = start;
+            std::string turns;
+            std::string pending;
+            for (size_t i = start; i < limit; ++i)
+            {
+                // A message longer than half the budget is cut short, so one exchange always fits
+                const std::string& content = messages[i].content;
+                const size_t length = std::min(content.size(), budget / 2);
+                if (used + length > budget)
+                {
+                    break;
+                }
+
+                pending += messages[i].role == "user" ? "User: " : "Assistant: ";
+                pending.append(content, 0, length);
+                pending += length < content.size() ? "...\n\n" : "\n\n";
+                used += length;
+
+                if (messages[i].role == "assistant")
+                {
+                    turns += pending;
+                    pending.clear();
+                    end = i + 1;
+                }
+            }
+            if (end == start)
+            {
+                return false;
+            }
+
+            ChatCompletionParameters params;
+            params.messages.push_back({ "system",
+                "You keep the memory of a long conversation. Merge the summary so far with the new "
+                "turns into one updated summary. Keep names, facts, decisions, open questions and "
+                "instructions the user gave. Reply with the summary only." });
+            params.messages.push_back({ "user",
+                "Summary so far:\n" + (previousSummary.empty() ? std::string("(none)") : previousSummary) +
+                "\n\nNew turns:\n" + turns + "Updated summary:" });
+            params.maxNewTokens = Config::HistorySummary::MAX_NEW_TOKENS;
+            params.minLength = 1;
+            params.temperature = Config::HistorySummary::TEMPERATURE;
+            params.streaming = false;
+
+            Model::ModelManager& modelManager = Model::ModelManager::getInstance();
+            std::future<int> admission = modelManager.submitBackgroundChatCompletionJob(params);
+            while (admission.wait_for(std::chrono::milliseconds(Config::HistorySummary::IDLE_POLL_INTERVAL_MS))
+                != std::future_status::ready)
+            {
+                if (isStopping())
+                {
+                    return false;
+                }
+            }
+
+            int jobId = admission.get();
+            if (jobId < 0)
+            {
+                return false;
+            }
+
+            modelManager.waitForJob(jobId);
+            if (modelManager.hasJobError(jobId))
+            {
+                std::cerr << "[ChatHistorySummarizer] Failed to summarize chat " << chatName << ": "
+                    << modelManager.getJobError(jobId) << std::endl;
+                return false;
+            }
+
+            std::string summary = modelManager.getJobResult(jobId).text;
+            summary.erase(0, summary.find_first_not_of(" \t\r\n"));
+            summary.erase(summary.find_last_not_of(" \t\r\n") + 1);
+            if (summary.empty())
+            {
+                return false;
+            }
+
+            ChatMemory memory;
+            memory.throughMessageId = messages[end - 1].id;
+            memory.summary = std::move(summary);
+            if (!ChatManager::getInstance().setChatMemory(chat->id, memory))
+            {
+                return false;
+            }
+
+            std::cout << "[ChatHistorySummarizer] Summarized " << end << " messages of " << chatName << std::endl;
+            return true;
+        }
+
+        std::deque<std::string> m_queue;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::thread m_worker;
+        bool m_stop = false;
+        std::atomic<bool> m_enabled{ false };   // preset setting as of the last completed reply
+    };
+
+} // namespace Chat
@@ -3,6 +3,9 @@
 #pragma once
 
 #include "chat_persistence.hpp"
+#include "container_chat_persistence.hpp"
+#include "profiling/trace.hpp"
+#include "profiling/memory_tracker.hpp"
 
 #include <vector>
 #include <string>
@@ -11,10 +14,43 @@
 #include <optional>
 #include <memory>
 #include <set>
+#include <atomic>
+#include <unordered_map>
 #include <unordered_set>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <condition_variable>
 
 namespace Chat
 {
+    struct ChatSummary
+    {
+        int id;
+        std::string name;
+        int lastModified;
+    };
+
+    /**
+     * @brief Where a chat stands, so a copy of it can be refreshed only as far as it changed.
+     *
+     * Revisions are values of the manager's content version, so they never repeat, not even
+     * for a chat reloaded under the same id.
+     */
+    struct ChatRevision
+    {
+        int chatId = -1;        // -1 while no chat is open
+        uint64_t content = 0;   // moves with every change except streamed reply text
+        uint64_t reply = 0;     // moves as text streams into the trailing reply
+
+        bool operator==(const ChatRevision& other) const
+        {
+            return chatId == other.chatId && content == other.content && reply == other.reply;
+        }
+        bool operator!=(const ChatRevision& other) const { return !(*this == other); }
+    };
+
     /**
      * @brief Singleton ChatManager class with thread-safe operations
      */
@@ -23,7 +59,13 @@ namespace Chat
     public:
         static ChatManager& getInstance() 
         {
+#ifdef KOLOSAL_CHAT_CONTAINER
+            // Existing chats in chats/ are copied into the container the first time it is created
+            static ChatManager instance(std::make_unique<ContainerChatPersistence>(
+                Config::ChatContainer::FILE_PATH, Crypto::generateKey(), "chats"));
+#else
             static ChatManager instance(std::make_unique<FileChatPersistence>("chats", Crypto::generateKey()));
+#endif
             return instance;
         }
 
@@ -50,10 +92,15 @@ namespace Chat
     public:
         void initialize(std::unique_ptr<IChatPersistence> persistence) 
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
-            m_persistence = std::move(persistence);
-            m_currentChatName = std::nullopt;
-            m_currentChatIndex = 0;
+            // The save worker writes through the old backend until it is swapped out
+            flushPendingSaves();
+            {
+                auto lock = lockForWrite();
+                m_persistence = std::move(persistence);
+                m_currentChatName = std::nullopt;
+                m_currentChatIndex = 0;
+            }
+            // Loading takes the lock itself and is waited on here
             loadChatsAsync();
         }
 
@@ -63,9 +110,19 @@ namespace Chat
             return m_currentChatName;
         }
 
+        std::optional<int> getCurrentChatId() const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            if (!m_currentChatName || m_currentChatIndex >= m_chats.size())
+            {
+                return std::nullopt;
+            }
+            return m_chats[m_currentChatIndex].id;
+        }
+
         bool switchToChat(const std::string& name)
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            auto lock = lockForWrite();
             auto it = m_chatNameToIndex.find(name);
             if (it == m_chatNameToIndex.end()) 
             {
@@ -81,15 +138,34 @@ namespace Chat
 
         std::future<bool> renameCurrentChat(const std::string& newName)
         {
-            return std::async(std::launch::async, [this, newName]() {
+            std::string currentName;
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                if (!m_currentChatName)
+                {
+                    return std::async(std::launch::deferred, []() { return false; });
+                }
+                currentName = m_currentChatName.value();
+            }
+            return renameChat(currentName, newName);
+        }
+
+        /**
+         * @brief Renames any chat, e.g. one titled in the background while another is open.
+         */
+        std::future<bool> renameChat(const std::string& oldName, const std::string& newName)
+        {
+            return std::async(std::launch::async, [this, oldName, newName]() {
+                KOLOSAL_TRACE_SCOPE("ChatManager::renameChat", "chat");
                 if (!validateChatName(newName)) 
                 {
                     return false;
                 }
 
-                std::unique_lock<std::shared_mutex> lock(m_mutex);
+                auto lock = lockForWrite();
 
-                if (!m_currentChatName) 
+                auto it = m_chatNameToIndex.find(oldName);
+                if (it == m_chatNameToIndex.end())
                 {
                     return false;
                 }
@@ -99,23 +175,34 @@ namespace Chat
                     return false;
                 }
 
-                size_t currentIdx = m_currentChatIndex;
-                if (currentIdx >= m_chats.size()) 
+                size_t chatIdx = it->second;
+                if (chatIdx >= m_chats.size()) 
                 {
                     return false;
                 }
 
-                std::string oldName = m_chats[currentIdx].name;
-                m_chats[currentIdx].name = newName;
-                m_chats[currentIdx].lastModified = static_cast<int>(std::time(nullptr));
+                // The sorted index is keyed by name too, so drop the entry before renaming
+                m_sortedIndices.erase({ m_chats[chatIdx].lastModified, chatIdx, oldName });
+
+                int64_t bytesBefore = estimateChatBytes(m_chats[chatIdx]);
+                m_chats[chatIdx].name = newName;
+                chargeChatBytes(bytesBefore, m_chats[chatIdx]);
+                markChatChanged(m_chats[chatIdx]);
+                m_chats[chatIdx].lastModified = static_cast<int>(std::time(nullptr));
+                m_sortedIndices.insert({ m_chats[chatIdx].lastModified, chatIdx, newName });
+                ++m_listVersion;
                 
                 // Update indices
                 m_chatNameToIndex.erase(oldName);
-                m_chatNameToIndex[newName] = currentIdx;
-                m_currentChatName = newName;
+                m_chatNameToIndex[newName] = chatIdx;
+                if (m_currentChatName && m_currentChatName.value() == oldName)
+                {
+                    m_currentChatName = newName;
+                }
 
-                // Save changes
-                auto chat = m_chats[currentIdx];
+                // Save changes; a queued copy would recreate the file under the old name
+                discardPendingSave(m_chats[chatIdx].id);
+                auto chat = m_chats[chatIdx];
                 auto saveResult = m_persistence->saveChat(chat).get();
                 if (saveResult) 
                 {
@@ -129,15 +216,20 @@ namespace Chat
 		std::future<bool> clearCurrentChat()
 		{
 			return std::async(std::launch::async, [this]() {
-				std::unique_lock<std::shared_mutex> lock(m_mutex);
+				KOLOSAL_TRACE_SCOPE("ChatManager::clearCurrentChat", "chat");
+				auto lock = lockForWrite();
 				if (!m_currentChatName || m_currentChatIndex >= m_chats.size())
 				{
 					return false;
 				}
+				int64_t bytesBefore = estimateChatBytes(m_chats[m_currentChatIndex]);
 				m_chats[m_currentChatIndex].messages.clear();
-				m_chats[m_currentChatIndex].lastModified = static_cast<int>(std::time(nullptr));
-				// Launch async save operation
+				m_chats[m_currentChatIndex].branches.clear();
+				chargeChatBytes(bytesBefore, m_chats[m_currentChatIndex]);
+				updateChatTimestamp(m_currentChatIndex, static_cast<int>(std::time(nullptr)));
+				markChatChanged(m_chats[m_currentChatIndex]);
 				auto chat = m_chats[m_currentChatIndex];
+				discardPendingSave(chat.id);
 				return m_persistence->saveChat(chat).get();
 				});
 		}
@@ -154,7 +246,8 @@ namespace Chat
 
         void addMessageToCurrentChat(const Message& message)
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            KOLOSAL_TRACE_SCOPE("ChatManager::addMessageToCurrentChat", "chat");
+            auto lock = lockForWrite();
             if (!m_currentChatName || m_currentChatIndex >= m_chats.size()) 
             {
 				std::cerr << "[ChatManager] No current chat selected.\n";
@@ -164,56 +257,121 @@ namespace Chat
             const int newTimestamp = static_cast<int>(std::time(nullptr));
             updateChatTimestamp(m_currentChatIndex, newTimestamp);
 
-            m_chats[m_currentChatIndex].messages.push_back(message);
+            int64_t bytesBefore = estimateChatBytes(m_chats[m_currentChatIndex]);
+            m_chats[m_currentChatIndex].appendMessage(message);
+            chargeChatBytes(bytesBefore, m_chats[m_currentChatIndex]);
+            markChatChanged(m_chats[m_currentChatIndex]);
 
-            // Launch async save operation
-            auto chat = m_chats[m_currentChatIndex];
-            std::async(std::launch::async, [this, chat]() {
-                m_persistence->saveChat(chat);
-            });
+            // Copied under the lock, written by the save worker
+            ChatHistory chat = m_chats[m_currentChatIndex];
+            queueSave(std::move(chat));
+        }
+
+        /**
+         * @brief Replaces the current chat's active path from pathIndex with a new branch.
+         *
+         * The previous path stays in the chat's message tree and can be switched back to.
+         *
+         * @return The id of the new message, or 0 on failure.
+         */
+        int forkCurrentChat(size_t pathIndex, const Message& message)
+        {
+            KOLOSAL_TRACE_SCOPE("ChatManager::forkCurrentChat", "chat");
+            auto lock = lockForWrite();
+            if (!m_currentChatName || m_currentChatIndex >= m_chats.size())
+            {
+                std::cerr << "[ChatManager] No current chat selected.\n";
+                return 0;
+            }
+
+            int64_t bytesBefore = estimateChatBytes(m_chats[m_currentChatIndex]);
+            int messageId = m_chats[m_currentChatIndex].fork(pathIndex, message);
+            chargeChatBytes(bytesBefore, m_chats[m_currentChatIndex]);
+            if (messageId == 0)
+            {
+                return 0;
+            }
+
+            updateChatTimestamp(m_currentChatIndex, static_cast<int>(std::time(nullptr)));
+            markChatChanged(m_chats[m_currentChatIndex]);
+
+            ChatHistory chat = m_chats[m_currentChatIndex];
+            queueSave(std::move(chat));
+            return messageId;
+        }
+
+        /**
+         * @brief Makes a sibling of the message at pathIndex part of the current chat's active path.
+         */
+        bool switchCurrentChatBranch(size_t pathIndex, int siblingId)
+        {
+            KOLOSAL_TRACE_SCOPE("ChatManager::switchCurrentChatBranch", "chat");
+            auto lock = lockForWrite();
+            if (!m_currentChatName || m_currentChatIndex >= m_chats.size())
+            {
+                std::cerr << "[ChatManager] No current chat selected.\n";
+                return false;
+            }
+
+            int64_t bytesBefore = estimateChatBytes(m_chats[m_currentChatIndex]);
+            bool switched = m_chats[m_currentChatIndex].switchBranch(pathIndex, siblingId);
+            chargeChatBytes(bytesBefore, m_chats[m_currentChatIndex]);
+            if (!switched)
+            {
+                return false;
+            }
+            markChatChanged(m_chats[m_currentChatIndex]);
+
+            // Switching branches is a view change, so the chat keeps its position in the list
+            ChatHistory chat = m_chats[m_currentChatIndex];
+            queueSave(std::move(chat));
+            return true;
         }
 
 		void updateCurrentChat(const ChatHistory& chat)
 		{
-			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			KOLOSAL_TRACE_SCOPE("ChatManager::updateCurrentChat", "chat");
+			auto lock = lockForWrite();
 			if (!m_currentChatName || m_currentChatIndex >= m_chats.size())
 			{
 				std::cerr << "[ChatManager] No current chat selected.\n";
 				return;
 			}
+			int64_t bytesBefore = estimateChatBytes(m_chats[m_currentChatIndex]);
 			m_chats[m_currentChatIndex] = chat;
-			// Launch async save operation
-			std::async(std::launch::async, [this, chat]() {
-				m_persistence->saveChat(chat);
-				});
+			chargeChatBytes(bytesBefore, m_chats[m_currentChatIndex]);
+			markChatChanged(m_chats[m_currentChatIndex]);
+			queueSave(chat);
 		}
 
 		void updateChat(const std::string& chatName, const ChatHistory& chat)
 		{
-			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			KOLOSAL_TRACE_SCOPE("ChatManager::updateChat", "chat");
+			auto lock = lockForWrite();
 			auto it = m_chatNameToIndex.find(chatName);
 			if (it == m_chatNameToIndex.end())
 			{
 				std::cerr << "[ChatManager] Chat not found: " << chatName << std::endl;
 				return;
 			}
+			int64_t bytesBefore = estimateChatBytes(m_chats[it->second]);
 			m_chats[it->second] = chat;
-			// Launch async save operation
-			std::async(std::launch::async, [this, chat]() {
-				m_persistence->saveChat(chat);
-				});
+			chargeChatBytes(bytesBefore, m_chats[it->second]);
+			markChatChanged(m_chats[it->second]);
+			queueSave(chat);
 		}
 
         // Async operations
         std::future<bool> createNewChat(const std::string& name) 
         {
             return std::async(std::launch::async, [this, name]() {
+                KOLOSAL_TRACE_SCOPE("ChatManager::createNewChat", "chat");
                 if (!validateChatName(name)) 
                 {
                     return false;
                 }
 
-                std::unique_lock<std::shared_mutex> lock(m_mutex);
+                auto lock = lockForWrite();
                 if (m_chatNameToIndex.find(name) != m_chatNameToIndex.end()) 
                 {
                     return false;
@@ -221,7 +379,7 @@ namespace Chat
 
                 const int newTimestamp = static_cast<int>(std::time(nullptr));
                 ChatHistory newChat{
-                    static_cast<int>(m_chats.size() + 1),
+                    m_nextChatId++,
                     newTimestamp,
                     name,
                     {}
@@ -229,19 +387,59 @@ namespace Chat
 
                 size_t newIndex = m_chats.size();
                 m_chats.push_back(newChat);
+                chargeChatBytes(0, m_chats.back());
+                markChatChanged(m_chats.back());
                 m_chatNameToIndex[name] = newIndex;
+                m_chatIdToIndex[newChat.id] = newIndex;
 
                 // Add to sorted indices
                 m_sortedIndices.insert({newTimestamp, newIndex, name});
+                ++m_listVersion;
 
                 return m_persistence->saveChat(newChat).get();
             });
         }
 
+        /**
+         * @brief Adds a chat exported from another installation and writes it straight to
+         * persistence.
+         *
+         * The chat gets a fresh id, and a numbered name when one with the same name exists.
+         */
+        std::future<bool> importChat(ChatHistory chat)
+        {
+            if (!validateChatName(chat.name))
+            {
+                return std::async(std::launch::deferred, []() { return false; });
+            }
+
+            {
+                auto lock = lockForWrite();
+                const std::string baseName = chat.name;
+                for (int suffix = 2; m_chatNameToIndex.find(chat.name) != m_chatNameToIndex.end(); ++suffix)
+                {
+                    chat.name = baseName + " (" + std::to_string(suffix) + ")";
+                }
+                chat.id = m_nextChatId++;
+
+                size_t newIndex = m_chats.size();
+                m_chats.push_back(chat);
+                chargeChatBytes(0, m_chats.back());
+                markChatChanged(m_chats.back());
+                m_chatNameToIndex[chat.name] = newIndex;
+                m_chatIdToIndex[chat.id] = newIndex;
+                m_sortedIndices.insert({ chat.lastModified, newIndex, chat.name });
+                ++m_listVersion;
+            }
+
+            return m_persistence->saveChat(chat);
+        }
+
         std::future<bool> deleteChat(const std::string& name) 
         {
             return std::async(std::launch::async, [this, name]() {
-                std::unique_lock<std::shared_mutex> lock(m_mutex);
+                KOLOSAL_TRACE_SCOPE("ChatManager::deleteChat", "chat");
+                auto lock = lockForWrite();
                 
                 auto it = m_chatNameToIndex.find(name);
                 if (it == m_chatNameToIndex.end()) 
@@ -251,10 +449,24 @@ namespace Chat
 
                 size_t indexToRemove = it->second;
                 
+                // Streams still running for this chat are dropped when they next report
+                const int chatId = m_chats[indexToRemove].id;
+                auto job = m_chatIdToJobId.find(chatId);
+                if (job != m_chatIdToJobId.end())
+                {
+                    m_jobIdToChatId.erase(job->second);
+                    m_chatIdToJobId.erase(job);
+                }
+                m_chatIdToIndex.erase(chatId);
+                m_chatRevisions.erase(chatId);
+                discardPendingSave(chatId);
+
                 // Remove from sorted indices
                 auto timestamp = m_chats[indexToRemove].lastModified;
                 m_sortedIndices.erase({timestamp, indexToRemove, name});
 
+                Profiling::MemoryTracker::getInstance().release(Profiling::MemorySubsystem::ChatHistory,
+                    estimateChatBytes(m_chats[indexToRemove]));
                 m_chats.erase(m_chats.begin() + indexToRemove);
                 m_chatNameToIndex.erase(it);
 
@@ -277,24 +489,36 @@ namespace Chat
 
         void addMessage(const std::string& chatName, const Message& message) 
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            KOLOSAL_TRACE_SCOPE("ChatManager::addMessage", "chat");
+            auto lock = lockForWrite();
             auto it = std::find_if(m_chats.begin(), m_chats.end(),
                 [&chatName](const auto& chat) { return chat.name == chatName; });
 
             if (it != m_chats.end()) 
             {
-                it->messages.push_back(message);
-                it->lastModified = static_cast<int>(std::time(nullptr));
-
-                // Launch async save operation without blocking
-                auto chat = *it;
-                std::async(std::launch::async, [this, chat]() {
-                    m_persistence->saveChat(chat);
-                    });
+                int64_t bytesBefore = estimateChatBytes(*it);
+                it->appendMessage(message);
+                chargeChatBytes(bytesBefore, *it);
+                markChatChanged(*it);
+                updateChatTimestamp(static_cast<size_t>(it - m_chats.begin()), static_cast<int>(std::time(nullptr)));
+
+                ChatHistory chat = *it;
+                queueSave(std::move(chat));
             }
         }
 
         // Thread-safe getters
+        size_t getPendingWriteCount() const
+        {
+            size_t queued = 0;
+            {
+                std::lock_guard<std::mutex> saveLock(m_saveMutex);
+                queued = m_pendingSaves.size() + (m_savingChatId.has_value() ? 1 : 0);
+            }
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            return queued + m_persistence->getPendingWriteCount();
+        }
+
         std::vector<ChatHistory> getChats() const
         {
             std::shared_lock<std::shared_mutex> lock(m_mutex);
@@ -314,6 +538,80 @@ namespace Chat
             return sortedChats;
         }
 
+        /**
+         * @brief Changes whenever a chat is added, removed, renamed or reordered, so views of
+         * the chat list can cache getChatSummaries() until it moves.
+         */
+        uint64_t getListVersion() const
+        {
+            return m_listVersion.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Changes whenever any chat or the current selection may have changed, so a copy
+         * taken with getCurrentChat() after reading it stays valid until it moves.
+         */
+        uint64_t getContentVersion() const
+        {
+            return m_contentVersion.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Revision of the open chat. Unlike getContentVersion() it stays put while other
+         * chats change, and tells a streamed reply apart from every other change.
+         */
+        ChatRevision getCurrentChatRevision() const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            if (!m_currentChatName || m_currentChatIndex >= m_chats.size())
+            {
+                return {};
+            }
+            auto revision = m_chatRevisions.find(m_chats[m_currentChatIndex].id);
+            return revision != m_chatRevisions.end() ? revision->second : ChatRevision{ m_chats[m_currentChatIndex].id };
+        }
+
+        /**
+         * @brief Copies the text of a chat's trailing reply into reply, reusing its buffer.
+         *
+         * @return false if the chat is gone or its last message is no longer reply, in which
+         * case the caller needs a full copy.
+         */
+        bool copyTrailingReply(int chatId, Message& reply) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            auto index = m_chatIdToIndex.find(chatId);
+            if (index == m_chatIdToIndex.end())
+            {
+                return false;
+            }
+            const ChatHistory& chat = m_chats[index->second];
+            if (chat.messages.empty() || chat.messages.back().id != reply.id)
+            {
+                return false;
+            }
+            reply.content = chat.messages.back().content;
+            return true;
+        }
+
+        // Names and timestamps of all chats, most recent first, without their messages
+        std::vector<ChatSummary> getChatSummaries() const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            std::vector<ChatSummary> summaries;
+            summaries.reserve(m_chats.size());
+            std::vector<bool> seen(m_chats.size(), false);
+            for (const auto& idx : m_sortedIndices)
+            {
+                if (idx.index < seen.size() && !seen[idx.index])
+                {
+                    seen[idx.index] = true;
+                    summaries.push_back({ m_chats[idx.index].id, m_chats[idx.index].name, idx.lastModified });
+                }
+            }
+            return summaries;
+        }
+
         std::optional<ChatHistory> getChat(const std::string& name) const 
         {
             std::shared_lock<std::shared_mutex> lock(m_mutex);
@@ -322,6 +620,13 @@ namespace Chat
             return it != m_chats.end() ? std::optional<ChatHistory>(*it) : std::nullopt;
         }
 
+		std::optional<ChatHistory> getChatById(int chatId) const
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto index = m_chatIdToIndex.find(chatId);
+			return index != m_chatIdToIndex.end() ? std::optional<ChatHistory>(m_chats[index->second]) : std::nullopt;
+		}
+
 		std::optional<ChatHistory> getChat(int index) const
 		{
 			std::shared_lock<std::shared_mutex> lock(m_mutex);
@@ -372,22 +677,37 @@ namespace Chat
             return std::nullopt;
         }
 
+		// Routes the output of a job to the current chat until the job finishes
 		bool setCurrentJobId(int jobId)
 		{
-			std::unique_lock<std::shared_mutex> lock(m_mutex);
-			// set the current chat index to the job id
-			m_chatInferenceJobIdMap[m_currentChatIndex] = jobId;
-			return true;
+			auto lock = lockForWrite();
+			if (!m_currentChatName || m_currentChatIndex >= m_chats.size())
+			{
+				return false;
+			}
+			return setJobIdLocked(m_chats[m_currentChatIndex].id, jobId);
 		}
 
-		int getCurrentJobId()
+		// Routes the output of a job to the chat with the given id until the job finishes
+		bool setJobId(int chatId, int jobId)
+		{
+			auto lock = lockForWrite();
+			return setJobIdLocked(chatId, jobId);
+		}
+
+		// Job id generating into the current chat, or -1
+		int getCurrentJobId() const
 		{
 			std::shared_lock<std::shared_mutex> lock(m_mutex);
-			// get the job id for the current chat index
-			return m_chatInferenceJobIdMap[m_currentChatIndex];
+			if (!m_currentChatName || m_currentChatIndex >= m_chats.size())
+			{
+				return -1;
+			}
+			auto it = m_chatIdToJobId.find(m_chats[m_currentChatIndex].id);
+			return it != m_chatIdToJobId.end() ? it->second : -1;
 		}
         
-		int getJobId(const std::string& chatName)
+		int getJobId(const std::string& chatName) const
 		{
 			std::shared_lock<std::shared_mutex> lock(m_mutex);
 			auto it = m_chatNameToIndex.find(chatName);
@@ -395,24 +715,189 @@ namespace Chat
 			{
 				return -1;
 			}
-			return m_chatInferenceJobIdMap[it->second];
+			auto job = m_chatIdToJobId.find(m_chats[it->second].id);
+			return job != m_chatIdToJobId.end() ? job->second : -1;
 		}
 
-		std::string getChatNameByJobId(int jobId)
+		std::string getChatNameByJobId(int jobId) const
 		{
 			std::shared_lock<std::shared_mutex> lock(m_mutex);
-			for (const auto& [chatIndex, chatJobId] : m_chatInferenceJobIdMap)
+			const ChatHistory* chat = findChatByJobIdLocked(jobId);
+			return chat ? chat->name : "";
+		}
+
+		bool isCurrentChatGenerating() const
+		{
+			return getCurrentJobId() >= 0;
+		}
+
+		// Ids of all chats with a reply being generated, for the sidebar indicators
+		std::unordered_set<int> getGeneratingChatIds() const
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			std::unordered_set<int> chatIds;
+			for (const auto& [chatId, jobId] : m_chatIdToJobId)
+			{
+				chatIds.insert(chatId);
+			}
+			return chatIds;
+		}
+
+		/**
+		 * @brief Appends newly streamed text of a job to the reply of the chat it belongs to.
+		 *
+		 * The chat is found through the job id, so replies keep streaming into the right chat
+		 * while the user switches, renames or creates other chats. The chat is saved once the
+		 * job finishes rather than on every delta.
+		 */
+		void appendJobOutput(int jobId, const std::string& delta)
+		{
+			KOLOSAL_TRACE_SCOPE_ARG("ChatManager::appendJobOutput", "chat", jobId);
+			auto lock = lockForWrite();
+			auto job = m_jobIdToChatId.find(jobId);
+			if (job == m_jobIdToChatId.end())
 			{
-				if (chatJobId == jobId)
+				return;
+			}
+			auto index = m_chatIdToIndex.find(job->second);
+			if (index == m_chatIdToIndex.end())
+			{
+				return;
+			}
+
+			writeTrailingReply(m_chats[index->second], delta, true);
+		}
+
+		/**
+		 * @brief Replaces the text of the reply at the end of a chat, adding the reply if needed.
+		 *
+		 * For work that shows progress before any job streams into the chat; a job routed to
+		 * the chat afterwards appends to the same reply.
+		 *
+		 * @return false if the chat no longer exists.
+		 */
+		bool setPendingReply(int chatId, const std::string& content)
+		{
+			auto lock = lockForWrite();
+			auto index = m_chatIdToIndex.find(chatId);
+			if (index == m_chatIdToIndex.end())
+			{
+				return false;
+			}
+
+			writeTrailingReply(m_chats[index->second], content, false);
+			return true;
+		}
+
+		// Saves a chat changed outside of a streamed job, see setPendingReply
+		void saveChatById(int chatId)
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto index = m_chatIdToIndex.find(chatId);
+			if (index != m_chatIdToIndex.end())
+			{
+				ChatHistory chat = m_chats[index->second];
+				queueSave(std::move(chat));
+			}
+		}
+
+		/**
+		 * @brief Replaces a chat's memory and saves the chat.
+		 *
+		 * @return false if the chat no longer exists or the summarized message has left its
+		 * active path in the meantime.
+		 */
+		bool setChatMemory(int chatId, const ChatMemory& memory)
+		{
+			auto lock = lockForWrite();
+			auto index = m_chatIdToIndex.find(chatId);
+			if (index == m_chatIdToIndex.end())
+			{
+				return false;
+			}
+
+			ChatHistory& chat = m_chats[index->second];
+			const ChatMemory previous = chat.memory;
+			chat.memory = memory;
+			if (chat.summarizedLength() == 0)
+			{
+				chat.memory = previous;
+				return false;
+			}
+			Profiling::MemoryTracker::getInstance().add(Profiling::MemorySubsystem::ChatHistory,
+				static_cast<int64_t>(chat.memory.summary.capacity()) - static_cast<int64_t>(previous.summary.capacity()));
+			markChatChanged(chat);
+
+			ChatHistory chatCopy = chat;
+			queueSave(std::move(chatCopy));
+			return true;
+		}
+
+		// Stops routing a job once it has finished or failed and saves the chat it wrote to
+		void finishJob(int jobId)
+		{
+			auto lock = lockForWrite();
+			auto job = m_jobIdToChatId.find(jobId);
+			if (job == m_jobIdToChatId.end())
+			{
+				return;
+			}
+
+			std::optional<ChatHistory> chat;
+			auto index = m_chatIdToIndex.find(job->second);
+			if (index != m_chatIdToIndex.end())
+			{
+				// A regenerated reply that got no output is not kept as an empty message
+				if (discardEmptyReplyLocked(m_chats[index->second]))
 				{
-					return m_chats[chatIndex].name;
+					markChatChanged(m_chats[index->second]);
 				}
+				chat = m_chats[index->second];
+			}
+
+			auto chatJob = m_chatIdToJobId.find(job->second);
+			if (chatJob != m_chatIdToJobId.end() && chatJob->second == jobId)
+			{
+				m_chatIdToJobId.erase(chatJob);
+			}
+			m_jobIdToChatId.erase(job);
+
+			// Queued before the lock is released so a later rename or delete can discard it;
+			// encrypting and writing still happens on the save worker, off the UI thread
+			if (chat)
+			{
+				queueSave(std::move(*chat));
+			}
+		}
+
+		/**
+		 * @brief Drops a chat's empty trailing reply, for a regeneration whose job could not start.
+		 *
+		 * @return false if the chat does not exist or has no empty reply at its end.
+		 */
+		bool discardEmptyReply(int chatId)
+		{
+			auto lock = lockForWrite();
+			auto index = m_chatIdToIndex.find(chatId);
+			if (index == m_chatIdToIndex.end() || !discardEmptyReplyLocked(m_chats[index->second]))
+			{
+				return false;
 			}
-			return "";
+			markChatChanged(m_chats[index->second]);
+
+			ChatHistory chat = m_chats[index->second];
+			queueSave(std::move(chat));
+			return true;
 		}
 
 		static const std::string getDefaultChatName() { return DEFAULT_CHAT_NAME; }
 
+		// Chats still carrying a generated "New Chat N" name have not been named by the user
+		static bool hasDefaultChatName(const std::string& name)
+		{
+			return name.compare(0, DEFAULT_CHAT_NAME.size(), DEFAULT_CHAT_NAME) == 0;
+		}
+
     private:
         explicit ChatManager(std::unique_ptr<IChatPersistence> persistence)
             : m_persistence(std::move(persistence))
@@ -424,6 +909,102 @@ namespace Chat
             loadChatsAsync();
         }
 
+        // Writes out every queued save before the process exits
+        ~ChatManager()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_saveMutex);
+                m_stopSaving = true;
+            }
+            m_saveCondition.notify_all();
+            if (m_saveWorker.joinable())
+            {
+                m_saveWorker.join();
+            }
+        }
+
+        /**
+         * @brief Hands a copy of a chat to the save worker and returns at once.
+         *
+         * Callers copy and queue the chat while still holding m_mutex, so a rename or delete that
+         * runs afterwards always finds the copy and discards it instead of letting it recreate the
+         * old file. Only m_saveMutex is taken here and the worker never takes m_mutex, so neither
+         * the lock nor the UI thread waits for encryption and disk I/O. A copy still waiting in
+         * the queue is replaced by a newer copy of the same chat.
+         */
+        void queueSave(ChatHistory chat)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_saveMutex);
+                auto pending = m_pendingSaves.find(chat.id);
+                if (pending != m_pendingSaves.end())
+                {
+                    pending->second = std::move(chat);
+                }
+                else
+                {
+                    m_saveOrder.push_back(chat.id);
+                    m_pendingSaves.emplace(chat.id, std::move(chat));
+                }
+
+                if (!m_saveWorker.joinable())
+                {
+                    m_saveWorker = std::thread(&ChatManager::runSaveWorker, this);
+                }
+            }
+            m_saveCondition.notify_all();
+        }
+
+        /**
+         * @brief Drops a chat's queued save and waits for one in flight to finish.
+         *
+         * Chats are stored under their name, so a rename or delete must not be followed by a
+         * late write of the old copy.
+         */
+        void discardPendingSave(int chatId)
+        {
+            std::unique_lock<std::mutex> lock(m_saveMutex);
+            if (m_pendingSaves.erase(chatId) > 0)
+            {
+                m_saveOrder.erase(std::remove(m_saveOrder.begin(), m_saveOrder.end(), chatId), m_saveOrder.end());
+            }
+            m_saveCondition.wait(lock, [this, chatId]() { return m_savingChatId != chatId; });
+        }
+
+        void flushPendingSaves()
+        {
+            std::unique_lock<std::mutex> lock(m_saveMutex);
+            m_saveCondition.wait(lock, [this]() { return m_saveOrder.empty() && !m_savingChatId.has_value(); });
+        }
+
+        void runSaveWorker()
+        {
+            KOLOSAL_TRACE_THREAD_NAME("ChatSaveWorker");
+            std::unique_lock<std::mutex> lock(m_saveMutex);
+            while (true)
+            {
+                m_saveCondition.wait(lock, [this]() { return m_stopSaving || !m_saveOrder.empty(); });
+                if (m_saveOrder.empty())
+                {
+                    return; // stopping, and everything has been written
+                }
+
+                const int chatId = m_saveOrder.front();
+                m_saveOrder.pop_front();
+                auto pending = m_pendingSaves.find(chatId);
+                ChatHistory chat = std::move(pending->second);
+                m_pendingSaves.erase(pending);
+                m_savingChatId = chatId;
+
+                lock.unlock();
+                m_persistence->saveChat(chat).get();
+                lock.lock();
+
+                m_savingChatId.reset();
+                m_saveCondition.notify_all();
+            }
+        }
+
         // Validation helpers
         static bool validateChatName(const std::string& name) 
         {
@@ -443,11 +1024,12 @@ namespace Chat
 
             // Add new index
             m_sortedIndices.insert({ newTimestamp, chatIndex, m_chats[chatIndex].name });
+            ++m_listVersion;
         }
 
         void updateIndicesAfterDeletion(size_t deletedIndex)
         {
-            // Update chatNameToIndex
+            // Update chatNameToIndex and chatIdToIndex
             for (auto& [name, index] : m_chatNameToIndex) 
             {
                 if (index > deletedIndex) 
@@ -455,6 +1037,13 @@ namespace Chat
                     index--;
                 }
             }
+            for (auto& [id, index] : m_chatIdToIndex)
+            {
+                if (index > deletedIndex)
+                {
+                    index--;
+                }
+            }
 
             // Update sortedIndices
             std::set<ChatIndex> newSortedIndices;
@@ -470,6 +1059,125 @@ namespace Chat
                 }
             }
             m_sortedIndices = std::move(newSortedIndices);
+            ++m_listVersion;
+        }
+
+        // Every writer goes through here, so getContentVersion() covers all changes
+        std::unique_lock<std::shared_mutex> lockForWrite()
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            m_contentVersion.fetch_add(1, std::memory_order_acq_rel);
+            return lock;
+        }
+
+        // Called under lockForWrite() by every writer that changes a chat
+        void markChatChanged(const ChatHistory& chat)
+        {
+            ChatRevision& revision = m_chatRevisions[chat.id];
+            revision.chatId = chat.id;
+            revision.content = m_contentVersion.load(std::memory_order_acquire);
+        }
+
+        // Approximate heap footprint of a chat's strings and message storage
+        static int64_t estimateChatBytes(const ChatHistory& chat)
+        {
+            int64_t bytes = static_cast<int64_t>(chat.name.capacity() + chat.memory.summary.capacity() +
+                (chat.messages.capacity() + chat.branches.capacity()) * sizeof(Message));
+            for (const auto& message : chat.messages)
+            {
+                bytes += static_cast<int64_t>(message.role.capacity() + message.content.capacity());
+            }
+            for (const auto& message : chat.branches)
+            {
+                bytes += static_cast<int64_t>(message.role.capacity() + message.content.capacity());
+            }
+            return bytes;
+        }
+
+        // The container itself is charged by its allocator; this adds the contents it points to
+        static void chargeChatBytes(int64_t bytesBefore, const ChatHistory& chatAfter)
+        {
+            Profiling::MemoryTracker::getInstance().add(Profiling::MemorySubsystem::ChatHistory,
+                estimateChatBytes(chatAfter) - bytesBefore);
+        }
+
+        /**
+         * @brief Appends to or replaces the reply at the end of a chat, adding it if needed.
+         *
+         * Runs for every streamed delta, so only the reply and the message vector are charged
+         * rather than the whole chat.
+         */
+        void writeTrailingReply(ChatHistory& chat, const std::string& text, bool append)
+        {
+            const bool hasReply = !chat.messages.empty() && chat.messages.back().role == "assistant";
+            int64_t bytesBefore = static_cast<int64_t>(chat.messages.capacity() * sizeof(Message));
+            if (hasReply)
+            {
+                std::string& content = chat.messages.back().content;
+                bytesBefore += static_cast<int64_t>(content.capacity());
+                if (append)
+                    content += text;
+                else
+                    content = text;
+            }
+            else
+            {
+                Message assistantMessage;
+                assistantMessage.role = "assistant";
+                assistantMessage.content = text;
+                chat.appendMessage(std::move(assistantMessage));
+            }
+
+            const Message& reply = chat.messages.back();
+            int64_t bytesAfter = static_cast<int64_t>(chat.messages.capacity() * sizeof(Message) +
+                reply.content.capacity() + (hasReply ? 0 : reply.role.capacity()));
+            Profiling::MemoryTracker::getInstance().add(Profiling::MemorySubsystem::ChatHistory,
+                bytesAfter - bytesBefore);
+
+            // Growing an existing reply leaves the rest of the chat alone, see ChatRevision
+            if (hasReply)
+            {
+                ChatRevision& revision = m_chatRevisions[chat.id];
+                revision.chatId = chat.id;
+                revision.reply = m_contentVersion.load(std::memory_order_acquire);
+            }
+            else
+            {
+                markChatChanged(chat);
+            }
+        }
+
+        static bool discardEmptyReplyLocked(ChatHistory& chat)
+        {
+            int64_t bytesBefore = estimateChatBytes(chat);
+            if (!chat.discardEmptyReply())
+            {
+                return false;
+            }
+            chargeChatBytes(bytesBefore, chat);
+            return true;
+        }
+
+        bool setJobIdLocked(int chatId, int jobId)
+        {
+            if (m_chatIdToIndex.find(chatId) == m_chatIdToIndex.end())
+            {
+                return false;
+            }
+            m_chatIdToJobId[chatId] = jobId;
+            m_jobIdToChatId[jobId] = chatId;
+            return true;
+        }
+
+        const ChatHistory* findChatByJobIdLocked(int jobId) const
+        {
+            auto job = m_jobIdToChatId.find(jobId);
+            if (job == m_jobIdToChatId.end())
+            {
+                return nullptr;
+            }
+            auto index = m_chatIdToIndex.find(job->second);
+            return index != m_chatIdToIndex.end() ? &m_chats[index->second] : nullptr;
         }
 
         bool chatExists(const std::string& name) const 
@@ -481,17 +1189,45 @@ namespace Chat
         void loadChatsAsync() 
         {
             std::async(std::launch::async, [this]() {
+                KOLOSAL_TRACE_SCOPE("ChatManager::loadChats", "chat");
                 auto chats = m_persistence->loadAllChats().get();
 
-                std::unique_lock<std::shared_mutex> lock(m_mutex);
-                m_chats = std::move(chats);
+                auto lock = lockForWrite();
+                for (const auto& chat : m_chats)
+                {
+                    Profiling::MemoryTracker::getInstance().release(Profiling::MemorySubsystem::ChatHistory,
+                        estimateChatBytes(chat));
+                }
+                m_chats.assign(std::make_move_iterator(chats.begin()), std::make_move_iterator(chats.end()));
+                for (const auto& chat : m_chats)
+                {
+                    chargeChatBytes(0, chat);
+                }
                 
+                // Chat ids route streamed output, so they must be unique; older builds derived
+                // them from the chat count, which repeats after deletions
+                m_nextChatId = 1;
+                for (const auto& chat : m_chats)
+                {
+                    m_nextChatId = std::max(m_nextChatId, chat.id + 1);
+                }
+
                 // Initialize indices
                 m_chatNameToIndex.clear();
+                m_chatIdToIndex.clear();
+                m_chatRevisions.clear();
                 m_sortedIndices.clear();
                 
                 for (size_t i = 0; i < m_chats.size(); ++i) 
                 {
+                    if (m_chatIdToIndex.find(m_chats[i].id) != m_chatIdToIndex.end())
+                    {
+                        m_chats[i].id = m_nextChatId++;
+                        auto chat = m_chats[i];
+                        queueSave(std::move(chat));
+                    }
+                    m_chatIdToIndex[m_chats[i].id] = i;
+                    markChatChanged(m_chats[i]);
                     m_chatNameToIndex[m_chats[i].name] = i;
                     m_sortedIndices.insert({
                         m_chats[i].lastModified,
@@ -500,6 +1236,8 @@ namespace Chat
                     });
                 }
 
+                ++m_listVersion;
+
                 // Handle empty state or select most recent chat
                 if (m_chats.empty()) 
                 {
@@ -519,17 +1257,21 @@ namespace Chat
         {
             const int currentTime = static_cast<int>(std::time(nullptr));
             ChatHistory defaultChat{
-                1,
+                m_nextChatId++,
                 currentTime,
                 DEFAULT_CHAT_NAME,
                 {}
             };
 
             m_chats.push_back(defaultChat);
+            chargeChatBytes(0, m_chats.back());
+            markChatChanged(m_chats.back());
             m_chatNameToIndex[DEFAULT_CHAT_NAME] = 0;
+            m_chatIdToIndex[defaultChat.id] = 0;
             m_sortedIndices.insert({ currentTime, 0, DEFAULT_CHAT_NAME });
+            ++m_listVersion;
 
-            m_persistence->saveChat(defaultChat);
+            queueSave(defaultChat);
             m_currentChatName = DEFAULT_CHAT_NAME;
             m_currentChatIndex = 0;
         }
@@ -537,13 +1279,28 @@ namespace Chat
         static inline const std::string DEFAULT_CHAT_NAME = "New Chat";
 
         std::unique_ptr<IChatPersistence> m_persistence;
-        std::vector<ChatHistory> m_chats;
+        Profiling::TrackedVector<ChatHistory, Profiling::MemorySubsystem::ChatHistory> m_chats;
         std::unordered_map<std::string, size_t> m_chatNameToIndex;
         std::set<ChatIndex> m_sortedIndices;
         std::optional<std::string> m_currentChatName;
         size_t m_currentChatIndex;
         mutable std::shared_mutex m_mutex;
-		std::unordered_map<int, int> m_chatInferenceJobIdMap;
+        std::unordered_map<int, size_t> m_chatIdToIndex;
+        std::unordered_map<int, int> m_jobIdToChatId;
+        std::unordered_map<int, int> m_chatIdToJobId;
+        int m_nextChatId = 1;
+        std::atomic<uint64_t> m_listVersion{ 0 };
+        std::atomic<uint64_t> m_contentVersion{ 0 };
+        std::unordered_map<int, ChatRevision> m_chatRevisions;  // by chat id
+
+        // Save worker, see queueSave
+        mutable std::mutex m_saveMutex;
+        std::condition_variable m_saveCondition;
+        std::deque<int> m_saveOrder;
+        std::unordered_map<int, ChatHistory> m_pendingSaves;
+        std::optional<int> m_savingChatId;
+        std::thread m_saveWorker;
+        bool m_stopSaving = false;
     };
 
     inline void initializeChatManager() {
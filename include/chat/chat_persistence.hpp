@@ -2,8 +2,10 @@
 
 #include "chat_history.hpp"
 #include "crypto/crypto.hpp"
+#include "profiling/trace.hpp"
 
 #include <future>
+#include <atomic>
 #include <shared_mutex>
 #include <filesystem>
 #include <fstream>
@@ -21,6 +23,9 @@ namespace Chat
         virtual std::future<bool> saveChat(const ChatHistory& chat) = 0;
         virtual std::future<bool> deleteChat(const std::string& chatName) = 0;
         virtual std::future<std::vector<ChatHistory>> loadAllChats() = 0;
+
+        // Number of writes queued or in flight; cheap enough to poll every frame.
+        virtual size_t getPendingWriteCount() const { return 0; }
     };
 
     /**
@@ -41,15 +46,24 @@ namespace Chat
 
         std::future<bool> saveChat(const ChatHistory& chat) override 
         {
+            m_pendingWrites.fetch_add(1, std::memory_order_relaxed);
             return std::async(std::launch::async, [this, chat]() {
                 std::unique_lock<std::shared_mutex> lock(m_ioMutex);
-                return saveEncryptedChat(chat);
+                bool saved = saveEncryptedChat(chat);
+                m_pendingWrites.fetch_sub(1, std::memory_order_relaxed);
+                return saved;
                 });
         }
 
+        size_t getPendingWriteCount() const override
+        {
+            return m_pendingWrites.load(std::memory_order_relaxed);
+        }
+
         std::future<bool> deleteChat(const std::string& chatName) override 
         {
             return std::async(std::launch::async, [this, chatName]() {
+                KOLOSAL_TRACE_SCOPE("FileChatPersistence::deleteChat", "persistence");
                 std::unique_lock<std::shared_mutex> lock(m_ioMutex);
                 try 
                 {
@@ -75,6 +89,7 @@ namespace Chat
         const std::string m_basePath;
         const std::array<uint8_t, 32> m_key;
         mutable std::shared_mutex m_ioMutex;
+        std::atomic<size_t> m_pendingWrites{ 0 };
 
         auto getChatPath(const std::string& chatName) const -> std::string 
         {
@@ -83,6 +98,7 @@ namespace Chat
 
         bool saveEncryptedChat(const ChatHistory& chat) 
         {
+            KOLOSAL_TRACE_SCOPE("FileChatPersistence::saveChat", "persistence");
             try {
                 // Use the existing to_json serialization
                 nlohmann::json chatJson;
@@ -115,6 +131,7 @@ namespace Chat
 
         std::vector<ChatHistory> loadEncryptedChats() 
         {
+            KOLOSAL_TRACE_SCOPE("FileChatPersistence::loadAllChats", "persistence");
             std::vector<ChatHistory> chats;
 
             try {
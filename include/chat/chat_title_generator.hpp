@@ -0,0 +1,224 @@
+#pragma once
+
+#include "config.hpp"
+#include "chat_manager.hpp"
+#include "model/model_manager.hpp"
+#include "profiling/trace.hpp"
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+
+namespace Chat
+{
+    /**
+     * @brief Names new chats in the background after their first exchange.
+     *
+     * Requests are handled one at a time on a single worker thread and submitted as background
+     * jobs, which the inference scheduler only admits while no interactive generation is in
+     * flight. Each job is a handful of tokens, so it can delay a reply by very little.
+     *
+     * A title job does evict the chat's evaluated prefix from the engine, so the second turn
+     * of a new chat re-evaluates its first exchange. Only chats with a single exchange are
+     * titled, which keeps that cost to one short exchange.
+     */
+    class ChatTitleGenerator
+    {
+    public:
+        static ChatTitleGenerator& getInstance()
+        {
+            static ChatTitleGenerator instance;
+            return instance;
+        }
+
+        ChatTitleGenerator(const ChatTitleGenerator&) = delete;
+        ChatTitleGenerator& operator=(const ChatTitleGenerator&) = delete;
+
+        /**
+         * @brief Queues a chat for titling if it still has a generated name and has just
+         * completed its first exchange.
+         */
+        void onResponseCompleted(const std::string& chatName)
+        {
+            if (chatName.empty() || !ChatManager::hasDefaultChatName(chatName))
+            {
+                return;
+            }
+
+            auto chat = ChatManager::getInstance().getChat(chatName);
+            if (!chat.has_value() || chat->messages.size() != 2 || !chat->branches.empty())
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (std::find(m_queue.begin(), m_queue.end(), chatName) != m_queue.end())
+            {
+                return;
+            }
+            m_queue.push_back(chatName);
+
+            if (!m_worker.joinable())
+            {
+                m_worker = std::thread(&ChatTitleGenerator::run, this);
+            }
+            m_condition.notify_one();
+        }
+
+    private:
+        ChatTitleGenerator() = default;
+
+        ~ChatTitleGenerator()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+            if (m_worker.joinable())
+            {
+                m_worker.join();
+            }
+        }
+
+        void run()
+        {
+            KOLOSAL_TRACE_THREAD_NAME("ChatTitleGenerator");
+
+            while (true)
+            {
+                std::string chatName;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+                    if (m_stop)
+                    {
+                        return;
+                    }
+                    chatName = m_queue.front();
+                    m_queue.pop_front();
+                }
+
+                titleChat(chatName);
+            }
+        }
+
+        bool isStopping()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stop;
+        }
+
+        void titleChat(const std::string& chatName)
+        {
+            KOLOSAL_TRACE_SCOPE("ChatTitleGenerator::titleChat", "chat");
+
+            // The chat may have been renamed or deleted while waiting
+            auto chat = ChatManager::getInstance().getChat(chatName);
+            if (!chat.has_value() || chat->messages.size() < 2)
+            {
+                return;
+            }
+
+            ChatCompletionParameters params;
+            params.messages.push_back({ "system",
+                "You name conversations. Reply with a short title of at most six words and nothing else." });
+            params.messages.push_back({ "user",
+                "User: " + excerpt(chat->messages[0].content) +
+                "\nAssistant: " + excerpt(chat->messages[1].content) +
+                "\n\nTitle:" });
+            params.maxNewTokens = Config::AutoTitle::MAX_NEW_TOKENS;
+            params.minLength = 1;
+            params.temperature = Config::AutoTitle::TEMPERATURE;
+            params.streaming = false;
+
+            Model::ModelManager& modelManager = Model::ModelManager::getInstance();
+            std::future<int> admission = modelManager.submitBackgroundChatCompletionJob(params);
+            while (admission.wait_for(std::chrono::milliseconds(Config::AutoTitle::IDLE_POLL_INTERVAL_MS))
+                != std::future_status::ready)
+            {
+                if (isStopping())
+                {
+                    return;
+                }
+            }
+
+            int jobId = admission.get();
+            if (jobId < 0)
+            {
+                return;
+            }
+
+            modelManager.waitForJob(jobId);
+            if (modelManager.hasJobError(jobId))
+            {
+                std::cerr << "[ChatTitleGenerator] Failed to title chat " << chatName << ": "
+                    << modelManager.getJobError(jobId) << std::endl;
+                return;
+            }
+
+            std::string title = sanitizeTitle(modelManager.getJobResult(jobId).text);
+            if (title.empty())
+            {
+                return;
+            }
+
+            // Titles are not unique; fall back to numbered variants on collision
+            ChatManager& chatManager = ChatManager::getInstance();
+            std::string candidate = title;
+            for (int suffix = 2; chatManager.getChat(candidate).has_value() && suffix < 100; ++suffix)
+            {
+                candidate = title + " (" + std::to_string(suffix) + ")";
+            }
+
+            if (chatManager.renameChat(chatName, candidate).get())
+            {
+                std::cout << "[ChatTitleGenerator] Renamed " << chatName << " to " << candidate << std::endl;
+            }
+        }
+
+        static std::string excerpt(const std::string& text)
+        {
+            if (text.size() <= Config::AutoTitle::EXCERPT_LENGTH)
+            {
+                return text;
+            }
+            return text.substr(0, Config::AutoTitle::EXCERPT_LENGTH) + "...";
+        }
+
+        // Keeps the first line, without quotes, markdown or characters invalid in chat names
+        static std::string sanitizeTitle(std::string title)
+        {
+            title = title.substr(0, title.find_first_of("\r\n", title.find_first_not_of(" \t\r\n")));
+
+            const std::string removed = R"(<>:"/\|?*#`)";
+            title.erase(std::remove_if(title.begin(), title.end(),
+                [&removed](char c) { return removed.find(c) != std::string::npos; }),
+                title.end());
+
+            const char* trimmed = " \t\r\n.'";
+            title.erase(0, title.find_first_not_of(trimmed));
+            title.erase(title.find_last_not_of(trimmed) + 1);
+
+            if (title.size() > Config::AutoTitle::MAX_TITLE_LENGTH)
+            {
+                title.resize(Config::AutoTitle::MAX_TITLE_LENGTH);
+                title.erase(title.find_last_not_of(' ') + 1);
+            }
+            return title;
+        }
+
+        std::deque<std::string> m_queue;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::thread m_worker;
+        bool m_stop = false;
+    };
+
+} // namespace Chat
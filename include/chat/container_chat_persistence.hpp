@@ -0,0 +1,681 @@
+#pragma once
+
+#include "config.hpp"
+#include "chat_history.hpp"
+#include "chat_persistence.hpp"
+#include "crypto/crypto.hpp"
+#include "profiling/trace.hpp"
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <algorithm>
+#include <filesystem>
+
+namespace Chat
+{
+    /**
+     * @brief Chat persistence that keeps every chat in one page-structured file.
+     *
+     * Page 0 holds the header. Records are chains of fixed-size pages, each starting with the
+     * number of the next page and the bytes used. Released chains are pushed onto a free list
+     * that links pages through the same field, and allocation reuses them before growing the
+     * file. An open-addressing hash index of (name hash, first page) slots lives in its own page
+     * chain and is read once when the container is opened, so finding a chat costs one probe
+     * sequence in memory plus reading its first page to confirm the name.
+     *
+     * Each record holds the chat name and the chat JSON sealed with AES-GCM under the same key
+     * as FileChatPersistence. Names stay readable, as they are in file names today.
+     *
+     * Updates write the new record before switching the index slot to it and release the old
+     * chain last, so an interrupted write can leak pages but never damages a committed chat.
+     */
+    class ContainerChatPersistence : public IChatPersistence
+    {
+    public:
+        /**
+         * @param legacyBasePath Directory of a FileChatPersistence whose chats are copied in
+         * when the container is first created. The original files are left untouched.
+         */
+        ContainerChatPersistence(std::string containerPath, std::array<uint8_t, 32> key,
+            const std::string& legacyBasePath = "")
+            : m_containerPath(std::move(containerPath)), m_key(key)
+        {
+            bool created = false;
+            m_valid = openContainer(created);
+
+            if (m_valid && created && !legacyBasePath.empty() && std::filesystem::exists(legacyBasePath))
+            {
+                migrateFrom(legacyBasePath);
+            }
+        }
+
+        std::future<bool> saveChat(const ChatHistory& chat) override
+        {
+            m_pendingWrites.fetch_add(1, std::memory_order_relaxed);
+            return std::async(std::launch::async, [this, chat]() {
+                KOLOSAL_TRACE_SCOPE("ContainerChatPersistence::saveChat", "persistence");
+                std::lock_guard<std::mutex> lock(m_ioMutex);
+                bool saved = m_valid && writeChat(chat);
+                m_pendingWrites.fetch_sub(1, std::memory_order_relaxed);
+                return saved;
+                });
+        }
+
+        size_t getPendingWriteCount() const override
+        {
+            return m_pendingWrites.load(std::memory_order_relaxed);
+        }
+
+        std::future<bool> deleteChat(const std::string& chatName) override
+        {
+            return std::async(std::launch::async, [this, chatName]() {
+                KOLOSAL_TRACE_SCOPE("ContainerChatPersistence::deleteChat", "persistence");
+                std::lock_guard<std::mutex> lock(m_ioMutex);
+                return m_valid && removeChat(chatName);
+                });
+        }
+
+        std::future<std::vector<ChatHistory>> loadAllChats() override
+        {
+            return std::async(std::launch::async, [this]() {
+                KOLOSAL_TRACE_SCOPE("ContainerChatPersistence::loadAllChats", "persistence");
+                std::lock_guard<std::mutex> lock(m_ioMutex);
+                return m_valid ? readAllChats() : std::vector<ChatHistory>();
+                });
+        }
+
+    private:
+        static constexpr char MAGIC[8] = { 'K', 'O', 'L', 'C', 'H', 'D', 'B', '1' };
+        static constexpr uint32_t VERSION = 1;
+        static constexpr uint32_t PAGE_SIZE = Config::ChatContainer::PAGE_SIZE;
+        static constexpr uint32_t PAGE_HEADER_SIZE = 8;    // next page, bytes used
+        static constexpr uint32_t PAGE_PAYLOAD = PAGE_SIZE - PAGE_HEADER_SIZE;
+        static constexpr uint32_t SLOT_SIZE = 16;          // name hash, first page, record length
+        static constexpr uint32_t SLOTS_PER_PAGE = PAGE_PAYLOAD / SLOT_SIZE;
+        static constexpr uint32_t NO_PAGE = 0;             // page 0 is the header, never a link target
+        static constexpr uint32_t DELETED_SLOT = 0xFFFFFFFFu;
+
+        struct Header
+        {
+            uint32_t pageCount = 0;
+            uint32_t freeListHead = NO_PAGE;
+            uint32_t indexFirstPage = NO_PAGE;
+            uint32_t slotCount = 0;
+            uint32_t usedSlots = 0;
+            uint32_t deletedSlots = 0;
+        };
+
+        struct Slot
+        {
+            uint64_t hash = 0;
+            uint32_t firstPage = NO_PAGE;  // NO_PAGE when empty, DELETED_SLOT when deleted
+            uint32_t length = 0;
+        };
+
+        const std::string m_containerPath;
+        const std::array<uint8_t, 32> m_key;
+        std::fstream m_file;
+        Header m_header;
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_indexPages;
+        bool m_valid = false;
+        std::mutex m_ioMutex;
+        std::atomic<size_t> m_pendingWrites{ 0 };
+
+        static void putUint32(uint8_t* out, uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+                out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+
+        static uint32_t getUint32(const uint8_t* in)
+        {
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i)
+                value |= static_cast<uint32_t>(in[i]) << (8 * i);
+            return value;
+        }
+
+        static void putUint64(uint8_t* out, uint64_t value)
+        {
+            putUint32(out, static_cast<uint32_t>(value));
+            putUint32(out + 4, static_cast<uint32_t>(value >> 32));
+        }
+
+        static uint64_t getUint64(const uint8_t* in)
+        {
+            return static_cast<uint64_t>(getUint32(in)) | (static_cast<uint64_t>(getUint32(in + 4)) << 32);
+        }
+
+        // FNV-1a; stable across runs and platforms, unlike std::hash
+        static uint64_t hashName(const std::string& name)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (unsigned char c : name)
+            {
+                hash ^= c;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        // ---- Page I/O ------------------------------------------------------------------
+
+        bool readPage(uint32_t page, std::vector<uint8_t>& buffer)
+        {
+            buffer.resize(PAGE_SIZE);
+            m_file.clear();
+            m_file.seekg(static_cast<std::streamoff>(page) * PAGE_SIZE);
+            return static_cast<bool>(m_file.read(reinterpret_cast<char*>(buffer.data()), PAGE_SIZE));
+        }
+
+        bool writeAt(std::streamoff offset, const uint8_t* data, size_t size)
+        {
+            m_file.clear();
+            m_file.seekp(offset);
+            return static_cast<bool>(m_file.write(reinterpret_cast<const char*>(data), size));
+        }
+
+        bool writePage(uint32_t page, const std::vector<uint8_t>& buffer)
+        {
+            return writeAt(static_cast<std::streamoff>(page) * PAGE_SIZE, buffer.data(), PAGE_SIZE);
+        }
+
+        bool setNextPage(uint32_t page, uint32_t next)
+        {
+            uint8_t bytes[4];
+            putUint32(bytes, next);
+            return writeAt(static_cast<std::streamoff>(page) * PAGE_SIZE, bytes, sizeof(bytes));
+        }
+
+        bool writeHeader()
+        {
+            std::vector<uint8_t> page(PAGE_SIZE, 0);
+            std::memcpy(page.data(), MAGIC, sizeof(MAGIC));
+            putUint32(&page[8], VERSION);
+            putUint32(&page[12], PAGE_SIZE);
+            putUint32(&page[16], m_header.pageCount);
+            putUint32(&page[20], m_header.freeListHead);
+            putUint32(&page[24], m_header.indexFirstPage);
+            putUint32(&page[28], m_header.slotCount);
+            putUint32(&page[32], m_header.usedSlots);
+            putUint32(&page[36], m_header.deletedSlots);
+            return writePage(0, page);
+        }
+
+        bool readHeader()
+        {
+            std::vector<uint8_t> page;
+            if (!readPage(0, page) || std::memcmp(page.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+                getUint32(&page[8]) != VERSION || getUint32(&page[12]) != PAGE_SIZE)
+            {
+                return false;
+            }
+            m_header.pageCount = getUint32(&page[16]);
+            m_header.freeListHead = getUint32(&page[20]);
+            m_header.indexFirstPage = getUint32(&page[24]);
+            m_header.slotCount = getUint32(&page[28]);
+            m_header.usedSlots = getUint32(&page[32]);
+            m_header.deletedSlots = getUint32(&page[36]);
+            return m_header.slotCount > 0;
+        }
+
+        // ---- Page allocation -----------------------------------------------------------
+
+        // Takes pages from the free list first, then grows the file. The header is written
+        // before the pages are used, so a crash afterwards only leaks them.
+        std::vector<uint32_t> allocatePages(size_t count)
+        {
+            std::vector<uint32_t> pages;
+            pages.reserve(count);
+            std::vector<uint8_t> buffer;
+            while (pages.size() < count && m_header.freeListHead != NO_PAGE)
+            {
+                const uint32_t page = m_header.freeListHead;
+                if (!readPage(page, buffer))
+                {
+                    // A broken free list is abandoned rather than trusted
+                    m_header.freeListHead = NO_PAGE;
+                    break;
+                }
+                pages.push_back(page);
+                m_header.freeListHead = getUint32(buffer.data());
+            }
+            while (pages.size() < count)
+            {
+                pages.push_back(m_header.pageCount++);
+            }
+            writeHeader();
+            return pages;
+        }
+
+        // Pushes a chain that is already linked in order onto the free list.
+        void releaseChain(const std::vector<uint32_t>& pages)
+        {
+            if (pages.empty())
+            {
+                return;
+            }
+            setNextPage(pages.back(), m_header.freeListHead);
+            m_header.freeListHead = pages.front();
+            writeHeader();
+        }
+
+        std::vector<uint32_t> collectChain(uint32_t firstPage)
+        {
+            std::vector<uint32_t> pages;
+            uint8_t pageHeader[PAGE_HEADER_SIZE];
+            for (uint32_t page = firstPage; page != NO_PAGE && page < m_header.pageCount; )
+            {
+                if (std::find(pages.begin(), pages.end(), page) != pages.end())
+                {
+                    break; // cycle in a damaged chain
+                }
+                pages.push_back(page);
+
+                m_file.clear();
+                m_file.seekg(static_cast<std::streamoff>(page) * PAGE_SIZE);
+                if (!m_file.read(reinterpret_cast<char*>(pageHeader), sizeof(pageHeader)))
+                {
+                    break;
+                }
+                page = getUint32(pageHeader);
+            }
+            return pages;
+        }
+
+        // Writes bytes across freshly allocated pages and returns the first page.
+        uint32_t writeChain(const std::vector<uint8_t>& bytes)
+        {
+            const size_t pageCount = std::max<size_t>(1, (bytes.size() + PAGE_PAYLOAD - 1) / PAGE_PAYLOAD);
+            std::vector<uint32_t> pages = allocatePages(pageCount);
+
+            std::vector<uint8_t> buffer(PAGE_SIZE);
+            for (size_t i = 0; i < pages.size(); ++i)
+            {
+                const size_t offset = i * PAGE_PAYLOAD;
+                const size_t used = std::min<size_t>(PAGE_PAYLOAD, bytes.size() - std::min(offset, bytes.size()));
+                std::fill(buffer.begin(), buffer.end(), 0);
+                putUint32(&buffer[0], i + 1 < pages.size() ? pages[i + 1] : NO_PAGE);
+                putUint32(&buffer[4], static_cast<uint32_t>(used));
+                if (used > 0)
+                {
+                    std::memcpy(&buffer[PAGE_HEADER_SIZE], bytes.data() + offset, used);
+                }
+                if (!writePage(pages[i], buffer))
+                {
+                    return NO_PAGE;
+                }
+            }
+            return pages.front();
+        }
+
+        std::optional<std::vector<uint8_t>> readChain(uint32_t firstPage, uint32_t length)
+        {
+            std::vector<uint8_t> bytes;
+            bytes.reserve(length);
+            std::vector<uint8_t> buffer;
+            uint32_t page = firstPage;
+            while (bytes.size() < length && page != NO_PAGE && page < m_header.pageCount)
+            {
+                if (!readPage(page, buffer))
+                {
+                    return std::nullopt;
+                }
+                const uint32_t used = std::min(getUint32(&buffer[4]), PAGE_PAYLOAD);
+                bytes.insert(bytes.end(), buffer.begin() + PAGE_HEADER_SIZE, buffer.begin() + PAGE_HEADER_SIZE + used);
+                page = getUint32(&buffer[0]);
+            }
+            if (bytes.size() < length)
+            {
+                return std::nullopt;
+            }
+            bytes.resize(length);
+            return bytes;
+        }
+
+        // ---- Index ---------------------------------------------------------------------
+
+        bool writeSlot(size_t index)
+        {
+            uint8_t bytes[SLOT_SIZE];
+            putUint64(bytes, m_slots[index].hash);
+            putUint32(bytes + 8, m_slots[index].firstPage);
+            putUint32(bytes + 12, m_slots[index].length);
+
+            const uint32_t page = m_indexPages[index / SLOTS_PER_PAGE];
+            const std::streamoff offset = static_cast<std::streamoff>(page) * PAGE_SIZE + PAGE_HEADER_SIZE +
+                static_cast<std::streamoff>(index % SLOTS_PER_PAGE) * SLOT_SIZE;
+            return writeAt(offset, bytes, sizeof(bytes));
+        }
+
+        bool readIndex()
+        {
+            m_slots.assign(m_header.slotCount, Slot{});
+            m_indexPages.clear();
+
+            std::vector<uint8_t> buffer;
+            uint32_t page = m_header.indexFirstPage;
+            size_t slot = 0;
+            while (slot < m_slots.size())
+            {
+                if (page == NO_PAGE || page >= m_header.pageCount || !readPage(page, buffer))
+                {
+                    return false;
+                }
+                m_indexPages.push_back(page);
+                for (uint32_t i = 0; i < SLOTS_PER_PAGE && slot < m_slots.size(); ++i, ++slot)
+                {
+                    const uint8_t* entry = &buffer[PAGE_HEADER_SIZE + i * SLOT_SIZE];
+                    m_slots[slot].hash = getUint64(entry);
+                    m_slots[slot].firstPage = getUint32(entry + 8);
+                    m_slots[slot].length = getUint32(entry + 12);
+                }
+                page = getUint32(&buffer[0]);
+            }
+            return true;
+        }
+
+        // Writes a whole slot table into a new index chain, then switches the header to it.
+        bool writeIndex(const std::vector<Slot>& slots)
+        {
+            std::vector<uint8_t> bytes(slots.size() * SLOT_SIZE);
+            std::vector<uint8_t> padded;
+            for (size_t i = 0; i < slots.size(); ++i)
+            {
+                putUint64(&bytes[i * SLOT_SIZE], slots[i].hash);
+                putUint32(&bytes[i * SLOT_SIZE + 8], slots[i].firstPage);
+                putUint32(&bytes[i * SLOT_SIZE + 12], slots[i].length);
+            }
+
+            // Slots never straddle pages, so each page carries SLOTS_PER_PAGE of them
+            const size_t pageCount = (slots.size() + SLOTS_PER_PAGE - 1) / SLOTS_PER_PAGE;
+            padded.assign(pageCount * PAGE_PAYLOAD, 0);
+            for (size_t p = 0; p < pageCount; ++p)
+            {
+                const size_t begin = p * SLOTS_PER_PAGE * SLOT_SIZE;
+                const size_t end = std::min(bytes.size(), begin + SLOTS_PER_PAGE * SLOT_SIZE);
+                std::copy(bytes.begin() + begin, bytes.begin() + end, padded.begin() + p * PAGE_PAYLOAD);
+            }
+
+            const uint32_t firstPage = writeChain(padded);
+            if (firstPage == NO_PAGE)
+            {
+                return false;
+            }
+
+            const std::vector<uint32_t> oldPages = m_indexPages;
+            m_slots = slots;
+            m_indexPages = collectChain(firstPage);
+            m_header.indexFirstPage = firstPage;
+            m_header.slotCount = static_cast<uint32_t>(slots.size());
+            m_header.deletedSlots = 0;
+            writeHeader();
+            releaseChain(oldPages);
+            return true;
+        }
+
+        // First empty or deleted slot on the probe sequence of the hash
+        static size_t findFreeSlot(const std::vector<Slot>& slots, uint64_t hash)
+        {
+            size_t index = hash % slots.size();
+            while (slots[index].firstPage != NO_PAGE && slots[index].firstPage != DELETED_SLOT)
+            {
+                index = (index + 1) % slots.size();
+            }
+            return index;
+        }
+
+        // Grows the table, dropping deleted slots, once it gets too full to probe quickly.
+        bool ensureIndexCapacity()
+        {
+            const double load = static_cast<double>(m_header.usedSlots + m_header.deletedSlots + 1) / m_slots.size();
+            if (load <= Config::ChatContainer::MAX_INDEX_LOAD)
+            {
+                return true;
+            }
+
+            size_t slotCount = m_slots.size();
+            while (static_cast<double>(m_header.usedSlots + 1) / slotCount > Config::ChatContainer::MAX_INDEX_LOAD / 2)
+            {
+                slotCount *= 2;
+            }
+
+            std::vector<Slot> slots(slotCount);
+            for (const auto& slot : m_slots)
+            {
+                if (slot.firstPage != NO_PAGE && slot.firstPage != DELETED_SLOT)
+                {
+                    slots[findFreeSlot(slots, slot.hash)] = slot;
+                }
+            }
+            return writeIndex(slots);
+        }
+
+        std::optional<std::string> readRecordName(uint32_t firstPage)
+        {
+            std::vector<uint8_t> buffer;
+            if (firstPage >= m_header.pageCount || !readPage(firstPage, buffer))
+            {
+                return std::nullopt;
+            }
+            const uint32_t nameLength = getUint32(&buffer[PAGE_HEADER_SIZE]);
+            if (nameLength > PAGE_PAYLOAD - 4)
+            {
+                return std::nullopt;
+            }
+            return std::string(reinterpret_cast<const char*>(&buffer[PAGE_HEADER_SIZE + 4]), nameLength);
+        }
+
+        std::optional<size_t> findSlot(const std::string& name, uint64_t hash)
+        {
+            size_t index = hash % m_slots.size();
+            for (size_t probes = 0; probes < m_slots.size() && m_slots[index].firstPage != NO_PAGE; ++probes)
+            {
+                const Slot& slot = m_slots[index];
+                if (slot.firstPage != DELETED_SLOT && slot.hash == hash && readRecordName(slot.firstPage) == name)
+                {
+                    return index;
+                }
+                index = (index + 1) % m_slots.size();
+            }
+            return std::nullopt;
+        }
+
+        // ---- Container -----------------------------------------------------------------
+
+        bool openContainer(bool& created)
+        {
+            const bool exists = std::filesystem::exists(m_containerPath) &&
+                std::filesystem::file_size(m_containerPath) >= PAGE_SIZE;
+            if (!exists)
+            {
+                std::ofstream create(m_containerPath, std::ios::binary | std::ios::trunc);
+                if (!create)
+                {
+                    std::cerr << "[ContainerChatPersistence] Failed to create " << m_containerPath << std::endl;
+                    return false;
+                }
+            }
+
+            m_file.open(m_containerPath, std::ios::in | std::ios::out | std::ios::binary);
+            if (!m_file.is_open())
+            {
+                std::cerr << "[ContainerChatPersistence] Failed to open " << m_containerPath << std::endl;
+                return false;
+            }
+
+            if (!exists)
+            {
+                created = true;
+                m_header = Header{};
+                m_header.pageCount = 1;
+                writeHeader();
+                if (!writeIndex(std::vector<Slot>(Config::ChatContainer::INITIAL_INDEX_PAGES * SLOTS_PER_PAGE)))
+                {
+                    return false;
+                }
+                m_file.flush();
+                return true;
+            }
+
+            if (!readHeader() || !readIndex())
+            {
+                // Leave the file as it is so it can be recovered; nothing is read or written
+                std::cerr << "[ContainerChatPersistence] " << m_containerPath
+                    << " is not a valid chat container" << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        void migrateFrom(const std::string& legacyBasePath)
+        {
+            FileChatPersistence legacy(legacyBasePath, m_key);
+            std::vector<ChatHistory> chats = legacy.loadAllChats().get();
+            for (const auto& chat : chats)
+            {
+                writeChat(chat);
+            }
+            std::cout << "[ContainerChatPersistence] Copied " << chats.size() << " chats from "
+                << legacyBasePath << " into " << m_containerPath << std::endl;
+        }
+
+        bool writeChat(const ChatHistory& chat)
+        {
+            try
+            {
+                nlohmann::json chatJson;
+                to_json(chatJson, chat);
+                std::string jsonStr = chatJson.dump();
+                std::vector<uint8_t> encrypted = Crypto::encrypt(
+                    std::vector<uint8_t>(jsonStr.begin(), jsonStr.end()), m_key);
+
+                // Record: name length, name, sealed chat
+                std::vector<uint8_t> record(4 + chat.name.size());
+                putUint32(record.data(), static_cast<uint32_t>(chat.name.size()));
+                std::memcpy(record.data() + 4, chat.name.data(), chat.name.size());
+                record.insert(record.end(), encrypted.begin(), encrypted.end());
+
+                const uint64_t hash = hashName(chat.name);
+                std::optional<size_t> existing = findSlot(chat.name, hash);
+                if (!existing.has_value() && !ensureIndexCapacity())
+                {
+                    return false;
+                }
+
+                const uint32_t firstPage = writeChain(record);
+                if (firstPage == NO_PAGE)
+                {
+                    return false;
+                }
+
+                const Slot updated{ hash, firstPage, static_cast<uint32_t>(record.size()) };
+                if (existing.has_value())
+                {
+                    const std::vector<uint32_t> oldPages = collectChain(m_slots[existing.value()].firstPage);
+                    m_slots[existing.value()] = updated;
+                    writeSlot(existing.value());
+                    releaseChain(oldPages);
+                }
+                else
+                {
+                    const size_t index = findFreeSlot(m_slots, hash);
+                    if (m_slots[index].firstPage == DELETED_SLOT)
+                    {
+                        --m_header.deletedSlots;
+                    }
+                    m_slots[index] = updated;
+                    writeSlot(index);
+                    ++m_header.usedSlots;
+                    writeHeader();
+                }
+
+                m_file.flush();
+                return static_cast<bool>(m_file);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[ContainerChatPersistence] Failed to save chat " << chat.name << ": " << e.what() << std::endl;
+                return false;
+            }
+        }
+
+        bool removeChat(const std::string& chatName)
+        {
+            std::optional<size_t> index = findSlot(chatName, hashName(chatName));
+            if (!index.has_value())
+            {
+                return true;
+            }
+
+            const std::vector<uint32_t> pages = collectChain(m_slots[index.value()].firstPage);
+            m_slots[index.value()].firstPage = DELETED_SLOT;
+            writeSlot(index.value());
+            --m_header.usedSlots;
+            ++m_header.deletedSlots;
+            releaseChain(pages);
+            m_file.flush();
+            return static_cast<bool>(m_file);
+        }
+
+        std::vector<ChatHistory> readAllChats()
+        {
+            std::vector<Slot> live;
+            for (const auto& slot : m_slots)
+            {
+                if (slot.firstPage != NO_PAGE && slot.firstPage != DELETED_SLOT)
+                {
+                    live.push_back(slot);
+                }
+            }
+
+            // Visiting records in page order keeps the reads mostly sequential
+            std::sort(live.begin(), live.end(),
+                [](const Slot& a, const Slot& b) { return a.firstPage < b.firstPage; });
+
+            std::vector<ChatHistory> chats;
+            chats.reserve(live.size());
+            for (const auto& slot : live)
+            {
+                try
+                {
+                    auto record = readChain(slot.firstPage, slot.length);
+                    if (!record.has_value() || record->size() < 4)
+                    {
+                        continue;
+                    }
+
+                    const uint32_t nameLength = getUint32(record->data());
+                    if (4 + static_cast<size_t>(nameLength) > record->size())
+                    {
+                        continue;
+                    }
+
+                    std::vector<uint8_t> encrypted(record->begin() + 4 + nameLength, record->end());
+                    std::vector<uint8_t> plaintext = Crypto::decrypt(encrypted, m_key);
+
+                    ChatHistory chat;
+                    from_json(nlohmann::json::parse(plaintext.begin(), plaintext.end()), chat);
+                    chats.push_back(std::move(chat));
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "[ContainerChatPersistence] Skipping unreadable record at page "
+                        << slot.firstPage << ": " << e.what() << std::endl;
+                }
+            }
+            return chats;
+        }
+    };
+
+} // namespace Chat
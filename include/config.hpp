@@ -1,6 +1,8 @@
 #pragma once
 
 #include <imgui.h>
+#include <cstddef>
+#include <cstdint>
 
 
 // TODO: Need to refactor this to use json file that is modifiable by the user in realtime
@@ -66,7 +68,11 @@ namespace Config
 
     namespace InputField
     {
-        constexpr size_t TEXT_SIZE = 81920;
+        constexpr size_t TEXT_SIZE = 81920;         // fixed buffer of the smaller input fields
+
+        constexpr size_t UNDO_LIMIT = 256;          // edits kept by the chat input editor
+        constexpr double CARET_BLINK_PERIOD = 1.2;  // seconds
+        constexpr double CARET_ON_TIME = 0.8;       // part of the period the caret is shown
 
         constexpr float CHILD_ROUNDING = 10.0F;
         constexpr float FRAME_ROUNDING = 12.0F;
@@ -79,6 +85,9 @@ namespace Config
         constexpr float SIDEBAR_WIDTH = 150.0F;
         constexpr float MIN_SIDEBAR_WIDTH = 150.0F;
         constexpr float MAX_SIDEBAR_WIDTH = 400.0F;
+        constexpr int FUZZY_CONSECUTIVE_BONUS = 5;      // per filter character right after the previous match
+        constexpr int FUZZY_WORD_START_BONUS = 8;       // per filter character matching the start of a word
+        constexpr int FUZZY_MAX_LEADING_PENALTY = 3;    // cap on the cost of a late first match
     } // namespace ChatHistorySidebar
 
     namespace ModelPresetSidebar
@@ -119,6 +128,146 @@ namespace Config
         constexpr float POPUP_ROUNDING = 2.0F;
     } // namespace ComboBox
 
+    namespace Startup
+    {
+        constexpr const char* TIMELINE_FILE = "startup_timeline.jsonl";
+        constexpr float SKELETON_PULSE_SPEED = 2.0F;
+    } // namespace Startup
+
+    namespace Scheduler
+    {
+        constexpr int POLL_INTERVAL_MS = 20;        // completion polling of jobs in flight
+    } // namespace Scheduler
+
+    namespace TokenStream
+    {
+        constexpr size_t RING_CAPACITY = 64 * 1024;     // bytes of undrained text per job
+        constexpr int FULL_RETRY_MS = 5;
+        constexpr float DRAIN_INTERVAL = 1.0F / 30.0F;  // max wait between frames while streaming
+    } // namespace TokenStream
+
+    namespace ResponseCache
+    {
+        constexpr const char* DIRECTORY = "response_cache";
+        constexpr uint64_t MAX_BYTES = 64ull * 1024 * 1024;    // encrypted entries kept on disk
+        constexpr float GREEDY_TEMPERATURE = 0.01F;             // at or below this the seed is not part of the key
+        constexpr int FIRST_JOB_ID = 1 << 30;                   // ids of replies served from the cache
+    } // namespace ResponseCache
+
+    namespace AutoTitle
+    {
+        constexpr int MAX_NEW_TOKENS = 16;
+        constexpr float TEMPERATURE = 0.3F;
+        constexpr size_t EXCERPT_LENGTH = 600;      // characters of each message shown to the model
+        constexpr size_t MAX_TITLE_LENGTH = 40;
+        constexpr int IDLE_POLL_INTERVAL_MS = 250;  // how often a queued request re-checks for shutdown
+    } // namespace AutoTitle
+
+    namespace HistorySummary
+    {
+        constexpr size_t CHARS_PER_TOKEN = 4;
+        constexpr size_t TRIGGER_TOKENS = 2048;         // summary plus raw turns in the prompt that start a new summary
+        constexpr size_t TARGET_TOKENS = 1024;          // once started, folding goes on down to this
+        constexpr size_t MAX_INPUT_TOKENS = 2048;       // turns folded into the summary by one job
+        constexpr size_t KEEP_RECENT_MESSAGES = 4;      // latest messages always sent verbatim
+        constexpr int MAX_NEW_TOKENS = 384;
+        constexpr float TEMPERATURE = 0.2F;
+        constexpr int IDLE_POLL_INTERVAL_MS = 250;      // how often a queued request re-checks for shutdown
+    } // namespace HistorySummary
+
+    namespace Attachment
+    {
+        // The engine does not report its context size; parts are sized for a 4K context
+        constexpr size_t CONTEXT_TOKENS = 4096;
+        constexpr size_t CHARS_PER_TOKEN = 4;               // rough average for prose
+        constexpr int NOTE_MAX_NEW_TOKENS = 384;            // output budget of each map and merge job
+        constexpr size_t PROMPT_RESERVE_TOKENS = 512;       // instructions and chat template
+        constexpr size_t CHUNK_TOKENS = CONTEXT_TOKENS - PROMPT_RESERVE_TOKENS - NOTE_MAX_NEW_TOKENS;
+        constexpr size_t MAX_JOBS_IN_FLIGHT = 4;            // parts submitted ahead of the one being collected
+        constexpr size_t READ_BUFFER_BYTES = 64 * 1024;
+        constexpr float TEMPERATURE = 0.2F;
+        constexpr int POLL_INTERVAL_MS = 50;
+        constexpr size_t PROGRESS_EXCERPT_LENGTH = 160;     // characters of each part's notes shown while reading
+    } // namespace Attachment
+
+    namespace Benchmark
+    {
+        constexpr const char* PROMPTS_FILE = "benchmark_prompts.json";  // JSON array of prompt strings
+        constexpr const char* RESULTS_DIRECTORY = "benchmark_results";
+        constexpr int SAMPLE_INTERVAL_MS = 5;       // polling of a running job for TTFT and RSS
+        constexpr int WARMUP_RUNS = 1;              // unrecorded runs after each model switch
+        constexpr float MODAL_WIDTH = 860.0F;
+        constexpr float MODAL_HEIGHT = 560.0F;
+    } // namespace Benchmark
+
+    namespace ChatArchive
+    {
+        constexpr const char* DEFAULT_PATH = "chats.kolchat";
+        constexpr size_t CHATS_PER_WORKER = 4;                      // records in flight per hardware thread
+        constexpr uint32_t MAX_RECORD_BYTES = 256u * 1024u * 1024u; // guards allocations on corrupt input
+    } // namespace ChatArchive
+
+    namespace ChatContainer
+    {
+        constexpr const char* FILE_PATH = "chats.kcdb";
+        constexpr uint32_t PAGE_SIZE = 4096;
+        constexpr uint32_t INITIAL_INDEX_PAGES = 4;
+        constexpr double MAX_INDEX_LOAD = 0.7;      // live + deleted slots per slot before the index grows
+    } // namespace ChatContainer
+
+    namespace Quantizer
+    {
+        constexpr uint64_t CHUNK_BYTES = 8ull * 1024 * 1024;   // source bytes read per worker step
+        constexpr unsigned THREAD_COUNT = 0;                   // 0 uses every hardware thread
+    } // namespace Quantizer
+
+    namespace ModelIntegrity
+    {
+        constexpr bool CHECKSUM_ON_STARTUP = false;                         // hash every model file in the startup scan
+        constexpr uint64_t CHECKSUM_CHUNK_BYTES = 64ull * 1024 * 1024;      // unit of parallel hashing
+        constexpr size_t READ_BUFFER_BYTES = 1024 * 1024;
+    } // namespace ModelIntegrity
+
+    namespace ModelCatalog
+    {
+        constexpr int PROGRESS_REFRESH_MS = 100;    // snapshot age while downloads or quantizations run
+    } // namespace ModelCatalog
+
+    namespace Tracing
+    {
+        constexpr size_t RING_CAPACITY = 8192;      // events retained per thread
+        constexpr size_t MAX_THREAD_BUFFERS = 64;
+        constexpr const char* DUMP_FILE = "kolosal_trace.json";
+        constexpr ImGuiKey DUMP_KEY = ImGuiKey_F9;
+    } // namespace Tracing
+
+    namespace PerformanceOverlay
+    {
+        constexpr ImGuiKey TOGGLE_KEY = ImGuiKey_F3;
+        constexpr size_t FRAME_HISTORY_SIZE = 240;
+        constexpr double STAGE_SMOOTHING = 0.1;
+        constexpr float WIDTH = 280.0F;
+        constexpr float HISTOGRAM_HEIGHT = 60.0F;
+        constexpr double THROUGHPUT_SAMPLE_INTERVAL = 0.5; // seconds
+    } // namespace PerformanceOverlay
+
+    namespace Memory
+    {
+        constexpr ImGuiKey DUMP_KEY = ImGuiKey_F4;
+
+        // Budgets in bytes per Profiling::MemorySubsystem, in enum order; 0 disables the check
+        constexpr int64_t BUDGETS[] = {
+            256LL * 1024 * 1024,    // ChatHistory
+            1LL * 1024 * 1024,      // Presets
+            1LL * 1024 * 1024,      // ModelCatalog
+            64LL * 1024 * 1024,     // FontAtlas
+            64LL * 1024 * 1024,     // GradientTexture
+            16LL * 1024 * 1024,     // DownloadBuffers
+            0,                      // ModelMappings
+            0,                      // ModelWeights
+        };
+    } // namespace Memory
+
     constexpr float HALF_DIVISOR = 2.0F;
     constexpr float BOTTOM_MARGIN = 10.0F;
     constexpr float INPUT_HEIGHT = 100.0F;
@@ -9,6 +9,7 @@
 #include <sys/ioctl.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <linux/if_packet.h>
 #endif
 
 #include <openssl/evp.h>
@@ -20,6 +21,8 @@
 #include <array>
 #include <string>
 
+#include "profiling/trace.hpp"
+
 // TODO: use password-based key derivation function (PBKDF2) to generate key from password
 //       to be more secure.
 
@@ -29,6 +32,8 @@ public:
     static constexpr size_t IV_SIZE = 12;
     static constexpr size_t TAG_SIZE = 16;
     static constexpr size_t KEY_SIZE = 32;
+    static constexpr size_t SALT_SIZE = 16;
+    static constexpr uint32_t PBKDF2_ITERATIONS = 600000;
 
     static std::array<uint8_t, KEY_SIZE> generateKey()
     {
@@ -62,6 +67,39 @@ public:
         return key;
     }
 
+    /**
+     * @brief Derives a key from a user passphrase with PBKDF2-HMAC-SHA256.
+     *
+     * Unlike generateKey(), the result does not depend on the machine, so data encrypted
+     * with it can be moved elsewhere and opened with the same passphrase and salt.
+     */
+    static std::array<uint8_t, KEY_SIZE> deriveKeyFromPassphrase(
+        const std::string& passphrase,
+        const std::array<uint8_t, SALT_SIZE>& salt,
+        uint32_t iterations = PBKDF2_ITERATIONS
+    )
+    {
+        KOLOSAL_TRACE_SCOPE("Crypto::deriveKeyFromPassphrase", "crypto");
+        std::array<uint8_t, KEY_SIZE> key;
+        if (PKCS5_PBKDF2_HMAC(passphrase.data(), static_cast<int>(passphrase.size()),
+            salt.data(), static_cast<int>(salt.size()), static_cast<int>(iterations),
+            EVP_sha256(), static_cast<int>(key.size()), key.data()) != 1)
+        {
+            throw std::runtime_error("Failed to derive key from passphrase");
+        }
+        return key;
+    }
+
+    static std::array<uint8_t, SALT_SIZE> generateSalt()
+    {
+        std::array<uint8_t, SALT_SIZE> salt;
+        if (RAND_bytes(salt.data(), static_cast<int>(salt.size())) != 1)
+        {
+            throw std::runtime_error("Failed to generate salt");
+        }
+        return salt;
+    }
+
     static std::string getUniqueDeviceIdentifier()
     {
 #ifdef _WIN32
@@ -117,6 +155,7 @@ public:
         const std::array<uint8_t, KEY_SIZE>& key
     )
     {
+        KOLOSAL_TRACE_SCOPE_ARG("Crypto::encrypt", "crypto", plaintext.size());
         std::vector<uint8_t> iv(IV_SIZE);
         if (RAND_bytes(iv.data(), IV_SIZE) != 1)
         {
@@ -180,6 +219,7 @@ public:
         const std::array<uint8_t, KEY_SIZE>& key
     )
     {
+        KOLOSAL_TRACE_SCOPE_ARG("Crypto::decrypt", "crypto", encrypted.size());
         if (encrypted.size() < IV_SIZE + TAG_SIZE)
         {
             throw std::runtime_error("Invalid encrypted data size");
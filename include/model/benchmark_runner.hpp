@@ -0,0 +1,486 @@
+#pragma once
+
+#include "config.hpp"
+#include "common.hpp"
+#include "model_manager.hpp"
+#include "preset_manager.hpp"
+#include "profiling/trace.hpp"
+#include "profiling/process_stats.hpp"
+#include "profiling/memory_tracker.hpp"
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <optional>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <json.hpp>
+
+namespace Model
+{
+    struct BenchmarkTarget
+    {
+        std::string modelName;
+        std::string variantType;
+    };
+
+    /**
+     * @brief Measurements of one prompt run against one model variant and preset.
+     */
+    struct BenchmarkResult
+    {
+        std::string modelName;
+        std::string variantType;
+        std::string presetName;
+        int promptIndex = 0;
+        double ttftMs = 0.0;            // from admission to the first generated token
+        double tokensPerSecond = 0.0;   // decode rate after the first token
+        int outputTokens = 0;
+        size_t outputLength = 0;        // characters of generated text
+        double totalMs = 0.0;
+        uint64_t peakResidentBytes = 0;
+        int64_t modelWeightsBytes = 0;
+        std::string error;
+    };
+
+    inline void to_json(nlohmann::json& j, const BenchmarkResult& r)
+    {
+        j = nlohmann::json{
+            {"modelName", r.modelName},
+            {"variantType", r.variantType},
+            {"presetName", r.presetName},
+            {"promptIndex", r.promptIndex},
+            {"ttftMs", r.ttftMs},
+            {"tokensPerSecond", r.tokensPerSecond},
+            {"outputTokens", r.outputTokens},
+            {"outputLength", r.outputLength},
+            {"totalMs", r.totalMs},
+            {"peakResidentBytes", r.peakResidentBytes},
+            {"modelWeightsBytes", r.modelWeightsBytes},
+            {"error", r.error}};
+    }
+
+    inline void from_json(const nlohmann::json& j, BenchmarkResult& r)
+    {
+        j.at("modelName").get_to(r.modelName);
+        j.at("variantType").get_to(r.variantType);
+        j.at("presetName").get_to(r.presetName);
+        j.at("promptIndex").get_to(r.promptIndex);
+        j.at("ttftMs").get_to(r.ttftMs);
+        j.at("tokensPerSecond").get_to(r.tokensPerSecond);
+        j.at("outputTokens").get_to(r.outputTokens);
+        r.outputLength = j.value("outputLength", static_cast<size_t>(0));
+        j.at("totalMs").get_to(r.totalMs);
+        j.at("peakResidentBytes").get_to(r.peakResidentBytes);
+        j.at("modelWeightsBytes").get_to(r.modelWeightsBytes);
+        r.error = j.value("error", "");
+    }
+
+    struct BenchmarkRun
+    {
+        std::string timestamp;
+        std::vector<std::string> prompts;
+        std::vector<BenchmarkResult> results;
+    };
+
+    inline void to_json(nlohmann::json& j, const BenchmarkRun& run)
+    {
+        j = nlohmann::json{
+            {"timestamp", run.timestamp},
+            {"prompts", run.prompts},
+            {"results", run.results}};
+    }
+
+    inline void from_json(const nlohmann::json& j, BenchmarkRun& run)
+    {
+        j.at("timestamp").get_to(run.timestamp);
+        j.at("prompts").get_to(run.prompts);
+        j.at("results").get_to(run.results);
+    }
+
+    /**
+     * @brief Runs a prompt set over a grid of model variants and presets and records
+     * latency, throughput and memory for each combination.
+     *
+     * Runs go through the background queue, so a reply the user is waiting for always
+     * goes first. The grid is walked one model at a time on a single worker thread; each
+     * switch reloads the engine, which is why the model selected before the run is
+     * restored at the end. Every finished run is written to Config::Benchmark::RESULTS_DIRECTORY.
+     */
+    class BenchmarkRunner
+    {
+    public:
+        static BenchmarkRunner& getInstance()
+        {
+            static BenchmarkRunner instance;
+            return instance;
+        }
+
+        BenchmarkRunner(const BenchmarkRunner&) = delete;
+        BenchmarkRunner& operator=(const BenchmarkRunner&) = delete;
+
+        /**
+         * @brief Starts a run in the background. Returns false if one is already running or
+         * the grid is empty.
+         */
+        bool start(const std::vector<std::string>& prompts,
+            const std::vector<BenchmarkTarget>& targets,
+            const std::vector<std::string>& presetNames)
+        {
+            if (prompts.empty() || targets.empty() || presetNames.empty() || m_running.exchange(true))
+            {
+                return false;
+            }
+
+            if (m_worker.joinable())
+            {
+                m_worker.join();
+            }
+
+            m_cancelRequested.store(false);
+            m_completedCount.store(0);
+            m_totalCount.store(prompts.size() * targets.size() * presetNames.size());
+            m_worker = std::thread(&BenchmarkRunner::run, this, prompts, targets, presetNames);
+            return true;
+        }
+
+        // The engine cannot abort a job, so the run stops once the current prompt completes.
+        void cancel() { m_cancelRequested.store(true); }
+
+        bool isRunning() const { return m_running.load(); }
+        size_t getCompletedCount() const { return m_completedCount.load(); }
+        size_t getTotalCount() const { return m_totalCount.load(); }
+
+        BenchmarkRun getLastRun() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_lastRun;
+        }
+
+        /**
+         * @brief Reads the prompt set from Config::Benchmark::PROMPTS_FILE, falling back to a
+         * small built-in set when the file is missing or malformed.
+         */
+        static std::vector<std::string> loadPrompts()
+        {
+            std::ifstream file(Config::Benchmark::PROMPTS_FILE);
+            if (file.is_open())
+            {
+                try
+                {
+                    nlohmann::json j;
+                    file >> j;
+                    std::vector<std::string> prompts = j.get<std::vector<std::string>>();
+                    if (!prompts.empty())
+                    {
+                        return prompts;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "[BenchmarkRunner] Failed to read " << Config::Benchmark::PROMPTS_FILE
+                        << ": " << e.what() << std::endl;
+                }
+            }
+
+            return {
+                "Explain what a hash map is in two sentences.",
+                "Write a short poem about the sea.",
+                "List five tips for writing readable code.",
+                "Summarize the plot of Romeo and Juliet in one paragraph."
+            };
+        }
+
+        // Saved result files, newest first.
+        static std::vector<std::filesystem::path> listSavedRuns()
+        {
+            std::vector<std::filesystem::path> files;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(Config::Benchmark::RESULTS_DIRECTORY, ec))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".json")
+                {
+                    files.push_back(entry.path());
+                }
+            }
+            std::sort(files.begin(), files.end(), std::greater<>());
+            return files;
+        }
+
+        static std::optional<BenchmarkRun> loadRun(const std::filesystem::path& path)
+        {
+            std::ifstream file(path);
+            if (!file.is_open())
+            {
+                return std::nullopt;
+            }
+
+            try
+            {
+                nlohmann::json j;
+                file >> j;
+                return j.get<BenchmarkRun>();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[BenchmarkRunner] Failed to load " << path.string() << ": " << e.what() << std::endl;
+                return std::nullopt;
+            }
+        }
+
+    private:
+        BenchmarkRunner() = default;
+
+        ~BenchmarkRunner()
+        {
+            m_cancelRequested.store(true);
+            if (m_worker.joinable())
+            {
+                m_worker.join();
+            }
+        }
+
+        void run(std::vector<std::string> prompts,
+            std::vector<BenchmarkTarget> targets,
+            std::vector<std::string> presetNames)
+        {
+            KOLOSAL_TRACE_THREAD_NAME("BenchmarkRunner");
+            KOLOSAL_TRACE_SCOPE("BenchmarkRunner::run", "benchmark");
+
+            ModelManager& modelManager = ModelManager::getInstance();
+            const std::optional<std::string> originalModel = modelManager.getCurrentModelName();
+            const std::string originalVariant = modelManager.getCurrentVariantType();
+
+            std::vector<ModelPreset> presets;
+            for (const auto& preset : PresetManager::getInstance().getPresets())
+            {
+                if (std::find(presetNames.begin(), presetNames.end(), preset.name) != presetNames.end())
+                {
+                    presets.push_back(preset);
+                }
+            }
+
+            BenchmarkRun benchmarkRun;
+            benchmarkRun.timestamp = timePointToString(std::chrono::system_clock::now());
+            benchmarkRun.prompts = prompts;
+
+            const std::vector<ModelData> models = modelManager.getModels();
+            bool switchedModel = false;
+
+            for (const auto& target : targets)
+            {
+                if (m_cancelRequested.load())
+                {
+                    break;
+                }
+
+                auto model = std::find_if(models.begin(), models.end(),
+                    [&target](const ModelData& m) { return m.name == target.modelName; });
+                std::string error;
+                if (model == models.end())
+                {
+                    error = "Model not found";
+                }
+                else if (!modelManager.isModelDownloaded(model - models.begin(), target.variantType))
+                {
+                    error = "Variant not downloaded";
+                }
+                else if (modelManager.getCurrentModelName() != target.modelName ||
+                    modelManager.getCurrentVariantType() != target.variantType ||
+                    !modelManager.isModelReady())
+                {
+                    switchedModel = true;
+                    if (!modelManager.switchModel(target.modelName, target.variantType))
+                    {
+                        error = "Failed to load model";
+                    }
+                }
+
+                for (const auto& preset : presets)
+                {
+                    if (error.empty() && !m_cancelRequested.load())
+                    {
+                        for (int i = 0; i < Config::Benchmark::WARMUP_RUNS; ++i)
+                        {
+                            runPrompt(target, preset, prompts.front(), 0);
+                        }
+                    }
+
+                    for (size_t promptIndex = 0; promptIndex < prompts.size(); ++promptIndex)
+                    {
+                        if (m_cancelRequested.load())
+                        {
+                            break;
+                        }
+
+                        BenchmarkResult result;
+                        if (error.empty())
+                        {
+                            result = runPrompt(target, preset, prompts[promptIndex], static_cast<int>(promptIndex));
+                        }
+                        else
+                        {
+                            result.modelName = target.modelName;
+                            result.variantType = target.variantType;
+                            result.presetName = preset.name;
+                            result.promptIndex = static_cast<int>(promptIndex);
+                            result.error = error;
+                        }
+
+                        benchmarkRun.results.push_back(result);
+                        {
+                            std::lock_guard<std::mutex> lock(m_mutex);
+                            m_lastRun = benchmarkRun;
+                        }
+                        m_completedCount.fetch_add(1);
+                    }
+                }
+            }
+
+            if (switchedModel && originalModel.has_value() &&
+                (modelManager.getCurrentModelName() != originalModel ||
+                 modelManager.getCurrentVariantType() != originalVariant))
+            {
+                modelManager.switchModel(originalModel.value(), originalVariant);
+            }
+
+            saveRun(benchmarkRun);
+            m_running.store(false);
+        }
+
+        BenchmarkResult runPrompt(const BenchmarkTarget& target, const ModelPreset& preset,
+            const std::string& prompt, const int promptIndex)
+        {
+            using Clock = std::chrono::steady_clock;
+            const auto sampleInterval = std::chrono::milliseconds(Config::Benchmark::SAMPLE_INTERVAL_MS);
+
+            BenchmarkResult result;
+            result.modelName = target.modelName;
+            result.variantType = target.variantType;
+            result.presetName = preset.name;
+            result.promptIndex = promptIndex;
+
+            ChatCompletionParameters params;
+            params.messages.push_back({ "system", preset.systemPrompt });
+            params.messages.push_back({ "user", prompt });
+            params.randomSeed = preset.random_seed;
+            params.maxNewTokens = static_cast<int>(preset.max_new_tokens);
+            params.minLength = static_cast<int>(preset.min_length);
+            params.temperature = preset.temperature;
+            params.topP = preset.top_p;
+            // Streamed so partial results, and with them the first token, show up while polling
+            params.streaming = true;
+
+            ModelManager& modelManager = ModelManager::getInstance();
+            std::future<int> admission = modelManager.submitBackgroundChatCompletionJob(params);
+            while (admission.wait_for(sampleInterval) != std::future_status::ready)
+            {
+                if (m_cancelRequested.load())
+                {
+                    result.error = "Cancelled";
+                    return result;
+                }
+            }
+
+            const int jobId = admission.get();
+            if (jobId < 0)
+            {
+                result.error = "Failed to submit job";
+                return result;
+            }
+
+            // Timing starts at admission so time spent queued behind user replies is excluded
+            const Clock::time_point admitted = Clock::now();
+            Clock::time_point firstToken;
+            bool hasFirstToken = false;
+            uint64_t peakResident = Profiling::getProcessResidentBytes();
+
+            // A failed job may never report finished, so its error ends the wait as well
+            while (!modelManager.isJobFinished(jobId) && !modelManager.hasJobError(jobId))
+            {
+                if (m_cancelRequested.load())
+                {
+                    // The engine cannot stop the job; it finishes in the background unobserved
+                    result.error = "Cancelled";
+                    return result;
+                }
+                if (!hasFirstToken && !modelManager.getJobResult(jobId).tokens.empty())
+                {
+                    firstToken = Clock::now();
+                    hasFirstToken = true;
+                }
+                peakResident = std::max(peakResident, Profiling::getProcessResidentBytes());
+                std::this_thread::sleep_for(sampleInterval);
+            }
+
+            const Clock::time_point finished = Clock::now();
+            if (!hasFirstToken)
+            {
+                firstToken = finished;
+            }
+
+            if (modelManager.hasJobError(jobId))
+            {
+                result.error = modelManager.getJobError(jobId);
+            }
+
+            CompletionResult completion = modelManager.getJobResult(jobId);
+            const double decodeSeconds = std::chrono::duration<double>(finished - firstToken).count();
+
+            result.ttftMs = std::chrono::duration<double, std::milli>(firstToken - admitted).count();
+            result.totalMs = std::chrono::duration<double, std::milli>(finished - admitted).count();
+            result.outputTokens = static_cast<int>(completion.tokens.size());
+            result.outputLength = completion.text.size();
+            result.tokensPerSecond = (result.outputTokens > 1 && decodeSeconds > 0.0)
+                ? (result.outputTokens - 1) / decodeSeconds
+                : 0.0;
+            result.peakResidentBytes = peakResident;
+            result.modelWeightsBytes = Profiling::MemoryTracker::getInstance()
+                .getCurrentBytes(Profiling::MemorySubsystem::ModelWeights);
+            return result;
+        }
+
+        void saveRun(const BenchmarkRun& benchmarkRun)
+        {
+            if (benchmarkRun.results.empty())
+            {
+                return;
+            }
+
+            std::error_code ec;
+            std::filesystem::create_directories(Config::Benchmark::RESULTS_DIRECTORY, ec);
+
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            const std::filesystem::path path = std::filesystem::path(Config::Benchmark::RESULTS_DIRECTORY) /
+                ("run_" + std::to_string(seconds) + ".json");
+
+            std::ofstream file(path);
+            if (!file.is_open())
+            {
+                std::cerr << "[BenchmarkRunner] Failed to write " << path.string() << std::endl;
+                return;
+            }
+
+            nlohmann::json j = benchmarkRun;
+            file << j.dump(4);
+            std::cout << "[BenchmarkRunner] Saved " << benchmarkRun.results.size()
+                << " results to " << path.string() << std::endl;
+        }
+
+        std::thread m_worker;
+        std::atomic<bool> m_running{ false };
+        std::atomic<bool> m_cancelRequested{ false };
+        std::atomic<size_t> m_completedCount{ 0 };
+        std::atomic<size_t> m_totalCount{ 0 };
+        mutable std::mutex m_mutex;
+        BenchmarkRun m_lastRun;
+    };
+
+} // namespace Model
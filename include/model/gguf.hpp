@@ -0,0 +1,349 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+
+namespace Model
+{
+    // Tensor types as numbered by ggml; only the ones Kolosal can read or produce are named.
+    enum class GgmlType : uint32_t
+    {
+        F32 = 0,
+        F16 = 1,
+        Q8_0 = 8,
+        Q4_K = 12,
+        BF16 = 30
+    };
+
+    // GGUF metadata value types
+    enum class GgufValueType : uint32_t
+    {
+        UInt8 = 0, Int8 = 1, UInt16 = 2, Int16 = 3, UInt32 = 4, Int32 = 5, Float32 = 6,
+        Bool = 7, String = 8, Array = 9, UInt64 = 10, Int64 = 11, Float64 = 12
+    };
+
+    /**
+     * @brief Elements per block and bytes per block of a ggml tensor type, or {0, 0} when the
+     * type is unknown.
+     */
+    inline std::pair<uint64_t, uint64_t> getGgmlTypeLayout(uint32_t type)
+    {
+        switch (type)
+        {
+        case 0:  return { 1, 4 };     // F32
+        case 1:  return { 1, 2 };     // F16
+        case 2:  return { 32, 18 };   // Q4_0
+        case 3:  return { 32, 20 };   // Q4_1
+        case 6:  return { 32, 22 };   // Q5_0
+        case 7:  return { 32, 24 };   // Q5_1
+        case 8:  return { 32, 34 };   // Q8_0
+        case 9:  return { 32, 36 };   // Q8_1
+        case 10: return { 256, 84 };  // Q2_K
+        case 11: return { 256, 110 }; // Q3_K
+        case 12: return { 256, 144 }; // Q4_K
+        case 13: return { 256, 176 }; // Q5_K
+        case 14: return { 256, 210 }; // Q6_K
+        case 15: return { 256, 292 }; // Q8_K
+        case 24: return { 1, 1 };     // I8
+        case 25: return { 1, 2 };     // I16
+        case 26: return { 1, 4 };     // I32
+        case 27: return { 1, 8 };     // I64
+        case 28: return { 1, 8 };     // F64
+        case 30: return { 1, 2 };     // BF16
+        default: return { 0, 0 };
+        }
+    }
+
+    struct GgufTensorInfo
+    {
+        std::string name;
+        std::vector<uint64_t> dims;     // dims[0] is the contiguous row length
+        uint32_t type = 0;
+        uint64_t offset = 0;            // relative to the start of the data section
+
+        uint64_t getElementCount() const
+        {
+            uint64_t count = 1;
+            for (uint64_t dim : dims)
+                count *= dim;
+            return count;
+        }
+
+        uint64_t getRowCount() const
+        {
+            return dims.empty() || dims[0] == 0 ? 0 : getElementCount() / dims[0];
+        }
+
+        // Size of the tensor data for a given type, 0 if the rows do not split into its blocks
+        uint64_t getByteSize(uint32_t asType) const
+        {
+            auto [blockSize, blockBytes] = getGgmlTypeLayout(asType);
+            if (blockSize == 0 || dims.empty() || dims[0] % blockSize != 0)
+                return 0;
+            return getElementCount() / blockSize * blockBytes;
+        }
+    };
+
+    /**
+     * @brief A metadata entry kept in its encoded form, so it can be copied to another file
+     * without understanding the value.
+     */
+    struct GgufMetadataEntry
+    {
+        std::string key;
+        uint32_t valueType = 0;
+        std::vector<uint8_t> value;
+    };
+
+    /**
+     * @brief The header of a GGUF file: metadata, tensor directory and data layout.
+     */
+    struct GgufHeader
+    {
+        uint32_t version = 3;
+        std::vector<GgufMetadataEntry> metadata;
+        std::vector<GgufTensorInfo> tensors;
+        uint64_t alignment = 32;
+        uint64_t dataOffset = 0;    // absolute file offset of the data section
+
+        const GgufMetadataEntry* findMetadata(const std::string& key) const
+        {
+            for (const auto& entry : metadata)
+            {
+                if (entry.key == key)
+                    return &entry;
+            }
+            return nullptr;
+        }
+    };
+
+    inline uint64_t alignGgufOffset(uint64_t offset, uint64_t alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Reads and writes GGUF headers. Tensor data is left to the caller.
+     */
+    class GgufIO
+    {
+    public:
+        static constexpr uint32_t MAGIC = 0x46554747; // "GGUF" read as little-endian
+
+        static std::optional<GgufHeader> readHeader(std::istream& in, std::string& error)
+        {
+            GgufHeader header;
+            uint32_t magic = 0;
+            uint64_t tensorCount = 0;
+            uint64_t metadataCount = 0;
+            if (!read(in, magic) || magic != MAGIC)
+            {
+                error = "not a GGUF file";
+                return std::nullopt;
+            }
+            if (!read(in, header.version) || header.version < 2 || header.version > 3)
+            {
+                error = "unsupported GGUF version";
+                return std::nullopt;
+            }
+            if (!read(in, tensorCount) || !read(in, metadataCount) ||
+                tensorCount > MAX_ENTRIES || metadataCount > MAX_ENTRIES)
+            {
+                error = "corrupt GGUF header";
+                return std::nullopt;
+            }
+
+            header.metadata.reserve(metadataCount);
+            for (uint64_t i = 0; i < metadataCount; ++i)
+            {
+                GgufMetadataEntry entry;
+                if (!readString(in, entry.key) || !read(in, entry.valueType) ||
+                    !readValue(in, entry.valueType, entry.value, 0))
+                {
+                    error = "corrupt GGUF metadata";
+                    return std::nullopt;
+                }
+                if (entry.key == "general.alignment" && entry.valueType == static_cast<uint32_t>(GgufValueType::UInt32))
+                {
+                    uint32_t alignment = 0;
+                    std::memcpy(&alignment, entry.value.data(), sizeof(alignment));
+                    header.alignment = alignment;
+                }
+                header.metadata.push_back(std::move(entry));
+            }
+            if (header.alignment == 0 || (header.alignment & (header.alignment - 1)) != 0)
+            {
+                error = "invalid GGUF alignment";
+                return std::nullopt;
+            }
+
+            header.tensors.reserve(tensorCount);
+            for (uint64_t i = 0; i < tensorCount; ++i)
+            {
+                GgufTensorInfo tensor;
+                uint32_t dimCount = 0;
+                if (!readString(in, tensor.name) || !read(in, dimCount) || dimCount == 0 || dimCount > 4)
+                {
+                    error = "corrupt GGUF tensor info";
+                    return std::nullopt;
+                }
+                tensor.dims.resize(dimCount);
+                for (auto& dim : tensor.dims)
+                {
+                    if (!read(in, dim))
+                    {
+                        error = "corrupt GGUF tensor info";
+                        return std::nullopt;
+                    }
+                }
+                if (!read(in, tensor.type) || !read(in, tensor.offset))
+                {
+                    error = "corrupt GGUF tensor info";
+                    return std::nullopt;
+                }
+                header.tensors.push_back(std::move(tensor));
+            }
+
+            header.dataOffset = alignGgufOffset(static_cast<uint64_t>(in.tellg()), header.alignment);
+            return header;
+        }
+
+        // Writes the header and pads to the start of the data section, whose offset it returns.
+        static uint64_t writeHeader(std::ostream& out, const GgufHeader& header)
+        {
+            write(out, MAGIC);
+            write(out, header.version);
+            write(out, static_cast<uint64_t>(header.tensors.size()));
+            write(out, static_cast<uint64_t>(header.metadata.size()));
+
+            for (const auto& entry : header.metadata)
+            {
+                writeString(out, entry.key);
+                write(out, entry.valueType);
+                out.write(reinterpret_cast<const char*>(entry.value.data()), entry.value.size());
+            }
+
+            for (const auto& tensor : header.tensors)
+            {
+                writeString(out, tensor.name);
+                write(out, static_cast<uint32_t>(tensor.dims.size()));
+                for (uint64_t dim : tensor.dims)
+                    write(out, dim);
+                write(out, tensor.type);
+                write(out, tensor.offset);
+            }
+
+            const uint64_t position = static_cast<uint64_t>(out.tellp());
+            const uint64_t dataOffset = alignGgufOffset(position, header.alignment);
+            const std::vector<char> padding(dataOffset - position, 0);
+            out.write(padding.data(), padding.size());
+            return dataOffset;
+        }
+
+        static GgufMetadataEntry makeUInt32Entry(const std::string& key, uint32_t value)
+        {
+            GgufMetadataEntry entry;
+            entry.key = key;
+            entry.valueType = static_cast<uint32_t>(GgufValueType::UInt32);
+            entry.value.resize(sizeof(value));
+            std::memcpy(entry.value.data(), &value, sizeof(value));
+            return entry;
+        }
+
+    private:
+        static constexpr uint64_t MAX_ENTRIES = 1u << 20;
+        static constexpr uint64_t MAX_STRING_LENGTH = 1u << 26;
+        static constexpr int MAX_ARRAY_DEPTH = 4;
+
+        // GGUF is little-endian, like every platform Kolosal builds for
+        template <typename T>
+        static bool read(std::istream& in, T& value)
+        {
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+        template <typename T>
+        static void write(std::ostream& out, const T& value)
+        {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        static bool readString(std::istream& in, std::string& value)
+        {
+            uint64_t length = 0;
+            if (!read(in, length) || length > MAX_STRING_LENGTH)
+                return false;
+            value.resize(length);
+            return length == 0 || static_cast<bool>(in.read(&value[0], length));
+        }
+
+        static void writeString(std::ostream& out, const std::string& value)
+        {
+            write(out, static_cast<uint64_t>(value.size()));
+            out.write(value.data(), value.size());
+        }
+
+        static bool appendBytes(std::istream& in, std::vector<uint8_t>& out, uint64_t count)
+        {
+            const size_t start = out.size();
+            out.resize(start + count);
+            return count == 0 || static_cast<bool>(in.read(reinterpret_cast<char*>(out.data() + start), count));
+        }
+
+        // Appends the encoded value to out, exactly as it appears in the file
+        static bool readValue(std::istream& in, uint32_t type, std::vector<uint8_t>& out, int depth)
+        {
+            switch (static_cast<GgufValueType>(type))
+            {
+            case GgufValueType::UInt8:
+            case GgufValueType::Int8:
+            case GgufValueType::Bool:
+                return appendBytes(in, out, 1);
+            case GgufValueType::UInt16:
+            case GgufValueType::Int16:
+                return appendBytes(in, out, 2);
+            case GgufValueType::UInt32:
+            case GgufValueType::Int32:
+            case GgufValueType::Float32:
+                return appendBytes(in, out, 4);
+            case GgufValueType::UInt64:
+            case GgufValueType::Int64:
+            case GgufValueType::Float64:
+                return appendBytes(in, out, 8);
+            case GgufValueType::String:
+            {
+                uint64_t length = 0;
+                if (!read(in, length) || length > MAX_STRING_LENGTH)
+                    return false;
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&length);
+                out.insert(out.end(), bytes, bytes + sizeof(length));
+                return appendBytes(in, out, length);
+            }
+            case GgufValueType::Array:
+            {
+                uint32_t elementType = 0;
+                uint64_t count = 0;
+                if (depth >= MAX_ARRAY_DEPTH || !read(in, elementType) || !read(in, count) || count > MAX_STRING_LENGTH)
+                    return false;
+                const uint8_t* typeBytes = reinterpret_cast<const uint8_t*>(&elementType);
+                const uint8_t* countBytes = reinterpret_cast<const uint8_t*>(&count);
+                out.insert(out.end(), typeBytes, typeBytes + sizeof(elementType));
+                out.insert(out.end(), countBytes, countBytes + sizeof(count));
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    if (!readValue(in, elementType, out, depth + 1))
+                        return false;
+                }
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+    };
+
+} // namespace Model
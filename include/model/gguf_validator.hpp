@@ -0,0 +1,231 @@
+#pragma once
+
+#include "gguf.hpp"
+#include "config.hpp"
+#include "profiling/trace.hpp"
+
+#include <string>
+#include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+namespace Model
+{
+    enum class GgufIntegrity
+    {
+        Valid,
+        Missing,    // nothing readable at the path; fileBytes is 0
+        Truncated,  // the header is intact up to where the file ends; a download can resume
+        Corrupt     // the file cannot be a GGUF model; it has to be downloaded again
+    };
+
+    struct GgufValidationResult
+    {
+        GgufIntegrity status = GgufIntegrity::Missing;
+        std::string message;
+        uint64_t fileBytes = 0;
+        uint64_t expectedBytes = 0;     // known once the tensor directory has been read
+        std::string checksum;           // only when requested, see GgufValidator::computeChecksum
+    };
+
+    /**
+     * @brief Checks that a model file is a complete GGUF without reading the tensor data.
+     *
+     * The header, tensor directory and data layout are checked against the file size, which
+     * takes a few milliseconds even for large models. A checksum over the whole file can be
+     * requested in addition.
+     */
+    class GgufValidator
+    {
+    public:
+        static GgufValidationResult validate(const std::string& path, bool withChecksum = false,
+            const std::atomic<bool>* cancelled = nullptr)
+        {
+            KOLOSAL_TRACE_SCOPE("GgufValidator::validate", "download");
+            GgufValidationResult result;
+
+            // file_size returns uintmax_t(-1) on failure, which must never reach fileBytes
+            std::error_code ec;
+            const uintmax_t fileBytes = std::filesystem::file_size(path, ec);
+            if (ec)
+            {
+                result.status = GgufIntegrity::Missing;
+                result.fileBytes = 0;
+                result.message = "file not found";
+                return result;
+            }
+            result.fileBytes = fileBytes;
+
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+            {
+                result.status = GgufIntegrity::Corrupt;
+                result.message = "cannot open file";
+                return result;
+            }
+
+            std::string error;
+            std::optional<GgufHeader> header = GgufIO::readHeader(file, error);
+            if (!header)
+            {
+                // Running out of bytes inside the header is an interrupted download
+                result.status = file.eof() ? GgufIntegrity::Truncated : GgufIntegrity::Corrupt;
+                result.message = file.eof() ? "file ends inside the header" : error;
+                return result;
+            }
+
+            // Tensors must be aligned, inside the file, and must not overlap
+            std::vector<std::pair<uint64_t, uint64_t>> ranges;
+            ranges.reserve(header->tensors.size());
+            for (const auto& tensor : header->tensors)
+            {
+                uint64_t elements = 1;
+                for (uint64_t dim : tensor.dims)
+                {
+                    if (dim == 0 || elements > MAX_ELEMENTS / dim)
+                    {
+                        return corrupt(result, "invalid dimensions for tensor " + tensor.name);
+                    }
+                    elements *= dim;
+                }
+
+                const uint64_t bytes = tensor.getByteSize(tensor.type);
+                if (bytes == 0)
+                {
+                    return corrupt(result, "unknown type or shape for tensor " + tensor.name);
+                }
+                if (tensor.offset % header->alignment != 0)
+                {
+                    return corrupt(result, "misaligned tensor " + tensor.name);
+                }
+                ranges.emplace_back(tensor.offset, tensor.offset + bytes);
+            }
+
+            std::sort(ranges.begin(), ranges.end());
+            uint64_t dataEnd = 0;
+            for (const auto& [begin, end] : ranges)
+            {
+                if (begin < dataEnd)
+                {
+                    return corrupt(result, "overlapping tensors");
+                }
+                dataEnd = end;
+            }
+
+            result.expectedBytes = header->dataOffset + dataEnd;
+            if (result.fileBytes < result.expectedBytes)
+            {
+                result.status = GgufIntegrity::Truncated;
+                result.message = "file is " + std::to_string(result.fileBytes) + " of " +
+                    std::to_string(result.expectedBytes) + " bytes";
+                return result;
+            }
+
+            if (withChecksum)
+            {
+                result.checksum = computeChecksum(path, result.fileBytes, cancelled);
+            }
+            result.status = GgufIntegrity::Valid;
+            return result;
+        }
+
+        /**
+         * @brief SHA-256 over the SHA-256 digests of consecutive fixed-size chunks, so the chunks
+         * can be hashed in parallel. Not comparable with a plain SHA-256 of the file.
+         *
+         * @return the hex digest, or an empty string on a read error or cancellation.
+         */
+        static std::string computeChecksum(const std::string& path, uint64_t fileBytes,
+            const std::atomic<bool>* cancelled = nullptr)
+        {
+            KOLOSAL_TRACE_SCOPE("GgufValidator::computeChecksum", "download");
+            const uint64_t chunkBytes = Config::ModelIntegrity::CHECKSUM_CHUNK_BYTES;
+            const size_t chunkCount = static_cast<size_t>((fileBytes + chunkBytes - 1) / chunkBytes);
+            std::vector<std::array<unsigned char, SHA256_DIGEST_LENGTH>> digests(chunkCount);
+
+            std::atomic<size_t> nextChunk{ 0 };
+            std::atomic<bool> failed{ false };
+            auto worker = [&]()
+                {
+                    std::ifstream file(path, std::ios::binary);
+                    std::vector<char> buffer(Config::ModelIntegrity::READ_BUFFER_BYTES);
+                    EVP_MD_CTX* context = EVP_MD_CTX_new();
+                    if (!file.is_open() || !context)
+                    {
+                        failed = true;
+                        EVP_MD_CTX_free(context);
+                        return;
+                    }
+
+                    for (size_t chunk = nextChunk++; chunk < chunkCount && !failed; chunk = nextChunk++)
+                    {
+                        const uint64_t begin = chunk * chunkBytes;
+                        uint64_t remaining = std::min(chunkBytes, fileBytes - begin);
+                        file.seekg(begin);
+                        EVP_DigestInit_ex(context, EVP_sha256(), nullptr);
+                        while (remaining > 0)
+                        {
+                            if (cancelled && cancelled->load())
+                            {
+                                failed = true;
+                                break;
+                            }
+                            const size_t toRead = static_cast<size_t>(std::min<uint64_t>(remaining, buffer.size()));
+                            if (!file.read(buffer.data(), toRead))
+                            {
+                                failed = true;
+                                break;
+                            }
+                            EVP_DigestUpdate(context, buffer.data(), toRead);
+                            remaining -= toRead;
+                        }
+                        EVP_DigestFinal_ex(context, digests[chunk].data(), nullptr);
+                    }
+                    EVP_MD_CTX_free(context);
+                };
+
+            const size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                std::max<size_t>(chunkCount, 1));
+            std::vector<std::thread> workers;
+            for (size_t i = 0; i < threadCount; ++i)
+                workers.emplace_back(worker);
+            for (auto& thread : workers)
+                thread.join();
+
+            if (failed)
+            {
+                return {};
+            }
+
+            unsigned char digest[SHA256_DIGEST_LENGTH];
+            EVP_Digest(digests.data(), digests.size() * SHA256_DIGEST_LENGTH, digest, nullptr, EVP_sha256(), nullptr);
+
+            std::string hex;
+            char byte[3];
+            for (unsigned char value : digest)
+            {
+                std::snprintf(byte, sizeof(byte), "%02x", value);
+                hex += byte;
+            }
+            return hex;
+        }
+
+    private:
+        static constexpr uint64_t MAX_ELEMENTS = 1ull << 48;
+
+        static GgufValidationResult corrupt(GgufValidationResult& result, const std::string& message)
+        {
+            result.status = GgufIntegrity::Corrupt;
+            result.message = message;
+            return result;
+        }
+    };
+
+} // namespace Model
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "config.hpp"
+#include "profiling/trace.hpp"
+
+#include <types.h>
+#include <inference_interface.h>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+namespace Model
+{
+    enum class JobPriority
+    {
+        Interactive,    // chat replies the user is waiting on
+        Background      // titles, summaries and other work nobody is watching
+    };
+
+    /**
+     * @brief Admission control in front of the inference engine.
+     *
+     * The engine decodes its jobs one after another in submission order and offers no way to
+     * pause or cancel a job once submitted. Priorities are therefore enforced before
+     * submission: interactive jobs go to the engine immediately, while background jobs wait in
+     * a FIFO queue and are admitted one at a time, only while no interactive job is in
+     * flight. An interactive request can thus be delayed by at most the remainder of one
+     * background job, which callers keep short by bounding its token budget.
+     *
+     * The engine has a single evaluated context. A background job replaces the chat prefix
+     * left by the last reply, so the next interactive turn evaluates its prompt from scratch.
+     */
+    class InferenceScheduler
+    {
+    public:
+        InferenceScheduler() = default;
+
+        ~InferenceScheduler()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+                for (auto& request : m_backgroundQueue)
+                {
+                    request.promise.set_value(-1);
+                }
+                m_backgroundQueue.clear();
+            }
+            m_condition.notify_all();
+            if (m_dispatcher.joinable())
+            {
+                m_dispatcher.join();
+            }
+        }
+
+        InferenceScheduler(const InferenceScheduler&) = delete;
+        InferenceScheduler& operator=(const InferenceScheduler&) = delete;
+
+        // Called with the scheduler lock held right before any job reaches the engine.
+        void setAdmissionObserver(std::function<void(const ChatCompletionParameters&, JobPriority)> observer)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_admissionObserver = std::move(observer);
+        }
+
+        // Background jobs are only admitted while an engine with a loaded model is set.
+        void setEngine(IInferenceEngine* engine)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_engine = engine;
+                ensureDispatcherLocked();
+            }
+            m_condition.notify_all();
+        }
+
+        /**
+         * @brief Submits a job straight to the engine, ahead of every queued background job.
+         *
+         * @return The engine job id, or -1 on failure.
+         */
+        int submitInteractive(IInferenceEngine* engine, const ChatCompletionParameters& params)
+        {
+            if (!engine)
+            {
+                return -1;
+            }
+
+            int jobId = -1;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_admissionObserver)
+                {
+                    m_admissionObserver(params, JobPriority::Interactive);
+                }
+                jobId = engine->submitChatCompletionsJob(params);
+                if (jobId >= 0)
+                {
+                    m_interactiveJobs.push_back(jobId);
+                    ensureDispatcherLocked();
+                }
+            }
+            m_condition.notify_all();
+            return jobId;
+        }
+
+        /**
+         * @brief Queues a job until the engine is free of interactive work.
+         *
+         * @return A future that receives the engine job id once admitted, or -1 on failure.
+         */
+        std::future<int> submitBackground(ChatCompletionParameters params)
+        {
+            std::future<int> jobId;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_backgroundQueue.push_back({ std::move(params), std::promise<int>() });
+                jobId = m_backgroundQueue.back().promise.get_future();
+                if (m_stop)
+                {
+                    m_backgroundQueue.back().promise.set_value(-1);
+                    m_backgroundQueue.pop_back();
+                    return jobId;
+                }
+                ensureDispatcherLocked();
+            }
+            m_condition.notify_all();
+            return jobId;
+        }
+
+        /**
+         * @brief Stops counting an interactive job whose output is no longer wanted.
+         *
+         * The engine cannot cancel a job, so it still decodes the rest. Background work is
+         * submitted behind it instead of waiting until it ends.
+         */
+        void releaseInteractive(int jobId)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_interactiveJobs.erase(
+                    std::remove(m_interactiveJobs.begin(), m_interactiveJobs.end(), jobId),
+                    m_interactiveJobs.end());
+            }
+            m_condition.notify_all();
+        }
+
+        size_t getQueuedBackgroundCount() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_backgroundQueue.size();
+        }
+
+        size_t getInteractiveInFlightCount() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_interactiveJobs.size();
+        }
+
+    private:
+        struct BackgroundRequest
+        {
+            ChatCompletionParameters params;
+            std::promise<int> promise;
+        };
+
+        void ensureDispatcherLocked()
+        {
+            if (!m_dispatcher.joinable() && !m_stop)
+            {
+                m_dispatcher = std::thread(&InferenceScheduler::run, this);
+            }
+        }
+
+        void run()
+        {
+            KOLOSAL_TRACE_THREAD_NAME("InferenceScheduler");
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_stop)
+            {
+                reapFinishedJobsLocked();
+
+                if (m_engine && m_interactiveJobs.empty() && m_backgroundJob < 0 && !m_backgroundQueue.empty())
+                {
+                    BackgroundRequest request = std::move(m_backgroundQueue.front());
+                    m_backgroundQueue.pop_front();
+
+                    if (m_admissionObserver)
+                    {
+                        m_admissionObserver(request.params, JobPriority::Background);
+                    }
+                    m_backgroundJob = m_engine->submitChatCompletionsJob(request.params);
+                    KOLOSAL_TRACE_INSTANT("BackgroundJobAdmitted", "inference", m_backgroundJob);
+                    request.promise.set_value(m_backgroundJob);
+                    continue;
+                }
+
+                // Jobs in flight are polled; with nothing in flight only a submission can change anything
+                if (m_interactiveJobs.empty() && m_backgroundJob < 0)
+                {
+                    m_condition.wait(lock);
+                }
+                else
+                {
+                    m_condition.wait_for(lock, std::chrono::milliseconds(Config::Scheduler::POLL_INTERVAL_MS));
+                }
+            }
+        }
+
+        void reapFinishedJobsLocked()
+        {
+            if (!m_engine)
+            {
+                return;
+            }
+
+            auto finished = [this](int jobId) {
+                return m_engine->isJobFinished(jobId) || m_engine->hasJobError(jobId);
+            };
+
+            m_interactiveJobs.erase(
+                std::remove_if(m_interactiveJobs.begin(), m_interactiveJobs.end(), finished),
+                m_interactiveJobs.end());
+
+            if (m_backgroundJob >= 0 && finished(m_backgroundJob))
+            {
+                m_backgroundJob = -1;
+            }
+        }
+
+        IInferenceEngine* m_engine = nullptr;
+        std::function<void(const ChatCompletionParameters&, JobPriority)> m_admissionObserver;
+        std::vector<int> m_interactiveJobs;
+        std::deque<BackgroundRequest> m_backgroundQueue;
+        int m_backgroundJob = -1;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::thread m_dispatcher;
+        bool m_stop = false;
+    };
+
+} // namespace Model
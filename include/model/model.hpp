@@ -16,6 +16,7 @@ namespace Model
         bool isDownloaded;
         double downloadProgress; // 0.0 to 100.0
         int lastSelected;
+        std::string checksum;   // recorded by the integrity scan, see GgufValidator::computeChecksum
 
         ModelVariant(const std::string &type = "",
                      const std::string &path = "",
@@ -39,7 +40,8 @@ namespace Model
             {"downloadLink", v.downloadLink},
             {"isDownloaded", v.isDownloaded},
             {"downloadProgress", v.downloadProgress},
-            {"lastSelected", v.lastSelected}};
+            {"lastSelected", v.lastSelected},
+            {"checksum", v.checksum}};
     }
 
     inline void from_json(const nlohmann::json &j, ModelVariant &v)
@@ -50,6 +52,7 @@ namespace Model
         j.at("isDownloaded").get_to(v.isDownloaded);
         j.at("downloadProgress").get_to(v.downloadProgress);
         j.at("lastSelected").get_to(v.lastSelected);
+        v.checksum = j.value("checksum", std::string());
     }
 
     struct ModelData
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "gguf_validator.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace Model
+{
+    enum class VariantKind
+    {
+        FullPrecision,
+        Quantized8Bit,
+        Quantized4Bit
+    };
+
+    constexpr size_t VARIANT_KIND_COUNT = 3;
+
+    // The variant type string used by ModelVariant::type and the ModelManager API
+    inline const char* getVariantTypeName(VariantKind kind)
+    {
+        switch (kind)
+        {
+        case VariantKind::FullPrecision: return "Full Precision";
+        case VariantKind::Quantized8Bit: return "8-bit Quantized";
+        case VariantKind::Quantized4Bit: return "4-bit Quantized";
+        }
+        return "";
+    }
+
+    inline std::optional<VariantKind> getVariantKind(const std::string& typeName)
+    {
+        for (size_t i = 0; i < VARIANT_KIND_COUNT; ++i)
+        {
+            if (typeName == getVariantTypeName(static_cast<VariantKind>(i)))
+                return static_cast<VariantKind>(i);
+        }
+        return std::nullopt;
+    }
+
+    struct VariantView
+    {
+        bool isDownloaded = false;
+        bool isQuantizing = false;
+        double downloadProgress = 0.0;                      // 0.0 to 100.0
+        std::optional<GgufValidationResult> integrityIssue; // see ModelManager::getIntegrityIssue
+    };
+
+    struct ModelCardView
+    {
+        std::string name;
+        std::string author;
+        std::array<VariantView, VARIANT_KIND_COUNT> variants;
+
+        const VariantView& getVariant(VariantKind kind) const { return variants[static_cast<size_t>(kind)]; }
+    };
+
+    /**
+     * @brief Immutable copy of everything the model views draw, taken under one lock.
+     *
+     * Views hold on to a snapshot for the frame and read plain values from it; the model
+     * manager builds a new one only when its state has changed or, while downloads and
+     * quantizations report progress, at a bounded rate.
+     */
+    struct ModelCatalogSnapshot
+    {
+        uint64_t version = 0;
+        std::chrono::steady_clock::time_point builtAt;
+        std::vector<ModelCardView> models;
+        std::optional<size_t> selectedModel;
+        VariantKind selectedVariant = VariantKind::Quantized8Bit;
+        bool hasActiveWork = false;     // a download or quantization is in progress
+
+        bool isSelected(size_t modelIndex, VariantKind kind) const
+        {
+            return selectedModel == modelIndex && selectedVariant == kind;
+        }
+    };
+
+} // namespace Model
@@ -1,6 +1,18 @@
 #pragma once
 
 #include "model_persistence.hpp"
+#include "model_prefetcher.hpp"
+#include "session_prefix_tracker.hpp"
+#include "inference_scheduler.hpp"
+#include "token_stream.hpp"
+#include "stop_sequence_matcher.hpp"
+#include "quantizer.hpp"
+#include "gguf_validator.hpp"
+#include "model_catalog.hpp"
+#include "response_cache.hpp"
+#include "profiling/startup_timeline.hpp"
+#include "profiling/trace.hpp"
+#include "profiling/memory_tracker.hpp"
 
 #include <types.h>
 #include <inference_interface.h>
@@ -9,7 +21,13 @@
 #include <optional>
 #include <shared_mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <memory>
 #include <future>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 #include <iostream>
 #include <curl/curl.h>
 
@@ -19,9 +37,9 @@
 #include <Windows.h>
 #include <comdef.h>
 #include <Wbemidl.h>
-#endif
 
 #pragma comment(lib, "wbemuuid.lib")
+#endif
 
 typedef IInferenceEngine* (CreateInferenceEngineFunc)();
 
@@ -54,6 +72,7 @@ namespace Model
         // Switch to a specific model variant. If not downloaded, trigger download.
         bool switchModel(const std::string &modelName, const std::string &variantType)
         {
+            const auto switchStart = std::chrono::steady_clock::now();
             std::unique_lock<std::shared_mutex> lock(m_mutex);
             auto it = m_modelNameToIndex.find(modelName);
             if (it == m_modelNameToIndex.end())
@@ -64,6 +83,11 @@ namespace Model
             m_currentModelName = modelName;
             m_currentVariantType = variantType;
             m_currentModelIndex = it->second;
+            invalidateCatalogLocked();
+
+            // Any load still in flight, the startup warm-up included, is for another selection
+            const uint64_t generation = ++m_loadGeneration;
+            setModelReady(generation, false);
 
             // If not downloaded, start download
             ModelVariant *variant = getVariantLocked(m_currentModelIndex, m_currentVariantType);
@@ -84,11 +108,23 @@ namespace Model
                         // Release the lock to avoid potential deadlock
                         lock.unlock();
 
-                        if (!loadModelIntoEngine())
+                        if (!loadModelIntoEngine(generation))
                         {
-                            std::cerr << "[ModelManager] Failed to load model into inference engine.\n";
+                            if (setModelReady(generation, false, "Failed to load " + modelName))
+                            {
+                                std::cerr << "[ModelManager] Failed to load model into inference engine.\n";
+                            }
                             return false;
                         }
+                        const double timeToReadyMs = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - switchStart).count();
+                        if (!setModelReady(generation, true, {}, timeToReadyMs))
+                        {
+                            return false;
+                        }
+                        std::cout << "[ModelManager] Switched to " << modelName << " in "
+                            << timeToReadyMs << " ms" << std::endl;
+                        return true;
                     }
                 }
             }
@@ -119,6 +155,89 @@ namespace Model
             return true;
         }
 
+        /**
+         * @brief Produces a quantized variant from the downloaded full-precision file instead of
+         * downloading it. Progress is reported through the variant's download progress.
+         *
+         * @return false if the full-precision file is missing or the variant is already present
+         * or in progress.
+         */
+        bool quantizeModel(size_t modelIndex, const std::string &variantType)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            ModelVariant* source = getVariantLocked(modelIndex, "Full Precision");
+            ModelVariant* target = getVariantLocked(modelIndex, variantType);
+            if (!source || !target || source == target || !source->isDownloaded)
+            {
+                return false;
+            }
+            if (target->isDownloaded || target->downloadProgress > 0.0)
+            {
+                return false;
+            }
+
+            const GgmlType targetType = variantType == "4-bit Quantized" ? GgmlType::Q4_K : GgmlType::Q8_0;
+            ModelData* model = &m_models[modelIndex];
+            const std::string sourcePath = source->path;
+
+            // Non-zero progress marks the variant busy, like a download that has started
+            target->downloadProgress = MIN_REPORTED_PROGRESS;
+            m_quantizingVariants.insert(target);
+            m_integrityIssues.erase(target);
+            invalidateCatalogLocked();
+
+            m_downloadFutures.emplace_back(std::async(std::launch::async, [this, model, target, sourcePath, targetType]() {
+                KOLOSAL_TRACE_THREAD_NAME("Quantize");
+
+                QuantizationResult result = ModelQuantizer::quantizeFile(sourcePath, target->path, targetType,
+                    [target](double fraction)
+                    {
+                        target->downloadProgress = std::max(fraction * 100.0, MIN_REPORTED_PROGRESS);
+                    },
+                    &m_backgroundWorkCancelled);
+
+                {
+                    std::unique_lock<std::shared_mutex> lock(m_mutex);
+                    m_quantizingVariants.erase(target);
+                    target->isDownloaded = result.succeeded;
+                    target->downloadProgress = result.succeeded ? 100.0 : 0.0;
+                    invalidateCatalogLocked();
+                }
+
+                if (!result.succeeded)
+                {
+                    std::cerr << "[ModelManager] Quantization of " << sourcePath << " failed: " << result.error << "\n";
+                    return;
+                }
+
+                std::cout << "[ModelManager] Quantized " << sourcePath << " in " << result.seconds << " s ("
+                          << result.quantizedTensors << " tensors, " << result.outputBytes << " bytes)\n";
+                m_persistence->saveModelData(*model).get();
+            }));
+            return true;
+        }
+
+        bool isModelQuantizing(size_t modelIndex, const std::string &variantType) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            const ModelVariant *variant = getVariantLocked(modelIndex, variantType);
+            return variant && m_quantizingVariants.count(variant) > 0;
+        }
+
+        /**
+         * @brief The problem the startup integrity scan found with a variant's file, if any.
+         * Truncated files are resumed by the next download; corrupt ones have been removed.
+         */
+        std::optional<GgufValidationResult> getIntegrityIssue(size_t modelIndex, const std::string &variantType) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            const ModelVariant *variant = getVariantLocked(modelIndex, variantType);
+            auto it = variant ? m_integrityIssues.find(variant) : m_integrityIssues.end();
+            if (it == m_integrityIssues.end())
+                return std::nullopt;
+            return it->second;
+        }
+
         bool isModelDownloaded(size_t modelIndex, const std::string &variantType) const
         {
             std::shared_lock<std::shared_mutex> lock(m_mutex);
@@ -139,10 +258,79 @@ namespace Model
             return variant ? variant->downloadProgress : 0.0;
         }
 
+        /**
+         * @brief The catalog as drawn by the model views, for reading without further locking.
+         *
+         * Rebuilt only when the catalog has changed since the last call; while downloads or
+         * quantizations run, whose progress is written without the lock, at most every
+         * Config::ModelCatalog::PROGRESS_REFRESH_MS.
+         */
+        std::shared_ptr<const ModelCatalogSnapshot> getCatalogSnapshot() const
+        {
+            std::shared_ptr<const ModelCatalogSnapshot> snapshot = std::atomic_load(&m_catalogSnapshot);
+            const uint64_t version = m_catalogVersion.load(std::memory_order_acquire);
+            const auto now = std::chrono::steady_clock::now();
+            if (snapshot && snapshot->version == version &&
+                (!snapshot->hasActiveWork ||
+                 now - snapshot->builtAt < std::chrono::milliseconds(Config::ModelCatalog::PROGRESS_REFRESH_MS)))
+            {
+                return snapshot;
+            }
+
+            KOLOSAL_TRACE_SCOPE("ModelManager::buildCatalogSnapshot", "model");
+            auto built = std::make_shared<ModelCatalogSnapshot>();
+            built->version = version;
+            built->builtAt = now;
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                built->models.reserve(m_models.size());
+                for (size_t i = 0; i < m_models.size(); ++i)
+                {
+                    ModelCardView card;
+                    card.name = m_models[i].name;
+                    card.author = m_models[i].author;
+                    for (size_t kind = 0; kind < VARIANT_KIND_COUNT; ++kind)
+                    {
+                        const ModelVariant* variant = getVariantLocked(i, getVariantTypeName(static_cast<VariantKind>(kind)));
+                        VariantView& view = card.variants[kind];
+                        view.isDownloaded = variant->isDownloaded;
+                        view.downloadProgress = variant->downloadProgress;
+                        view.isQuantizing = m_quantizingVariants.count(variant) > 0;
+                        auto issue = m_integrityIssues.find(variant);
+                        if (issue != m_integrityIssues.end())
+                            view.integrityIssue = issue->second;
+                        built->hasActiveWork |= !view.isDownloaded && view.downloadProgress > 0.0;
+                    }
+                    built->models.push_back(std::move(card));
+                }
+
+                // A download reports no progress until its first bytes arrive
+                for (const auto& future : m_downloadFutures)
+                {
+                    if (!built->hasActiveWork && future.valid() &&
+                        future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    {
+                        built->hasActiveWork = true;
+                    }
+                }
+
+                std::optional<VariantKind> selectedKind = getVariantKind(m_currentVariantType);
+                if (m_currentModelName && selectedKind && m_currentModelIndex < m_models.size())
+                {
+                    built->selectedModel = m_currentModelIndex;
+                    built->selectedVariant = *selectedKind;
+                }
+            }
+
+            std::shared_ptr<const ModelCatalogSnapshot> result = std::move(built);
+            std::atomic_store(&m_catalogSnapshot, result);
+            return result;
+        }
+
         std::vector<ModelData> getModels() const
         {
             std::shared_lock<std::shared_mutex> lock(m_mutex);
-            return m_models;
+            return std::vector<ModelData>(m_models.begin(), m_models.end());
         }
 
         std::optional<std::string> getCurrentModelName() const
@@ -164,147 +352,292 @@ namespace Model
             return variant ? variant->downloadProgress : 0.0;
         }
 
+        // True once the current model is loaded and has completed its warm-up decode.
+        bool isModelReady() const
+        {
+            return m_modelReady.load(std::memory_order_acquire);
+        }
+
+        // Why the current model could not be loaded; empty while it is loading or ready.
+        std::string getModelLoadError() const
+        {
+            std::lock_guard<std::mutex> lock(m_readyMutex);
+            return m_modelLoadError;
+        }
+
+        // Number of submitted jobs that have not finished yet.
+        int getActiveJobCount() const
+        {
+            return m_activeJobCount.load(std::memory_order_relaxed);
+        }
+
+        // Generation speed of the most recently streamed job.
+        float getTokensPerSecond() const
+        {
+            return m_tokensPerSecond.load(std::memory_order_relaxed);
+        }
+
+        // Total bytes received by model downloads since startup.
+        uint64_t getDownloadedBytes() const
+        {
+            return m_persistence->getDownloadedBytes();
+        }
+
+        // Number of leading prompt messages the last interactive job shared with the prompt the
+        // engine evaluated before it, which may have been a background job's. The engine does
+        // not report how much of that it actually kept, so this is an upper bound on reuse.
+        size_t getLastSharedPrefixLength() const
+        {
+            return m_lastSharedPrefixLength.load(std::memory_order_relaxed);
+        }
+
+        // Milliseconds until the current model became ready, counted from manager construction
+        // for the startup model and from the switchModel call after a switch; 0 until then.
+        double getTimeToReadyMs() const
+        {
+            return m_timeToReadyMs.load(std::memory_order_acquire);
+        }
+
         //--------------------------------------------------------------------------------------------
 		// Inference Engine
 		//--------------------------------------------------------------------------------------------
 
-        void setStreamingCallback(std::function<void(const std::string&, const int)> callback)
+        /**
+         * @brief Applies the output streamed since the last call. UI thread only.
+         *
+         * The handler receives (jobId, delta, finished, succeeded) once per job with new text
+         * and once more when the job is done; finished streams are then dropped.
+         */
+        void drainTokenStreams(const std::function<void(const int, const std::string&, const bool, const bool)>& handler)
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
-            m_streamingCallback = std::move(callback);
+            KOLOSAL_TRACE_SCOPE("ModelManager::drainTokenStreams", "inference");
+            std::lock_guard<std::mutex> lock(m_tokenStreamsMutex);
+
+            for (auto it = m_tokenStreams.begin(); it != m_tokenStreams.end();)
+            {
+                TokenStream& stream = **it;
+
+                // Read the flag before draining so no text can arrive after a finished report
+                const bool finished = stream.isFinished();
+                m_drainBuffer.clear();
+                stream.drain(m_drainBuffer);
+
+                if (!m_drainBuffer.empty() || finished)
+                {
+                    handler(stream.getJobId(), m_drainBuffer, finished, finished && stream.hasSucceeded());
+                }
+                it = finished ? m_tokenStreams.erase(it) : it + 1;
+            }
+        }
+
+        bool hasActiveTokenStreams() const
+        {
+            std::lock_guard<std::mutex> lock(m_tokenStreamsMutex);
+            return !m_tokenStreams.empty();
         }
 
         int startCompletionJob(const CompletionParameters& params)
         {
-            int jobId = m_inferenceEngine->submitCompletionsJob(params);
+            IInferenceEngine* engine = getEngine();
+            if (!engine) {
+                std::cerr << "[ModelManager] No inference engine loaded. Cannot submit completions job.\n";
+                return -1;
+            }
+
+            int jobId = engine->submitCompletionsJob(params);
+            KOLOSAL_TRACE_INSTANT("JobSubmitted", "inference", jobId);
             if (jobId < 0) {
                 std::cerr << "[ModelManager] Failed to submit completions job.\n";
                 return -1;
             }
 
-            std::thread([this, jobId]() {
-                // Poll while job is running or until the engine says it's done
-                while (true)
-                {
-                    if (this->m_inferenceEngine->hasJobError(jobId)) break;
-
-                    CompletionResult partial = this->m_inferenceEngine->getJobResult(jobId);
+            startJobPolling(jobId);
+            return jobId;
+        }
 
-                    if (!partial.text.empty()) {
-                        // Call the users callback
-                        // (hold shared lock if needed to be thread-safe)
-                        std::shared_lock<std::shared_mutex> lock(m_mutex);
-                        if (m_streamingCallback) {
-                            m_streamingCallback(partial.text, jobId);
-                        }
+        /**
+         * @brief Submits an interactive chat job and streams its output to the callback.
+         *
+         * @param onSubmitted Runs with the job id before any output is streamed, so callers
+         * can set up routing for the job without racing the polling thread.
+         * @param stopSequences The reply ends before the first of these that it produces.
+         */
+        int startChatCompletionJob(const ChatCompletionParameters& params,
+            const std::function<void(const int)>& onSubmitted = nullptr,
+            const std::vector<std::string>& stopSequences = {})
+        {
+            std::string cacheKey;
+#ifdef KOLOSAL_RESPONSE_CACHE
+            cacheKey = getResponseCacheKey(params, stopSequences);
+            if (!cacheKey.empty())
+            {
+                if (auto cached = ResponseCache::getInstance().lookup(cacheKey))
+                {
+                    // Served without the engine, under an id the engine never hands out
+                    int jobId = m_nextCachedJobId.fetch_add(1, std::memory_order_relaxed);
+                    KOLOSAL_TRACE_INSTANT("JobServedFromCache", "inference", jobId);
+                    if (onSubmitted) {
+                        onSubmitted(jobId);
                     }
 
-                    if (this->m_inferenceEngine->isJobFinished(jobId)) break;
-
-                    // Sleep briefly to avoid busy-waiting
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    streamCachedResponse(jobId, std::move(cached.value()));
+                    return jobId;
                 }
-                }).detach();
+            }
+#endif
 
-            return jobId;
-        }
+            IInferenceEngine* engine = getEngine();
+            if (!engine) {
+                std::cerr << "[ModelManager] No inference engine loaded. Cannot submit chat completions job.\n";
+                return -1;
+            }
 
-        int startChatCompletionJob(const ChatCompletionParameters& params)
-        {
-            int jobId = m_inferenceEngine->submitChatCompletionsJob(params);
+            int jobId = m_scheduler.submitInteractive(engine, params);
+            KOLOSAL_TRACE_INSTANT("JobSubmitted", "inference", jobId);
             if (jobId < 0) {
                 std::cerr << "[ModelManager] Failed to submit chat completions job.\n";
                 return -1;
             }
 
-            std::thread([this, jobId]() {
-                // Poll while job is running or until the engine says it's done
-                while (true)
-                {
-                    if (this->m_inferenceEngine->hasJobError(jobId)) break;
+            if (onSubmitted) {
+                onSubmitted(jobId);
+            }
 
-                    CompletionResult partial = this->m_inferenceEngine->getJobResult(jobId);
+            startJobPolling(jobId, std::move(cacheKey), stopSequences);
+            return jobId;
+        }
 
-                    if (!partial.text.empty()) {
-                        // Call the users callback
-                        std::shared_lock<std::shared_mutex> lock(m_mutex);
-                        if (m_streamingCallback) {
-                            m_streamingCallback(partial.text, jobId);
-                        }
-                    }
+        /**
+         * @brief Submits an interactive chat job whose output is collected by the caller with
+         * isJobFinished and getJobResult instead of being streamed.
+         */
+        int submitChatCompletionJob(const ChatCompletionParameters& params)
+        {
+            IInferenceEngine* engine = getEngine();
+            if (!engine) {
+                std::cerr << "[ModelManager] No inference engine loaded. Cannot submit chat completions job.\n";
+                return -1;
+            }
 
-                    if (this->m_inferenceEngine->isJobFinished(jobId)) break;
+            int jobId = m_scheduler.submitInteractive(engine, params);
+            KOLOSAL_TRACE_INSTANT("JobSubmitted", "inference", jobId);
+            if (jobId < 0) {
+                std::cerr << "[ModelManager] Failed to submit chat completions job.\n";
+            }
+            return jobId;
+        }
 
-                    // Sleep briefly to avoid busy-waiting
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                }
-                }).detach();
+        /**
+         * @brief Queues a low-priority chat job whose output is collected by the caller.
+         *
+         * The job is admitted once no interactive job is in flight; the future then receives
+         * its job id (-1 on failure). Background jobs are not counted as active jobs and never
+         * reach the streaming callback.
+         */
+        std::future<int> submitBackgroundChatCompletionJob(const ChatCompletionParameters& params)
+        {
+            return m_scheduler.submitBackground(params);
+        }
 
-            return jobId;
+        size_t getQueuedBackgroundJobCount() const
+        {
+            return m_scheduler.getQueuedBackgroundCount();
+        }
+
+        // Without a loaded engine no job can exist; callers see a finished job with an error.
+        void waitForJob(int jobId)
+        {
+            if (IInferenceEngine* engine = getEngine())
+            {
+                engine->waitForJob(jobId);
+            }
         }
 
         bool isJobFinished(int jobId)
         {
-            return m_inferenceEngine->isJobFinished(jobId);
+            IInferenceEngine* engine = getEngine();
+            return !engine || engine->isJobFinished(jobId);
         }
 
         CompletionResult getJobResult(int jobId)
         {
-			return m_inferenceEngine->getJobResult(jobId);
+            IInferenceEngine* engine = getEngine();
+			return engine ? engine->getJobResult(jobId) : CompletionResult();
         }
 
         bool hasJobError(int jobId)
         {
-			return m_inferenceEngine->hasJobError(jobId);
+            IInferenceEngine* engine = getEngine();
+			return !engine || engine->hasJobError(jobId);
         }
 
         std::string getJobError(int jobId)
         {
-            return m_inferenceEngine->getJobError(jobId);
+            IInferenceEngine* engine = getEngine();
+            return engine ? engine->getJobError(jobId) : std::string(NO_ENGINE_ERROR);
         }
 
     private:
+        static constexpr const char* NO_ENGINE_ERROR = "No inference engine is loaded";
+
+        // Null until the backend library is loaded, see ensureInferenceEngineLoaded
+        IInferenceEngine* getEngine() const
+        {
+            return m_inferenceEngine.load(std::memory_order_acquire);
+        }
+
         explicit ModelManager(std::unique_ptr<IModelPersistence> persistence)
             : m_persistence(std::move(persistence))
             , m_currentModelName(std::nullopt)
             , m_currentModelIndex(0)
-            , m_inferenceLibHandle(nullptr)
             , m_createInferenceEnginePtr(nullptr)
 			, m_inferenceEngine(nullptr)
+            , m_constructionTime(std::chrono::steady_clock::now())
         {
             loadModelsAsync();
 
-			std::string backendName = "InferenceEngineLib.dll";
-            if (useVulkanBackend())
-            {
-				backendName = "InferenceEngineLibVulkan.dll";
-            }
+            // The engine keeps the KV state of its previous prompt and only re-evaluates from
+            // the first token that differs, so switching between sibling branches is cheap as
+            // long as the shared prefix is resubmitted byte for byte. Background prompts replace
+            // that state too, so they are tracked, but only chat turns are reported.
+            m_scheduler.setAdmissionObserver([this](const ChatCompletionParameters& params, JobPriority priority) {
+                size_t sharedPrefix = m_sessionPrefix.update(params.messages);
+                if (priority == JobPriority::Interactive)
+                {
+                    m_lastSharedPrefixLength.store(sharedPrefix, std::memory_order_relaxed);
+                }
+            });
 
-#ifdef DEBUG
-			std::cout << "[ModelManager] Using backend: " << backendName << std::endl;
-#endif
+            // Backend selection, DLL loading and the model warm-up all run off the calling
+            // thread so the window can draw its first frame while the model comes up.
+            m_warmupFuture = std::async(std::launch::async, [this, generation = ++m_loadGeneration]() {
+                warmUpCurrentModel(generation);
+            });
+        }
 
-            if (!loadInferenceEngineDynamically(backendName.c_str())) {
-                std::cerr << "[ModelManager] Failed to load inference engine for backend: "
-                    << backendName << std::endl;
-                return;
-            }
+        ~ModelManager()
+        {
+            m_backgroundWorkCancelled = true;
 
-            if (!loadModelIntoEngine())
+            if (m_warmupFuture.valid())
             {
-                std::cerr << "[ModelManager] Failed to load model into inference engine.\n";
+                m_warmupFuture.wait();
+            }
+            if (m_integrityScanFuture.valid())
+            {
+                m_integrityScanFuture.wait();
             }
-        }
 
-        ~ModelManager()
-        {
-            if (m_inferenceLibHandle) {
+            // Stop admitting background work before the engine goes away
+            m_scheduler.setEngine(nullptr);
+
 #ifdef _WIN32
+            if (m_inferenceLibHandle) {
                 FreeLibrary(m_inferenceLibHandle);
-#endif
                 m_inferenceLibHandle = nullptr;
                 m_createInferenceEnginePtr = nullptr;
             }
+#endif
         }
 
         void loadModelsAsync() 
@@ -321,7 +654,7 @@ namespace Model
                 }
 
                 std::unique_lock<std::shared_mutex> lock(m_mutex);
-                m_models = std::move(models);
+                m_models.assign(std::make_move_iterator(models.begin()), std::make_move_iterator(models.end()));
                 m_modelNameToIndex.clear();
 
                 for (size_t i = 0; i < m_models.size(); ++i) 
@@ -363,6 +696,9 @@ namespace Model
                     m_currentVariantType.clear();
                     m_currentModelIndex = 0;
                 }
+
+                invalidateCatalogLocked();
+                startIntegrityScanLocked();
             });
         }
 
@@ -381,11 +717,137 @@ namespace Model
                 return;
             }
             
-            // if variant is not downloaded, but file exists, set isDownloaded to true
-            if (std::filesystem::exists(variant.path)) 
+            // A file for a variant that is not downloaded may be a partial download; the
+            // integrity scan decides whether it is complete.
+        }
+
+        /**
+         * @brief Validates every model file on disk off the loading thread and corrects the
+         * download state of variants whose files turn out incomplete or damaged.
+         *
+         * The selected variant is left out: the warm-up validates it itself before loading it,
+         * so the scan never races the engine for that file.
+         */
+        void startIntegrityScanLocked()
+        {
+            const ModelVariant* selected = m_currentModelName.has_value()
+                ? getVariantLocked(m_currentModelIndex, m_currentVariantType) : nullptr;
+
+            std::vector<std::pair<size_t, ModelVariant*>> variants;
+            for (size_t i = 0; i < m_models.size(); ++i)
             {
-                variant.isDownloaded = true;
-                variant.downloadProgress = 100.0;
+                for (ModelVariant* variant : { &m_models[i].fullPrecision, &m_models[i].quantized8Bit, &m_models[i].quantized4Bit })
+                {
+                    std::error_code ec;
+                    if (variant != selected && std::filesystem::exists(variant->path, ec))
+                    {
+                        variants.emplace_back(i, variant);
+                    }
+                }
+            }
+
+            m_integrityScanFuture = std::async(std::launch::async, [this, variants]() {
+                KOLOSAL_TRACE_THREAD_NAME("IntegrityScan");
+                KOLOSAL_TRACE_SCOPE("ModelManager::integrityScan", "download");
+
+                for (const auto& [modelIndex, variant] : variants)
+                {
+                    if (m_backgroundWorkCancelled)
+                        return;
+
+                    std::string path, recordedChecksum;
+                    {
+                        std::shared_lock<std::shared_mutex> lock(m_mutex);
+                        path = variant->path;
+                        recordedChecksum = variant->checksum;
+                    }
+
+                    applyIntegrityResult(modelIndex, variant, validateModelFile(path, recordedChecksum));
+                }
+            });
+        }
+
+        GgufValidationResult validateModelFile(const std::string& path, const std::string& recordedChecksum)
+        {
+            GgufValidationResult result = GgufValidator::validate(path,
+                Config::ModelIntegrity::CHECKSUM_ON_STARTUP, &m_backgroundWorkCancelled);
+            if (result.status == GgufIntegrity::Valid && !recordedChecksum.empty() &&
+                !result.checksum.empty() && result.checksum != recordedChecksum)
+            {
+                result.status = GgufIntegrity::Corrupt;
+                result.message = "checksum differs from the one recorded earlier";
+            }
+            return result;
+        }
+
+        /**
+         * @brief Records a validation result and corrects the variant's download state.
+         *
+         * A corrupt file is deleted only when nothing can have it open: either it is not the
+         * current selection, or the warm-up of the still current load generation validated it
+         * before loading it (loadGeneration, 0 for the integrity scan).
+         */
+        void applyIntegrityResult(size_t modelIndex, ModelVariant* variant, const GgufValidationResult& result,
+            uint64_t loadGeneration = 0)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+            // A download or quantization started since the scan began owns the file now
+            if (!variant->isDownloaded && variant->downloadProgress > 0.0)
+                return;
+
+            // switchModel may have handed the file to the engine since the scan began; the
+            // problem is shown, and the file is checked again before the next load at startup
+            if (result.status != GgufIntegrity::Valid && m_currentModelName.has_value() &&
+                getVariantLocked(m_currentModelIndex, m_currentVariantType) == variant &&
+                loadGeneration != m_loadGeneration.load(std::memory_order_acquire))
+            {
+                std::cerr << "[ModelManager] " << variant->path << ": " << result.message
+                          << "; left in place while the model is selected\n";
+                m_integrityIssues[variant] = result;
+                invalidateCatalogLocked();
+                return;
+            }
+
+            bool changed = false;
+            if (result.status == GgufIntegrity::Valid)
+            {
+                m_integrityIssues.erase(variant);
+                if (!variant->isDownloaded)
+                {
+                    variant->isDownloaded = true;
+                    variant->downloadProgress = 100.0;
+                    changed = true;
+                }
+                if (variant->checksum.empty() && !result.checksum.empty())
+                {
+                    variant->checksum = result.checksum;
+                    changed = true;
+                }
+            }
+            else
+            {
+                const bool corrupt = result.status == GgufIntegrity::Corrupt;
+                std::cerr << "[ModelManager] " << variant->path << ": " << result.message
+                          << (corrupt ? "; it will be downloaded again\n" : "; the download will resume\n");
+                if (corrupt)
+                {
+                    std::error_code ec;
+                    std::filesystem::remove(variant->path, ec);
+                    variant->checksum.clear();
+                }
+                changed = variant->isDownloaded || corrupt;
+                variant->isDownloaded = false;
+                variant->downloadProgress = 0.0;
+                m_integrityIssues[variant] = result;
+            }
+
+            invalidateCatalogLocked();
+            if (changed)
+            {
+                ModelData model = m_models[modelIndex];
+                lock.unlock();
+                m_persistence->saveModelData(model).get();
             }
         }
 
@@ -424,11 +886,21 @@ namespace Model
 
             ModelData* model = &m_models[modelIndex];
 
+            m_integrityIssues.erase(variant);
             m_downloadFutures.emplace_back(m_persistence->downloadModelVariant(*model, *variant));
+            invalidateCatalogLocked();
+        }
+
+        // Download progress and completion are written by the download threads without the
+        // lock; snapshots pick those up through their refresh interval instead
+        void invalidateCatalogLocked()
+        {
+            m_catalogVersion.fetch_add(1, std::memory_order_release);
         }
 
         bool useVulkanBackend() const
         {
+#ifdef _WIN32
             bool useVulkan = false;  // This will store our detection results
 
             // Initialize COM
@@ -453,7 +925,9 @@ namespace Model
                 nullptr                      // Reserved
             );
 
-            if (FAILED(hres))
+            // RPC_E_TOO_LATE: the process already has COM security, set by an earlier caller or
+            // implied by earlier COM use; the WMI proxy below still gets its own blanket
+            if (FAILED(hres) && hres != RPC_E_TOO_LATE)
             {
                 std::cerr << "[Error] Failed to initialize security. HR = 0x"
                     << std::hex << hres << std::endl;
@@ -588,6 +1062,44 @@ namespace Model
             CoUninitialize();
 
             return useVulkan;
+#else
+            // The GPU probe uses WMI; other platforms use the default backend
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Probes the GPU and loads the matching inference backend on first use.
+         *
+         * The WMI probe and LoadLibrary are only paid for once a model is actually needed,
+         * either by the startup warm-up or by the first switchModel call.
+         */
+        bool ensureInferenceEngineLoaded()
+        {
+            std::lock_guard<std::mutex> lock(m_backendMutex);
+            if (m_backendLoadAttempted)
+            {
+                return getEngine() != nullptr;
+            }
+            m_backendLoadAttempted = true;
+
+			std::string backendName = "InferenceEngineLib.dll";
+            if (useVulkanBackend())
+            {
+				backendName = "InferenceEngineLibVulkan.dll";
+            }
+
+#ifdef DEBUG
+			std::cout << "[ModelManager] Using backend: " << backendName << std::endl;
+#endif
+
+            if (!loadInferenceEngineDynamically(backendName.c_str())) {
+                std::cerr << "[ModelManager] Failed to load inference engine for backend: "
+                    << backendName << std::endl;
+                return false;
+            }
+
+            return true;
         }
 
         bool loadInferenceEngineDynamically(const std::string& backendName)
@@ -613,18 +1125,324 @@ namespace Model
 			std::cout << "[ModelManager] Successfully loaded inference engine from: "
 				<< backendName << std::endl;
 
-			m_inferenceEngine = m_createInferenceEnginePtr();
-			if (!m_inferenceEngine) {
+			IInferenceEngine* engine = m_createInferenceEnginePtr();
+			if (!engine) {
 				std::cerr << "[ModelManager] Failed to get InferenceEngine instance from "
 					<< backendName << std::endl;
 				return false;
 			}
+            m_inferenceEngine.store(engine, std::memory_order_release);
+            return true;
+#else
+            std::cerr << "[ModelManager] Loading " << backendName << " is only supported on Windows\n";
+            return false;
 #endif
+        }
+
+        /**
+         * @brief Streams a job's partial results into its token ring until it finishes.
+         *
+         * The polling thread only pushes text deltas into the job's TokenStream; it takes no
+         * lock that the UI or persistence could hold. The UI thread applies the deltas in
+         * drainTokenStreams().
+         *
+         * @param cacheKey If not empty, the final text of a successful job is stored in the
+         * ResponseCache under it.
+         * @param stopSequences Text that could still become one of these is held back; once one
+         * is complete the stream ends right before it.
+         */
+        void startJobPolling(int jobId, std::string cacheKey = {}, const std::vector<std::string>& stopSequences = {})
+        {
+            m_activeJobCount.fetch_add(1, std::memory_order_relaxed);
+
+            auto stream = std::make_shared<TokenStream>(jobId, Config::TokenStream::RING_CAPACITY);
+            {
+                std::lock_guard<std::mutex> lock(m_tokenStreamsMutex);
+                m_tokenStreams.push_back(stream);
+            }
+
+            // A job id only comes from a loaded engine, and the engine is never unloaded
+            IInferenceEngine* engine = getEngine();
+            std::thread([this, engine, jobId, stream, cacheKey = std::move(cacheKey), matcher = StopSequenceMatcher(stopSequences)]() mutable {
+                KOLOSAL_TRACE_THREAD_NAME("JobPoller");
+                KOLOSAL_TRACE_SCOPE_ARG("ModelManager::streamJob", "inference", jobId);
+
+                auto startTime = std::chrono::steady_clock::now();
+                size_t pushedLength = 0; // bytes of the cumulative result already in the ring
+                size_t matchedLength = 0; // bytes of the cumulative result fed to the matcher
+
+                // Poll while job is running or until the engine says it's done
+                bool succeeded = false;
+                while (true)
+                {
+                    if (!engine || engine->hasJobError(jobId)) break;
+
+                    // Checked before fetching the result so the final text is never skipped
+                    const bool finished = engine->isJobFinished(jobId);
+                    CompletionResult partial = engine->getJobResult(jobId);
+
+                    if (!partial.tokens.empty())
+                    {
+                        double seconds = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - startTime).count();
+                        if (seconds > 0.0)
+                        {
+                            m_tokensPerSecond.store(static_cast<float>(partial.tokens.size() / seconds),
+                                std::memory_order_relaxed);
+                        }
+                    }
+
+                    size_t available = finished
+                        ? partial.text.size()
+                        : TokenStream::completeUtf8Length(partial.text, partial.text.size());
+
+                    size_t stopAt = StopSequenceMatcher::NO_MATCH;
+                    if (!matcher.empty() && partial.text.size() > matchedLength)
+                    {
+                        stopAt = matcher.feed(partial.text.data() + matchedLength, partial.text.size() - matchedLength);
+                        matchedLength = partial.text.size();
+                    }
+                    if (finished && !matcher.empty())
+                    {
+                        // A match held back for a longer, earlier-starting one stands at the end
+                        stopAt = matcher.finish();
+                    }
+                    if (stopAt != StopSequenceMatcher::NO_MATCH)
+                    {
+                        available = stopAt;
+                    }
+                    else if (!finished && !matcher.empty())
+                    {
+                        available = std::min(available, matcher.getSafeLength());
+                    }
+
+                    if (available > pushedLength)
+                    {
+                        pushToStream(*stream, partial.text.data() + pushedLength, available - pushedLength);
+                        pushedLength = available;
+                    }
+
+                    if (finished || stopAt != StopSequenceMatcher::NO_MATCH)
+                    {
+                        // The engine cannot cancel a job or lower its token budget, so after a
+                        // stop sequence it decodes on to its own end. The reply is complete from
+                        // here, and the scheduler stops holding background work for it.
+                        if (!finished)
+                        {
+                            m_scheduler.releaseInteractive(jobId);
+                        }
+                        KOLOSAL_TRACE_INSTANT(finished ? "JobFinished" : "JobStopped", "inference", jobId);
+                        succeeded = true;
+                        if (!cacheKey.empty())
+                        {
+                            ResponseCache::getInstance().store(cacheKey, partial.text.substr(0, available));
+                        }
+                        break;
+                    }
+
+                    // Sleep briefly to avoid busy-waiting
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+
+                m_activeJobCount.fetch_sub(1, std::memory_order_relaxed);
+                stream->finish(succeeded);
+                }).detach();
+        }
+
+        // Blocks until all of data is in the ring
+        static void pushToStream(TokenStream& stream, const char* data, size_t size)
+        {
+            size_t pushed = 0;
+            while (pushed < size)
+            {
+                pushed += stream.push(data + pushed, size - pushed);
+                if (pushed < size)
+                {
+                    // Ring full: the UI drains it on its next frame
+                    std::this_thread::sleep_for(std::chrono::milliseconds(Config::TokenStream::FULL_RETRY_MS));
+                }
+            }
+        }
+
+#ifdef KOLOSAL_RESPONSE_CACHE
+        /**
+         * @brief Cache key of a request on the loaded model; empty if there is no loaded model.
+         *
+         * The engine applies the chat template itself, so the key covers the messages the
+         * template is applied to rather than the formatted prompt.
+         */
+        std::string getResponseCacheKey(const ChatCompletionParameters& params,
+            const std::vector<std::string>& stopSequences) const
+        {
+            std::string modelPath;
+            std::string variantType;
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                const ModelVariant* variant = getVariantLocked(m_currentModelIndex, m_currentVariantType);
+                if (!m_currentModelName || !variant || !variant->isDownloaded)
+                {
+                    return {};
+                }
+                modelPath = variant->path;
+                variantType = m_currentVariantType;
+            }
+            return ResponseCache::makeKey(modelPath, variantType, params, stopSequences);
+        }
+
+        // Replays a cached reply through a token ring as if it had been generated in one step
+        void streamCachedResponse(int jobId, std::string text)
+        {
+            m_activeJobCount.fetch_add(1, std::memory_order_relaxed);
+
+            auto stream = std::make_shared<TokenStream>(jobId, Config::TokenStream::RING_CAPACITY);
+            {
+                std::lock_guard<std::mutex> lock(m_tokenStreamsMutex);
+                m_tokenStreams.push_back(stream);
+            }
+
+            // Only a reply larger than the ring has to wait for the UI to drain it
+            std::thread([this, stream, text = std::move(text)]() {
+                pushToStream(*stream, text.data(), text.size());
+                m_activeJobCount.fetch_sub(1, std::memory_order_relaxed);
+                stream->finish(true);
+                }).detach();
+        }
+#endif
+
+        /**
+         * @brief Brings the startup model to a steady state.
+         *
+         * Runs three stages in order: a page-cache prefetch of the weight file at low I/O
+         * priority, the engine load, and a one-token dummy decode so that the first real
+         * request does not pay for page faults or lazy backend initialization. Once switchModel
+         * has moved on to another selection the warm-up stops and publishes nothing.
+         */
+        void warmUpCurrentModel(uint64_t generation)
+        {
+            KOLOSAL_TRACE_THREAD_NAME("ModelWarmup");
+            KOLOSAL_TRACE_SCOPE("ModelManager::warmUpCurrentModel", "model");
+            std::string modelPath, recordedChecksum;
+            size_t modelIndex = 0;
+            ModelVariant* variant = nullptr;
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                variant = getVariantLocked(m_currentModelIndex, m_currentVariantType);
+                if (generation != m_loadGeneration.load(std::memory_order_acquire) ||
+                    !m_currentModelName.has_value() || !variant || !variant->isDownloaded)
+                {
+                    return;
+                }
+                modelIndex = m_currentModelIndex;
+                modelPath = variant->path;
+                recordedChecksum = variant->checksum;
+            }
+
+            // The integrity scan skips the selected variant, so it is checked here, before the
+            // engine opens it; a damaged file is never handed to the engine
+            GgufValidationResult integrity = validateModelFile(modelPath, recordedChecksum);
+            applyIntegrityResult(modelIndex, variant, integrity, generation);
+            if (integrity.status != GgufIntegrity::Valid)
+            {
+                if (setModelReady(generation, false, "The model file failed its integrity check: " + integrity.message))
+                {
+                    std::cerr << "[ModelManager] Not loading " << modelPath << ": " << integrity.message << "\n";
+                }
+                return;
+            }
+
+            auto prefetchStart = std::chrono::steady_clock::now();
+            PrefetchResult prefetch = ModelPrefetcher::prefetch(modelPath);
+
+            auto loadStart = std::chrono::steady_clock::now();
+            if (!loadModelIntoEngine(generation))
+            {
+                if (setModelReady(generation, false, "Failed to load the model"))
+                {
+                    std::cerr << "[ModelManager] Failed to load model into inference engine.\n";
+                }
+                return;
+            }
+
+            auto decodeStart = std::chrono::steady_clock::now();
+            runWarmupDecode();
+
+            auto readyTime = std::chrono::steady_clock::now();
+            auto toMs = [](auto from, auto to) {
+                return std::chrono::duration<double, std::milli>(to - from).count();
+            };
+
+            if (!setModelReady(generation, true, {}, toMs(m_constructionTime, readyTime)))
+            {
+                return;
+            }
+            Profiling::StartupTimeline::getInstance().mark("model_ready");
+
+            std::cout << "[ModelManager] Model ready in " << m_timeToReadyMs.load() << " ms"
+                << " (prefetch " << toMs(prefetchStart, loadStart) << " ms for "
+                << (prefetch.bytes / (1024 * 1024)) << " MiB"
+                << ", load " << toMs(loadStart, decodeStart) << " ms"
+                << ", warm-up decode " << toMs(decodeStart, readyTime) << " ms)" << std::endl;
+        }
+
+        /**
+         * @brief Publishes the outcome of the load started as the given generation.
+         *
+         * Returns false, publishing nothing, when a later switchModel has superseded it, so a
+         * slow load of an earlier selection cannot mark the current one ready. Background work
+         * is only admitted while a model is loaded and warm. timeToReadyMs is kept only with
+         * ready, see getTimeToReadyMs.
+         */
+        bool setModelReady(uint64_t generation, bool ready, std::string error = {}, double timeToReadyMs = 0.0)
+        {
+            std::lock_guard<std::mutex> lock(m_readyMutex);
+            if (generation != m_loadGeneration.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            m_modelReady.store(ready, std::memory_order_release);
+            m_timeToReadyMs.store(ready ? timeToReadyMs : 0.0, std::memory_order_release);
+            m_modelLoadError = std::move(error);
+            m_scheduler.setEngine(ready ? getEngine() : nullptr);
             return true;
         }
 
-        bool loadModelIntoEngine()
+        void runWarmupDecode()
         {
+            KOLOSAL_TRACE_SCOPE("ModelManager::runWarmupDecode", "model");
+            IInferenceEngine* engine = getEngine();
+            if (!engine)
+                return;
+
+            ChatCompletionParameters params;
+            params.messages.push_back({ "user", "Hi" });
+            params.maxNewTokens = 1;
+            params.minLength = 0;
+            params.streaming = false;
+
+            int jobId = engine->submitChatCompletionsJob(params);
+            if (jobId < 0)
+            {
+                std::cerr << "[ModelManager] Failed to submit warm-up job.\n";
+                return;
+            }
+
+            engine->waitForJob(jobId);
+            if (engine->hasJobError(jobId))
+            {
+                std::cerr << "[ModelManager] Warm-up job failed: "
+                    << engine->getJobError(jobId) << std::endl;
+            }
+        }
+
+        // Loads the current selection unless the given load generation is no longer current
+        bool loadModelIntoEngine(uint64_t generation)
+        {
+            KOLOSAL_TRACE_SCOPE("ModelManager::loadModelIntoEngine", "model");
+            if (!ensureInferenceEngineLoaded())
+            {
+                return false;
+            }
+
             std::unique_lock<std::shared_mutex> lock(m_mutex);
 
             // Check if we have a selected model
@@ -664,8 +1482,17 @@ namespace Model
 			// Convert to absolute path
 			modelDir = std::filesystem::absolute(modelDir).string();
 
-			// Load the model into the inference engine
-            if (!m_inferenceEngine->loadModel(modelDir.c_str()))
+            // Loading can take seconds; do not block readers of the manager meanwhile
+            lock.unlock();
+
+			// Load the model into the inference engine, one load at a time
+            std::lock_guard<std::mutex> engineLock(m_backendMutex);
+            if (generation != m_loadGeneration.load(std::memory_order_acquire))
+            {
+                // Selected again while waiting; the newer load brings up the right model
+                return false;
+            }
+            if (!getEngine()->loadModel(modelDir.c_str()))
 			{
 				std::cerr << "[ModelManager] Failed to load model into InferenceEngine: "
 					<< modelDir << std::endl;
@@ -675,26 +1502,62 @@ namespace Model
             std::cout << "[ModelManager] Successfully loaded model into InferenceEngine: "
                 << modelDir << std::endl;
 
+            // A freshly loaded model has nothing evaluated yet
+            m_sessionPrefix.reset();
+
+            // The weights live inside the engine; account for them by file size
+            std::error_code ec;
+            auto weightBytes = std::filesystem::file_size(modelPath, ec);
+            Profiling::MemoryTracker::getInstance().set(
+                Profiling::MemorySubsystem::ModelWeights, ec ? 0 : static_cast<int64_t>(weightBytes));
+
             return true;
         }
 
         mutable std::shared_mutex m_mutex;
         std::unique_ptr<IModelPersistence> m_persistence;
-        std::vector<ModelData> m_models;
+        Profiling::TrackedVector<ModelData, Profiling::MemorySubsystem::ModelCatalog> m_models;
         std::unordered_map<std::string, size_t> m_modelNameToIndex;
         std::optional<std::string> m_currentModelName;
         std::string m_currentVariantType;
         size_t m_currentModelIndex;
         std::vector<std::future<void>> m_downloadFutures;
+        std::unordered_set<const ModelVariant*> m_quantizingVariants;
+        std::atomic<bool> m_backgroundWorkCancelled{ false };
+        std::unordered_map<const ModelVariant*, GgufValidationResult> m_integrityIssues;
+        std::future<void> m_integrityScanFuture;
+        std::atomic<uint64_t> m_catalogVersion{ 1 };
+        mutable std::shared_ptr<const ModelCatalogSnapshot> m_catalogSnapshot;    // accessed with std::atomic_load/store
+
+        static constexpr double MIN_REPORTED_PROGRESS = 0.01;
 
 #ifdef _WIN32
         HMODULE m_inferenceLibHandle = nullptr;
 #endif
 
         CreateInferenceEngineFunc* m_createInferenceEnginePtr = nullptr;
-        IInferenceEngine* m_inferenceEngine = nullptr;
-
-		std::function<void(const std::string&, const int)> m_streamingCallback;
+        std::atomic<IInferenceEngine*> m_inferenceEngine{ nullptr };  // set once by ensureInferenceEngineLoaded
+
+        std::vector<std::shared_ptr<TokenStream>> m_tokenStreams;
+        std::string m_drainBuffer;
+        mutable std::mutex m_tokenStreamsMutex;
+
+        std::mutex m_backendMutex;
+        bool m_backendLoadAttempted = false;
+
+        std::future<void> m_warmupFuture;
+        std::atomic<bool> m_modelReady{ false };
+        std::atomic<uint64_t> m_loadGeneration{ 0 };  // bumped by every selection, see setModelReady
+        mutable std::mutex m_readyMutex;
+        std::string m_modelLoadError;
+        std::atomic<int> m_activeJobCount{ 0 };
+        std::atomic<int> m_nextCachedJobId{ Config::ResponseCache::FIRST_JOB_ID };
+        std::atomic<float> m_tokensPerSecond{ 0.0F };
+        std::atomic<double> m_timeToReadyMs{ 0.0 };
+        SessionPrefixTracker m_sessionPrefix;
+        std::atomic<size_t> m_lastSharedPrefixLength{ 0 };
+        InferenceScheduler m_scheduler;
+        std::chrono::steady_clock::time_point m_constructionTime;
     };
 
     inline void initializeModelManager()
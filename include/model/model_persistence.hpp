@@ -1,12 +1,17 @@
 #pragma once
 
 #include "model.hpp"
+#include "gguf_validator.hpp"
+#include "profiling/trace.hpp"
+#include "profiling/memory_tracker.hpp"
 
 #include <string>
 #include <fstream>
 #include <filesystem>
 #include <vector>
 #include <future>
+#include <atomic>
+#include <iostream>
 #include <curl/curl.h>
 
 namespace Model
@@ -18,6 +23,9 @@ namespace Model
         virtual std::future<std::vector<ModelData>> loadAllModels() = 0;
         virtual std::future<void> downloadModelVariant(ModelData& modelData, ModelVariant& variant) = 0;
         virtual std::future<void> saveModelData(const ModelData& modelData) = 0;
+
+        // Bytes received by downloads so far; lets the UI derive throughput without locking.
+        virtual uint64_t getDownloadedBytes() const { return 0; }
     };
 
     class FileModelPersistence : public IModelPersistence
@@ -61,13 +69,25 @@ namespace Model
         std::future<void> downloadModelVariant(ModelData& modelData, ModelVariant& variant) override
         {
             return std::async(std::launch::async, [&variant, &modelData, this]() {
+                KOLOSAL_TRACE_THREAD_NAME("Download");
+                KOLOSAL_TRACE_SCOPE("FileModelPersistence::downloadModelVariant", "download");
+
+                // curl's receive buffer plus the file stream buffer
+                Profiling::ScopedMemoryCharge bufferCharge(Profiling::MemorySubsystem::DownloadBuffers,
+                    CURL_MAX_WRITE_SIZE + BUFSIZ);
                 CURL *curl = curl_easy_init();
                 if (curl)
                 {
 					// Make sure the variant path folder exists
 					std::filesystem::create_directories(std::filesystem::path(variant.path).parent_path());
 
-                    std::ofstream file(variant.path,  std::ios::binary);
+                    // A file left by an interrupted download is continued rather than started over
+                    std::error_code ec;
+                    const uint64_t existingBytes = std::filesystem::exists(variant.path, ec)
+                        ? std::filesystem::file_size(variant.path, ec) : 0;
+                    DownloadProgress progress{ &variant, ec ? 0 : static_cast<curl_off_t>(existingBytes) };
+
+                    std::ofstream file(variant.path, std::ios::binary | (progress.resumedBytes > 0 ? std::ios::app : std::ios::trunc));
                     if (!file.is_open())
                     {
                         curl_easy_cleanup(curl);
@@ -78,26 +98,53 @@ namespace Model
                     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
                     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &file);
                     curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, progress_callback);
-                    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &variant);
+                    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &progress);
                     curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
                     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+                    // Error pages must not end up in the model file
+                    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+                    curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, progress.resumedBytes);
 
                     CURLcode res = curl_easy_perform(curl);
-                    if (res != CURLE_OK)
+                    if (progress.resumedBytes > 0 && (res == CURLE_RANGE_ERROR || res == CURLE_HTTP_RETURNED_ERROR))
                     {
-                        // Handle error
+                        // The server cannot continue from here; start over
+                        std::cerr << "[FileModelPersistence] Cannot resume " << variant.path << ", downloading from the start\n";
+                        file.close();
+                        file.open(variant.path, std::ios::binary | std::ios::trunc);
+                        progress.resumedBytes = 0;
+                        curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(0));
+                        res = file.is_open() ? curl_easy_perform(curl) : CURLE_WRITE_ERROR;
                     }
-                    else
+                    curl_easy_cleanup(curl);
+                    file.close();
+
+                    if (res != CURLE_OK)
                     {
-                        variant.isDownloaded = true;
-                        variant.downloadProgress = 100.0;
+                        // The partial file stays for the next attempt to resume
+                        std::cerr << "[FileModelPersistence] Download of " << variant.path << " failed: " << curl_easy_strerror(res) << "\n";
+                        variant.downloadProgress = 0.0;
+                        return;
+                    }
 
-                        // Save the model data
-                        saveModelData(modelData).get();
+                    GgufValidationResult validation = GgufValidator::validate(variant.path);
+                    if (validation.status != GgufIntegrity::Valid)
+                    {
+                        std::cerr << "[FileModelPersistence] Downloaded " << variant.path << " is not a valid model: "
+                                  << validation.message << "\n";
+                        if (validation.status == GgufIntegrity::Corrupt)
+                        {
+                            std::filesystem::remove(variant.path, ec);
+                        }
+                        variant.downloadProgress = 0.0;
+                        return;
                     }
 
-                    curl_easy_cleanup(curl);
-                    file.close();
+                    variant.isDownloaded = true;
+                    variant.downloadProgress = 100.0;
+
+                    // Save the model data
+                    saveModelData(modelData).get();
                 }
             });
         }
@@ -105,6 +152,7 @@ namespace Model
         std::future<void> saveModelData(const ModelData& modelData) override
         {
             return std::async(std::launch::async, [this, modelData]() {
+                KOLOSAL_TRACE_SCOPE("FileModelPersistence::saveModelData", "persistence");
                 std::string modelDataFilename = modelData.name;
                 std::replace(modelDataFilename.begin(), modelDataFilename.end(), ' ', '-');
                 std::transform(modelDataFilename.begin(), modelDataFilename.end(), modelDataFilename.begin(), ::tolower);
@@ -127,20 +175,37 @@ namespace Model
                 stream->write(static_cast<const char*>(ptr), size * nmemb);
                 written = size * nmemb;
             }
+            s_downloadedBytes.fetch_add(written, std::memory_order_relaxed);
             return written;
         }
 
+        uint64_t getDownloadedBytes() const override
+        {
+            return s_downloadedBytes.load(std::memory_order_relaxed);
+        }
+
+        // curl reports the current transfer only; a resumed download adds what was already on disk
+        struct DownloadProgress
+        {
+            ModelVariant* variant;
+            curl_off_t resumedBytes;
+        };
+
         static int progress_callback(void* ptr, curl_off_t total, curl_off_t now, curl_off_t, curl_off_t)
         {
-            ModelVariant* variant = static_cast<ModelVariant*>(ptr);
+            DownloadProgress* progress = static_cast<DownloadProgress*>(ptr);
             if (total > 0)
             {
-                variant->downloadProgress = static_cast<double>(now) / static_cast<double>(total) * 100.0;
+                progress->variant->downloadProgress = static_cast<double>(now + progress->resumedBytes) /
+                    static_cast<double>(total + progress->resumedBytes) * 100.0;
             }
             return 0;
         }
 
     private:
         std::string m_basePath;
+
+        // Shared by all downloads since write_data only receives the output stream
+        static inline std::atomic<uint64_t> s_downloadedBytes{ 0 };
     };
 } // namespace Model
\ No newline at end of file
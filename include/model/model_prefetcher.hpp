@@ -0,0 +1,213 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+#include "profiling/trace.hpp"
+#include "profiling/memory_tracker.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Model
+{
+    struct PrefetchResult
+    {
+        bool success = false;
+        uint64_t bytes = 0;
+        double milliseconds = 0.0;
+    };
+
+    /**
+     * @brief Pulls a model weight file into the OS page cache ahead of the first inference.
+     *
+     * The file is memory-mapped and walked in large sequential chunks. Each chunk is first
+     * hinted to the kernel (PrefetchVirtualMemory / madvise(WILLNEED) + readahead) and then
+     * touched page by page, so the reads are issued while the calling thread runs at a low
+     * I/O priority and never compete with the UI thread for the disk.
+     */
+    class ModelPrefetcher
+    {
+    public:
+        static constexpr size_t CHUNK_SIZE = 64ULL * 1024ULL * 1024ULL;
+        static constexpr size_t PAGE_SIZE = 4096;
+
+        static PrefetchResult prefetch(const std::string& path, size_t chunkSize = CHUNK_SIZE)
+        {
+            KOLOSAL_TRACE_SCOPE("ModelPrefetcher::prefetch", "model");
+            PrefetchResult result;
+            auto start = std::chrono::steady_clock::now();
+
+            ScopedLowIoPriority lowPriority;
+
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                std::cerr << "[ModelPrefetcher] Failed to open: " << path << std::endl;
+                return result;
+            }
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+            {
+                CloseHandle(file);
+                return result;
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping)
+            {
+                CloseHandle(file);
+                return result;
+            }
+
+            const uint8_t* data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!data)
+            {
+                CloseHandle(mapping);
+                CloseHandle(file);
+                return result;
+            }
+
+            const uint64_t size = static_cast<uint64_t>(fileSize.QuadPart);
+            Profiling::ScopedMemoryCharge mappingCharge(Profiling::MemorySubsystem::ModelMappings,
+                static_cast<int64_t>(size));
+            for (uint64_t offset = 0; offset < size; offset += chunkSize)
+            {
+                size_t length = static_cast<size_t>(std::min<uint64_t>(chunkSize, size - offset));
+
+                WIN32_MEMORY_RANGE_ENTRY range;
+                range.VirtualAddress = const_cast<uint8_t*>(data + offset);
+                range.NumberOfBytes = length;
+                PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+
+                touchPages(data + offset, length);
+            }
+
+            UnmapViewOfFile(data);
+            CloseHandle(mapping);
+            CloseHandle(file);
+#else
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                std::cerr << "[ModelPrefetcher] Failed to open: " << path << std::endl;
+                return result;
+            }
+
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size == 0)
+            {
+                close(fd);
+                return result;
+            }
+
+            const uint64_t size = static_cast<uint64_t>(st.st_size);
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED)
+            {
+                close(fd);
+                return result;
+            }
+
+            const uint8_t* data = static_cast<const uint8_t*>(mapped);
+            Profiling::ScopedMemoryCharge mappingCharge(Profiling::MemorySubsystem::ModelMappings,
+                static_cast<int64_t>(size));
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            for (uint64_t offset = 0; offset < size; offset += chunkSize)
+            {
+                size_t length = static_cast<size_t>(std::min<uint64_t>(chunkSize, size - offset));
+#ifdef __linux__
+                readahead(fd, static_cast<off_t>(offset), length);
+#endif
+                madvise(const_cast<uint8_t*>(data + offset), length, MADV_WILLNEED);
+
+                touchPages(data + offset, length);
+            }
+
+            munmap(mapped, size);
+            close(fd);
+#endif
+
+            result.success = true;
+            result.bytes = size;
+            result.milliseconds = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+
+    private:
+        // Reads one byte per page so the chunk is resident before we move on.
+        static void touchPages(const uint8_t* data, size_t length)
+        {
+            volatile uint8_t sink = 0;
+            for (size_t i = 0; i < length; i += PAGE_SIZE)
+            {
+                sink ^= data[i];
+            }
+            (void)sink;
+        }
+
+        /**
+         * @brief Lowers the I/O priority of the calling thread for its lifetime.
+         */
+        class ScopedLowIoPriority
+        {
+        public:
+            ScopedLowIoPriority()
+            {
+#ifdef _WIN32
+                m_applied = SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN) != 0;
+#elif defined(__linux__) && defined(SYS_ioprio_set)
+                m_previous = static_cast<int>(syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, 0));
+                m_applied = syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_IDLE) == 0;
+#endif
+            }
+
+            ~ScopedLowIoPriority()
+            {
+                if (!m_applied)
+                    return;
+#ifdef _WIN32
+                SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+#elif defined(__linux__) && defined(SYS_ioprio_set)
+                if (m_previous >= 0)
+                {
+                    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, m_previous);
+                }
+#endif
+            }
+
+            ScopedLowIoPriority(const ScopedLowIoPriority&) = delete;
+            ScopedLowIoPriority& operator=(const ScopedLowIoPriority&) = delete;
+
+        private:
+#if defined(__linux__)
+            // Values from linux/ioprio.h; who = 0 targets the calling thread.
+            static constexpr int IOPRIO_WHO_PROCESS = 1;
+            static constexpr int IOPRIO_IDLE = 3 << 13;
+            int m_previous = -1;
+#endif
+            bool m_applied = false;
+        };
+    };
+
+} // namespace Model
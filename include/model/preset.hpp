@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <json.hpp>
 
 using json = nlohmann::json;
@@ -29,6 +30,12 @@ namespace Model
         // TODO: Use int instead of float
         float max_new_tokens;
 
+        // Generation ends before the first of these that the reply produces
+        std::vector<std::string> stop_sequences;
+
+        // Replace old turns of long chats with a summary written in the background
+        bool summarize_history;
+
         ModelPreset(
             int id = 0,
             int lastModified = 0,
@@ -39,7 +46,9 @@ namespace Model
             float top_k = 50.0f,
             int random_seed = 42,
             float min_length = 0.0f,
-            float max_new_tokens = 2048.0f)
+            float max_new_tokens = 2048.0f,
+            const std::vector<std::string>& stop_sequences = {},
+            bool summarize_history = false)
             : id(id)
             , lastModified(lastModified)
             , name(name)
@@ -49,7 +58,9 @@ namespace Model
             , top_k(top_k)
             , random_seed(random_seed)
             , min_length(min_length)
-            , max_new_tokens(max_new_tokens) {}
+            , max_new_tokens(max_new_tokens)
+            , stop_sequences(stop_sequences)
+            , summarize_history(summarize_history) {}
 
         bool operator==(const ModelPreset& other) const
         {
@@ -61,7 +72,9 @@ namespace Model
                 top_k == other.top_k &&
                 random_seed == other.random_seed &&
                 min_length == other.min_length &&
-                max_new_tokens == other.max_new_tokens;
+                max_new_tokens == other.max_new_tokens &&
+                stop_sequences == other.stop_sequences &&
+                summarize_history == other.summarize_history;
         }
 
         bool operator!=(const ModelPreset& other) const
@@ -82,7 +95,9 @@ namespace Model
             {"top_k", p.top_k},
             {"random_seed", p.random_seed},
             {"min_length", p.min_length},
-            {"max_new_tokens", p.max_new_tokens} };
+            {"max_new_tokens", p.max_new_tokens},
+            {"stop_sequences", p.stop_sequences},
+            {"summarize_history", p.summarize_history} };
     }
 
     inline void from_json(const json& j, ModelPreset& p)
@@ -97,5 +112,7 @@ namespace Model
         j.at("random_seed").get_to(p.random_seed);
         j.at("min_length").get_to(p.min_length);
         j.at("max_new_tokens").get_to(p.max_new_tokens);
+        p.stop_sequences = j.value("stop_sequences", std::vector<std::string>{});
+        p.summarize_history = j.value("summarize_history", false);
     }
 } // namespace Model
\ No newline at end of file
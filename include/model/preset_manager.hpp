@@ -3,6 +3,7 @@
 #pragma once
 
 #include "preset_persistence.hpp"
+#include "profiling/memory_tracker.hpp"
 
 #include <vector>
 #include <string>
@@ -200,7 +201,7 @@ namespace Model
                 {
                     auto presets = m_persistence->loadAllPresets().get();
                     std::unique_lock<std::shared_mutex> lock(m_mutex);
-                    m_presets = std::move(presets);
+                    m_presets.assign(std::make_move_iterator(presets.begin()), std::make_move_iterator(presets.end()));
                     m_originalPresets = m_presets;
 
                     m_presetNameToIndex.clear();
@@ -454,8 +455,8 @@ namespace Model
         // Member variables
         mutable std::shared_mutex m_mutex;
         std::unique_ptr<IPresetPersistence> m_persistence;
-        std::vector<ModelPreset> m_presets;
-        std::vector<ModelPreset> m_originalPresets;
+        Profiling::TrackedVector<ModelPreset, Profiling::MemorySubsystem::Presets> m_presets;
+        Profiling::TrackedVector<ModelPreset, Profiling::MemorySubsystem::Presets> m_originalPresets;
         std::unordered_map<std::string, size_t> m_presetNameToIndex;
         std::set<PresetIndex> m_sortedIndices;
         std::optional<std::string> m_currentPresetName;
@@ -0,0 +1,812 @@
+#pragma once
+
+#include "gguf.hpp"
+#include "config.hpp"
+#include "profiling/trace.hpp"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <filesystem>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Model
+{
+    /**
+     * @brief Block quantization kernels producing the ggml Q8_0 and Q4_K layouts.
+     *
+     * The AVX2 paths are taken when the compiler targets AVX2; the scalar paths are the ggml
+     * reference algorithms and give the same results up to float summation order.
+     */
+    namespace Quantization
+    {
+        constexpr int Q8_0_BLOCK_SIZE = 32;
+        constexpr int Q8_0_BLOCK_BYTES = 2 + Q8_0_BLOCK_SIZE;
+        constexpr int Q4_K_BLOCK_SIZE = 256;
+        constexpr int Q4_K_BLOCK_BYTES = 2 + 2 + 12 + Q4_K_BLOCK_SIZE / 2;
+
+        inline uint32_t floatToBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline float bitsToFloat(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        inline float fp16ToFloat(uint16_t half)
+        {
+            const uint32_t w = static_cast<uint32_t>(half) << 16;
+            const uint32_t sign = w & 0x80000000u;
+            const uint32_t twoW = w + w;
+
+            const float normalized = bitsToFloat((twoW >> 4) + (0xE0u << 23)) * 0x1.0p-112f;
+            const float denormalized = bitsToFloat((twoW >> 17) | (126u << 23)) - 0.5f;
+
+            return bitsToFloat(sign | (twoW < (1u << 27) ? floatToBits(denormalized) : floatToBits(normalized)));
+        }
+
+        // Round to nearest even, saturating to infinity, as ggml does
+        inline uint16_t floatToFp16(float value)
+        {
+            float base = (std::fabs(value) * 0x1.0p+112f) * 0x1.0p-110f;
+
+            const uint32_t w = floatToBits(value);
+            const uint32_t shl1W = w + w;
+            const uint32_t sign = w & 0x80000000u;
+            uint32_t bias = shl1W & 0xFF000000u;
+            if (bias < 0x71000000u)
+                bias = 0x71000000u;
+
+            base = bitsToFloat((bias >> 1) + 0x07800000u) + base;
+            const uint32_t bits = floatToBits(base);
+            const uint32_t exponentBits = (bits >> 13) & 0x00007C00u;
+            const uint32_t mantissaBits = bits & 0x00000FFFu;
+            return static_cast<uint16_t>((sign >> 16) | (shl1W > 0xFF000000u ? 0x7E00u : exponentBits + mantissaBits));
+        }
+
+        inline float bf16ToFloat(uint16_t value)
+        {
+            return bitsToFloat(static_cast<uint32_t>(value) << 16);
+        }
+
+        // Round to nearest even for |value| < 2^22
+        inline int nearestInt(float value)
+        {
+            const float shifted = value + 12582912.0f;
+            int bits;
+            std::memcpy(&bits, &shifted, sizeof(bits));
+            return (bits & 0x007FFFFF) - 0x00400000;
+        }
+
+        /**
+         * @brief Converts a row of F32, F16 or BF16 values to floats. Returns false for any other type.
+         */
+        inline bool convertRowToFloat(uint32_t type, const uint8_t* source, float* destination, int64_t count)
+        {
+            switch (static_cast<GgmlType>(type))
+            {
+            case GgmlType::F32:
+                std::memcpy(destination, source, count * sizeof(float));
+                return true;
+            case GgmlType::F16:
+                for (int64_t i = 0; i < count; ++i)
+                {
+                    uint16_t half;
+                    std::memcpy(&half, source + i * 2, sizeof(half));
+                    destination[i] = fp16ToFloat(half);
+                }
+                return true;
+            case GgmlType::BF16:
+                for (int64_t i = 0; i < count; ++i)
+                {
+                    uint16_t value;
+                    std::memcpy(&value, source + i * 2, sizeof(value));
+                    destination[i] = bf16ToFloat(value);
+                }
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        /**
+         * @brief Q8_0: blocks of 32 values stored as an fp16 scale and 32 signed bytes.
+         * count must be a multiple of 32.
+         */
+        inline void quantizeRowQ8_0(const float* x, uint8_t* out, int64_t count)
+        {
+            for (int64_t block = 0; block < count / Q8_0_BLOCK_SIZE; ++block)
+            {
+                const float* values = x + block * Q8_0_BLOCK_SIZE;
+                uint8_t* blockOut = out + block * Q8_0_BLOCK_BYTES;
+                int8_t* quants = reinterpret_cast<int8_t*>(blockOut + 2);
+
+#if defined(__AVX2__)
+                const __m256 signBit = _mm256_set1_ps(-0.0f);
+                __m256 v0 = _mm256_loadu_ps(values);
+                __m256 v1 = _mm256_loadu_ps(values + 8);
+                __m256 v2 = _mm256_loadu_ps(values + 16);
+                __m256 v3 = _mm256_loadu_ps(values + 24);
+
+                __m256 maxAbs = _mm256_andnot_ps(signBit, v0);
+                maxAbs = _mm256_max_ps(maxAbs, _mm256_andnot_ps(signBit, v1));
+                maxAbs = _mm256_max_ps(maxAbs, _mm256_andnot_ps(signBit, v2));
+                maxAbs = _mm256_max_ps(maxAbs, _mm256_andnot_ps(signBit, v3));
+                __m128 max4 = _mm_max_ps(_mm256_extractf128_ps(maxAbs, 1), _mm256_castps256_ps128(maxAbs));
+                max4 = _mm_max_ps(max4, _mm_movehl_ps(max4, max4));
+                max4 = _mm_max_ss(max4, _mm_movehdup_ps(max4));
+                const float amax = _mm_cvtss_f32(max4);
+
+                const float d = amax / 127.0f;
+                const uint16_t dHalf = floatToFp16(d);
+                std::memcpy(blockOut, &dHalf, sizeof(dHalf));
+
+                const __m256 inverse = _mm256_set1_ps(amax != 0.0f ? 127.0f / amax : 0.0f);
+                // cvtps rounds to nearest even under the default MXCSR mode, matching nearestInt
+                __m256i i0 = _mm256_cvtps_epi32(_mm256_mul_ps(v0, inverse));
+                __m256i i1 = _mm256_cvtps_epi32(_mm256_mul_ps(v1, inverse));
+                __m256i i2 = _mm256_cvtps_epi32(_mm256_mul_ps(v2, inverse));
+                __m256i i3 = _mm256_cvtps_epi32(_mm256_mul_ps(v3, inverse));
+
+                // Pack to bytes; the packs interleave 128-bit lanes, so restore the order after
+                i0 = _mm256_packs_epi32(i0, i1);
+                i2 = _mm256_packs_epi32(i2, i3);
+                i0 = _mm256_packs_epi16(i0, i2);
+                i0 = _mm256_permutevar8x32_epi32(i0, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(quants), i0);
+#else
+                float amax = 0.0f;
+                for (int l = 0; l < Q8_0_BLOCK_SIZE; ++l)
+                    amax = std::max(amax, std::fabs(values[l]));
+
+                const float d = amax / 127.0f;
+                const float inverse = amax != 0.0f ? 127.0f / amax : 0.0f;
+                const uint16_t dHalf = floatToFp16(d);
+                std::memcpy(blockOut, &dHalf, sizeof(dHalf));
+
+                for (int l = 0; l < Q8_0_BLOCK_SIZE; ++l)
+                    quants[l] = static_cast<int8_t>(nearestInt(values[l] * inverse));
+#endif
+            }
+        }
+
+        inline void dequantizeRowQ8_0(const uint8_t* in, float* y, int64_t count)
+        {
+            for (int64_t block = 0; block < count / Q8_0_BLOCK_SIZE; ++block)
+            {
+                const uint8_t* blockIn = in + block * Q8_0_BLOCK_BYTES;
+                uint16_t dHalf;
+                std::memcpy(&dHalf, blockIn, sizeof(dHalf));
+                const float d = fp16ToFloat(dHalf);
+                const int8_t* quants = reinterpret_cast<const int8_t*>(blockIn + 2);
+                for (int l = 0; l < Q8_0_BLOCK_SIZE; ++l)
+                    y[block * Q8_0_BLOCK_SIZE + l] = quants[l] * d;
+            }
+        }
+
+        /**
+         * @brief Quantizes 32 values to [0, nmax] at the given scale and offset, returning the
+         * weighted sums the least-squares fit needs.
+         */
+        inline void quantizeSubBlock(const float* x, const float* weights, float iscale, float min, int nmax,
+            uint8_t* levels, float& sumL, float& sumL2, float& sumXL)
+        {
+#if defined(__AVX2__)
+            const __m256 scaleVec = _mm256_set1_ps(iscale);
+            const __m256 minVec = _mm256_set1_ps(min);
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i maxLevel = _mm256_set1_epi32(nmax);
+            __m256 accL = _mm256_setzero_ps();
+            __m256 accL2 = _mm256_setzero_ps();
+            __m256 accXL = _mm256_setzero_ps();
+            alignas(32) int32_t lanes[8];
+
+            for (int i = 0; i < 32; i += 8)
+            {
+                const __m256 values = _mm256_loadu_ps(x + i);
+                const __m256 w = _mm256_loadu_ps(weights + i);
+                __m256i level = _mm256_cvtps_epi32(_mm256_mul_ps(scaleVec, _mm256_sub_ps(values, minVec)));
+                level = _mm256_min_epi32(_mm256_max_epi32(level, zero), maxLevel);
+
+                const __m256 levelF = _mm256_cvtepi32_ps(level);
+                const __m256 wl = _mm256_mul_ps(w, levelF);
+                accL = _mm256_add_ps(accL, wl);
+                accL2 = _mm256_add_ps(accL2, _mm256_mul_ps(wl, levelF));
+                accXL = _mm256_add_ps(accXL, _mm256_mul_ps(wl, values));
+
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), level);
+                for (int l = 0; l < 8; ++l)
+                    levels[i + l] = static_cast<uint8_t>(lanes[l]);
+            }
+
+            auto horizontalSum = [](__m256 v)
+                {
+                    __m128 sum = _mm_add_ps(_mm256_extractf128_ps(v, 1), _mm256_castps256_ps128(v));
+                    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+                    return _mm_cvtss_f32(sum);
+                };
+            sumL = horizontalSum(accL);
+            sumL2 = horizontalSum(accL2);
+            sumXL = horizontalSum(accXL);
+#else
+            sumL = sumL2 = sumXL = 0.0f;
+            for (int i = 0; i < 32; ++i)
+            {
+                const int level = std::max(0, std::min(nmax, nearestInt(iscale * (x[i] - min))));
+                levels[i] = static_cast<uint8_t>(level);
+                const float wl = weights[i] * level;
+                sumL += wl;
+                sumL2 += wl * level;
+                sumXL += wl * x[i];
+            }
+#endif
+        }
+
+        /**
+         * @brief Fits scale and min for 32 values quantized to [0, nmax], searching a few scales
+         * around the range-based one for the lowest weighted squared error (ggml make_qkx2_quants).
+         * Returns the scale and stores the negated min.
+         */
+        inline float fitScaleAndMin(const float* x, const float* weights, int nmax, uint8_t* levels, float& negatedMin)
+        {
+            constexpr int n = 32;
+            constexpr float rmin = -1.0f;
+            constexpr float rdelta = 0.1f;
+            constexpr int nstep = 20;
+
+            float min = x[0];
+            float max = x[0];
+            float sumW = weights[0];
+            float sumX = sumW * x[0];
+            for (int i = 1; i < n; ++i)
+            {
+                min = std::min(min, x[i]);
+                max = std::max(max, x[i]);
+                sumW += weights[i];
+                sumX += weights[i] * x[i];
+            }
+            if (min > 0.0f)
+                min = 0.0f;
+            if (max == min)
+            {
+                std::fill(levels, levels + n, 0);
+                negatedMin = -min;
+                return 0.0f;
+            }
+
+            float iscale = nmax / (max - min);
+            float scale = 1.0f / iscale;
+            float bestError = 0.0f;
+            for (int i = 0; i < n; ++i)
+            {
+                const int level = std::max(0, std::min(nmax, nearestInt(iscale * (x[i] - min))));
+                levels[i] = static_cast<uint8_t>(level);
+                const float diff = scale * level + min - x[i];
+                bestError += weights[i] * diff * diff;
+            }
+
+            uint8_t candidate[n];
+            for (int step = 0; step <= nstep; ++step)
+            {
+                iscale = (rmin + rdelta * step + nmax) / (max - min);
+                float sumL, sumL2, sumXL;
+                quantizeSubBlock(x, weights, iscale, min, nmax, candidate, sumL, sumL2, sumXL);
+
+                const float determinant = sumW * sumL2 - sumL * sumL;
+                if (determinant <= 0.0f)
+                    continue;
+
+                float candidateScale = (sumW * sumXL - sumX * sumL) / determinant;
+                float candidateMin = (sumL2 * sumX - sumL * sumXL) / determinant;
+                if (candidateMin > 0.0f)
+                {
+                    candidateMin = 0.0f;
+                    candidateScale = sumXL / sumL2;
+                }
+
+                float error = 0.0f;
+                for (int i = 0; i < n; ++i)
+                {
+                    const float diff = candidateScale * candidate[i] + candidateMin - x[i];
+                    error += weights[i] * diff * diff;
+                }
+                if (error < bestError)
+                {
+                    std::memcpy(levels, candidate, n);
+                    bestError = error;
+                    scale = candidateScale;
+                    min = candidateMin;
+                }
+            }
+
+            negatedMin = -min;
+            return scale;
+        }
+
+        inline void getScaleMinK4(int j, const uint8_t* scales, uint8_t& scale, uint8_t& min)
+        {
+            if (j < 4)
+            {
+                scale = scales[j] & 63;
+                min = scales[j + 4] & 63;
+            }
+            else
+            {
+                scale = (scales[j + 4] & 0xF) | ((scales[j - 4] >> 6) << 4);
+                min = (scales[j + 4] >> 4) | ((scales[j] >> 6) << 4);
+            }
+        }
+
+        /**
+         * @brief Q4_K: super-blocks of 256 values in eight sub-blocks of 32, each with a 6-bit
+         * scale and min relative to the fp16 super-block scale and min. count must be a multiple
+         * of 256.
+         */
+        inline void quantizeRowQ4_K(const float* x, uint8_t* out, int64_t count)
+        {
+            uint8_t levels[Q4_K_BLOCK_SIZE];
+            float weights[32];
+            float scales[Q4_K_BLOCK_SIZE / 32];
+            float mins[Q4_K_BLOCK_SIZE / 32];
+
+            for (int64_t block = 0; block < count / Q4_K_BLOCK_SIZE; ++block)
+            {
+                const float* values = x + block * Q4_K_BLOCK_SIZE;
+                uint8_t* blockOut = out + block * Q4_K_BLOCK_BYTES;
+                uint8_t* packedScales = blockOut + 4;
+                uint8_t* quants = blockOut + 16;
+
+                float maxScale = 0.0f;
+                float maxMin = 0.0f;
+                for (int j = 0; j < Q4_K_BLOCK_SIZE / 32; ++j)
+                {
+                    const float* sub = values + 32 * j;
+                    float sumX2 = 0.0f;
+                    for (int l = 0; l < 32; ++l)
+                        sumX2 += sub[l] * sub[l];
+                    const float averageMagnitude = std::sqrt(sumX2 / 32);
+                    for (int l = 0; l < 32; ++l)
+                        weights[l] = averageMagnitude + std::fabs(sub[l]);
+
+                    scales[j] = fitScaleAndMin(sub, weights, 15, levels + 32 * j, mins[j]);
+                    maxScale = std::max(maxScale, scales[j]);
+                    maxMin = std::max(maxMin, mins[j]);
+                }
+
+                const float inverseScale = maxScale > 0.0f ? 63.0f / maxScale : 0.0f;
+                const float inverseMin = maxMin > 0.0f ? 63.0f / maxMin : 0.0f;
+                std::memset(packedScales, 0, 12);
+                for (int j = 0; j < Q4_K_BLOCK_SIZE / 32; ++j)
+                {
+                    const uint8_t ls = static_cast<uint8_t>(std::min(63, nearestInt(inverseScale * scales[j])));
+                    const uint8_t lm = static_cast<uint8_t>(std::min(63, nearestInt(inverseMin * mins[j])));
+                    if (j < 4)
+                    {
+                        packedScales[j] = ls;
+                        packedScales[j + 4] = lm;
+                    }
+                    else
+                    {
+                        packedScales[j + 4] = (ls & 0xF) | ((lm & 0xF) << 4);
+                        packedScales[j - 4] |= ((ls >> 4) << 6);
+                        packedScales[j] |= ((lm >> 4) << 6);
+                    }
+                }
+
+                const uint16_t dHalf = floatToFp16(maxScale / 63.0f);
+                const uint16_t dminHalf = floatToFp16(maxMin / 63.0f);
+                std::memcpy(blockOut, &dHalf, sizeof(dHalf));
+                std::memcpy(blockOut + 2, &dminHalf, sizeof(dminHalf));
+
+                // Requantize against the scales as stored, so rounding of the 6-bit scales is absorbed
+                const float superScale = fp16ToFloat(dHalf);
+                const float superMin = fp16ToFloat(dminHalf);
+                for (int j = 0; j < Q4_K_BLOCK_SIZE / 32; ++j)
+                {
+                    uint8_t scale, min;
+                    getScaleMinK4(j, packedScales, scale, min);
+                    const float d = superScale * scale;
+                    if (d == 0.0f)
+                        continue;
+                    const float dm = superMin * min;
+                    for (int l = 0; l < 32; ++l)
+                    {
+                        const int level = nearestInt((values[32 * j + l] + dm) / d);
+                        levels[32 * j + l] = static_cast<uint8_t>(std::max(0, std::min(15, level)));
+                    }
+                }
+
+                for (int j = 0; j < Q4_K_BLOCK_SIZE; j += 64)
+                {
+                    for (int l = 0; l < 32; ++l)
+                        quants[j / 2 + l] = levels[j + l] | (levels[j + l + 32] << 4);
+                }
+            }
+        }
+
+        inline void dequantizeRowQ4_K(const uint8_t* in, float* y, int64_t count)
+        {
+            for (int64_t block = 0; block < count / Q4_K_BLOCK_SIZE; ++block)
+            {
+                const uint8_t* blockIn = in + block * Q4_K_BLOCK_BYTES;
+                uint16_t dHalf, dminHalf;
+                std::memcpy(&dHalf, blockIn, sizeof(dHalf));
+                std::memcpy(&dminHalf, blockIn + 2, sizeof(dminHalf));
+                const float d = fp16ToFloat(dHalf);
+                const float dmin = fp16ToFloat(dminHalf);
+                const uint8_t* packedScales = blockIn + 4;
+                const uint8_t* quants = blockIn + 16;
+
+                for (int j = 0; j < Q4_K_BLOCK_SIZE; j += 64)
+                {
+                    uint8_t scale, min;
+                    getScaleMinK4(j / 32, packedScales, scale, min);
+                    const float d1 = d * scale, m1 = dmin * min;
+                    getScaleMinK4(j / 32 + 1, packedScales, scale, min);
+                    const float d2 = d * scale, m2 = dmin * min;
+                    for (int l = 0; l < 32; ++l)
+                        *y++ = d1 * (quants[j / 2 + l] & 0xF) - m1;
+                    for (int l = 0; l < 32; ++l)
+                        *y++ = d2 * (quants[j / 2 + l] >> 4) - m2;
+                }
+            }
+        }
+
+        inline void quantizeRow(GgmlType type, const float* x, uint8_t* out, int64_t count)
+        {
+            if (type == GgmlType::Q4_K)
+                quantizeRowQ4_K(x, out, count);
+            else
+                quantizeRowQ8_0(x, out, count);
+        }
+    } // namespace Quantization
+
+    struct QuantizationResult
+    {
+        bool succeeded = false;
+        std::string error;
+        uint64_t inputBytes = 0;
+        uint64_t outputBytes = 0;
+        size_t quantizedTensors = 0;
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Converts a full-precision GGUF into a Q8_0 or Q4_K model on the local machine.
+     *
+     * Tensors are handed to worker threads largest first; each worker streams its tensors in
+     * row chunks from the source and writes them at their precomputed offsets in the target,
+     * so memory use stays at a few chunks per thread regardless of model size. The output is
+     * written to "<target>.part" and renamed once complete.
+     */
+    class ModelQuantizer
+    {
+    public:
+        // ggml file types recorded in general.file_type
+        static constexpr uint32_t FILE_TYPE_Q8_0 = 7;
+        static constexpr uint32_t FILE_TYPE_Q4_K_M = 15;
+        static constexpr uint32_t QUANTIZATION_VERSION = 2;
+
+        using ProgressCallback = std::function<void(double)>;
+
+        /**
+         * @brief The type a tensor is stored as in a model quantized to targetType.
+         *
+         * Only 2D+ weight matrices are quantized; norms, biases, embeddings of other types and
+         * the MoE router stay as they are. The output projection is kept at 8 bits in 4-bit
+         * models, where llama.cpp would use Q6_K.
+         */
+        static uint32_t chooseTensorType(const GgufTensorInfo& tensor, GgmlType targetType)
+        {
+            const bool isFloat = tensor.type == static_cast<uint32_t>(GgmlType::F32) ||
+                tensor.type == static_cast<uint32_t>(GgmlType::F16) ||
+                tensor.type == static_cast<uint32_t>(GgmlType::BF16);
+            const std::string suffix = ".weight";
+            const bool isWeight = tensor.name.size() > suffix.size() &&
+                tensor.name.compare(tensor.name.size() - suffix.size(), suffix.size(), suffix) == 0;
+
+            if (!isFloat || !isWeight || tensor.dims.size() < 2 ||
+                tensor.name.find("_norm") != std::string::npos ||
+                tensor.name.find("ffn_gate_inp") != std::string::npos)
+            {
+                return tensor.type;
+            }
+
+            if (targetType == GgmlType::Q4_K && tensor.name != "output.weight" &&
+                tensor.dims[0] % Quantization::Q4_K_BLOCK_SIZE == 0)
+            {
+                return static_cast<uint32_t>(GgmlType::Q4_K);
+            }
+            if (tensor.dims[0] % Quantization::Q8_0_BLOCK_SIZE == 0)
+            {
+                return static_cast<uint32_t>(GgmlType::Q8_0);
+            }
+            return tensor.type;
+        }
+
+        static QuantizationResult quantizeFile(const std::string& sourcePath,
+            const std::string& targetPath,
+            GgmlType targetType,
+            const ProgressCallback& onProgress = nullptr,
+            const std::atomic<bool>* cancelled = nullptr,
+            unsigned threadCount = Config::Quantizer::THREAD_COUNT)
+        {
+            KOLOSAL_TRACE_SCOPE("ModelQuantizer::quantizeFile", "quantize");
+            const auto start = std::chrono::steady_clock::now();
+            QuantizationResult result;
+
+            std::ifstream source(sourcePath, std::ios::binary);
+            if (!source.is_open())
+            {
+                result.error = "cannot open " + sourcePath;
+                return result;
+            }
+            std::optional<GgufHeader> sourceHeader = GgufIO::readHeader(source, result.error);
+            if (!sourceHeader)
+            {
+                return result;
+            }
+            source.close();
+
+            // Lay out the target: same metadata and tensor order, new types and offsets
+            GgufHeader targetHeader = *sourceHeader;
+            setMetadata(targetHeader, GgufIO::makeUInt32Entry("general.file_type",
+                targetType == GgmlType::Q4_K ? FILE_TYPE_Q4_K_M : FILE_TYPE_Q8_0));
+            setMetadata(targetHeader, GgufIO::makeUInt32Entry("general.quantization_version", QUANTIZATION_VERSION));
+
+            std::vector<Job> jobs;
+            uint64_t dataSize = 0;
+            for (size_t i = 0; i < targetHeader.tensors.size(); ++i)
+            {
+                const GgufTensorInfo& sourceTensor = sourceHeader->tensors[i];
+                GgufTensorInfo& targetTensor = targetHeader.tensors[i];
+                targetTensor.type = chooseTensorType(sourceTensor, targetType);
+
+                Job job;
+                job.tensor = i;
+                job.sourceOffset = sourceHeader->dataOffset + sourceTensor.offset;
+                job.sourceBytes = sourceTensor.getByteSize(sourceTensor.type);
+                job.targetBytes = targetTensor.getByteSize(targetTensor.type);
+                if (job.sourceBytes == 0 || job.targetBytes == 0)
+                {
+                    result.error = "unsupported tensor " + sourceTensor.name;
+                    return result;
+                }
+
+                dataSize = alignGgufOffset(dataSize, targetHeader.alignment);
+                targetTensor.offset = dataSize;
+                dataSize += job.targetBytes;
+                result.inputBytes += job.sourceBytes;
+                if (targetTensor.type != sourceTensor.type)
+                    ++result.quantizedTensors;
+                jobs.push_back(job);
+            }
+
+            const std::string partPath = targetPath + ".part";
+            std::error_code ec;
+            if (std::filesystem::path(targetPath).has_parent_path())
+                std::filesystem::create_directories(std::filesystem::path(targetPath).parent_path(), ec);
+            {
+                std::ofstream target(partPath, std::ios::binary | std::ios::trunc);
+                if (!target.is_open())
+                {
+                    result.error = "cannot create " + partPath;
+                    return result;
+                }
+                targetHeader.dataOffset = GgufIO::writeHeader(target, targetHeader);
+                if (!target)
+                {
+                    result.error = "failed to write " + partPath;
+                    return result;
+                }
+            }
+            // Size the file up front so every worker can write its tensors in place
+            std::filesystem::resize_file(partPath, targetHeader.dataOffset + dataSize, ec);
+            if (ec)
+            {
+                result.error = "failed to allocate " + partPath + ": " + ec.message();
+                std::filesystem::remove(partPath, ec);
+                return result;
+            }
+            for (Job& job : jobs)
+                job.targetOffset = targetHeader.dataOffset + targetHeader.tensors[job.tensor].offset;
+
+            // Largest tensors first, so no worker is left with a big one at the end
+            std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.sourceBytes > b.sourceBytes; });
+
+            SharedState state;
+            state.sourcePath = sourcePath;
+            state.partPath = partPath;
+            state.jobs = &jobs;
+            state.sourceHeader = &*sourceHeader;
+            state.targetHeader = &targetHeader;
+            state.totalBytes = std::max<uint64_t>(result.inputBytes, 1);
+            state.onProgress = &onProgress;
+            state.cancelled = cancelled;
+
+            if (threadCount == 0)
+                threadCount = std::max(1u, std::thread::hardware_concurrency());
+            threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, jobs.size()));
+
+            std::vector<std::thread> workers;
+            for (unsigned i = 0; i < threadCount; ++i)
+                workers.emplace_back(&ModelQuantizer::runWorker, std::ref(state));
+            for (auto& worker : workers)
+                worker.join();
+
+            if (state.error.empty() && cancelled && cancelled->load())
+                state.error = "cancelled";
+            if (!state.error.empty())
+            {
+                result.error = state.error;
+                std::filesystem::remove(partPath, ec);
+                return result;
+            }
+
+            std::filesystem::remove(targetPath, ec);
+            std::filesystem::rename(partPath, targetPath, ec);
+            if (ec)
+            {
+                result.error = "failed to move " + partPath + " into place: " + ec.message();
+                return result;
+            }
+
+            result.outputBytes = targetHeader.dataOffset + dataSize;
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            result.succeeded = true;
+            return result;
+        }
+
+    private:
+        struct Job
+        {
+            size_t tensor = 0;
+            uint64_t sourceOffset = 0;
+            uint64_t sourceBytes = 0;
+            uint64_t targetOffset = 0;
+            uint64_t targetBytes = 0;
+        };
+
+        struct SharedState
+        {
+            std::string sourcePath;
+            std::string partPath;
+            const std::vector<Job>* jobs = nullptr;
+            const GgufHeader* sourceHeader = nullptr;
+            const GgufHeader* targetHeader = nullptr;
+            uint64_t totalBytes = 1;
+            const ProgressCallback* onProgress = nullptr;
+            const std::atomic<bool>* cancelled = nullptr;
+
+            std::atomic<size_t> nextJob{ 0 };
+            std::atomic<uint64_t> processedBytes{ 0 };
+            std::atomic<bool> failed{ false };
+            std::mutex mutex;
+            std::string error;  // first failure, guarded by mutex
+        };
+
+        static void setMetadata(GgufHeader& header, GgufMetadataEntry entry)
+        {
+            for (auto& existing : header.metadata)
+            {
+                if (existing.key == entry.key)
+                {
+                    existing = std::move(entry);
+                    return;
+                }
+            }
+            header.metadata.push_back(std::move(entry));
+        }
+
+        static void fail(SharedState& state, const std::string& error)
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (state.error.empty())
+                state.error = error;
+            state.failed = true;
+        }
+
+        static void runWorker(SharedState& state)
+        {
+            KOLOSAL_TRACE_THREAD_NAME("Quantizer");
+
+            std::ifstream source(state.sourcePath, std::ios::binary);
+            std::fstream target(state.partPath, std::ios::binary | std::ios::in | std::ios::out);
+            if (!source.is_open() || !target.is_open())
+            {
+                fail(state, "cannot open model files for quantization");
+                return;
+            }
+
+            std::vector<uint8_t> input;
+            std::vector<float> rowValues;
+            std::vector<uint8_t> output;
+
+            for (size_t index = state.nextJob++; index < state.jobs->size(); index = state.nextJob++)
+            {
+                if (state.failed || (state.cancelled && state.cancelled->load()))
+                    return;
+
+                const Job& job = (*state.jobs)[index];
+                const GgufTensorInfo& sourceTensor = state.sourceHeader->tensors[job.tensor];
+                const GgufTensorInfo& targetTensor = state.targetHeader->tensors[job.tensor];
+                KOLOSAL_TRACE_SCOPE("ModelQuantizer::tensor", "quantize");
+
+                const uint64_t rows = sourceTensor.getRowCount();
+                const uint64_t rowLength = sourceTensor.dims[0];
+                const uint64_t sourceRowBytes = job.sourceBytes / rows;
+                const uint64_t targetRowBytes = job.targetBytes / rows;
+                const uint64_t rowsPerChunk = std::max<uint64_t>(1, Config::Quantizer::CHUNK_BYTES / sourceRowBytes);
+                const bool convert = sourceTensor.type != targetTensor.type;
+
+                source.seekg(job.sourceOffset);
+                target.seekp(job.targetOffset);
+                for (uint64_t row = 0; row < rows; row += rowsPerChunk)
+                {
+                    if (state.failed || (state.cancelled && state.cancelled->load()))
+                        return;
+
+                    const uint64_t chunkRows = std::min(rowsPerChunk, rows - row);
+                    input.resize(chunkRows * sourceRowBytes);
+                    if (!source.read(reinterpret_cast<char*>(input.data()), input.size()))
+                    {
+                        fail(state, "unexpected end of model file in " + sourceTensor.name);
+                        return;
+                    }
+
+                    if (convert)
+                    {
+                        rowValues.resize(rowLength);
+                        output.resize(chunkRows * targetRowBytes);
+                        for (uint64_t r = 0; r < chunkRows; ++r)
+                        {
+                            Quantization::convertRowToFloat(sourceTensor.type, input.data() + r * sourceRowBytes,
+                                rowValues.data(), static_cast<int64_t>(rowLength));
+                            Quantization::quantizeRow(static_cast<GgmlType>(targetTensor.type), rowValues.data(),
+                                output.data() + r * targetRowBytes, static_cast<int64_t>(rowLength));
+                        }
+                        target.write(reinterpret_cast<const char*>(output.data()), output.size());
+                    }
+                    else
+                    {
+                        target.write(reinterpret_cast<const char*>(input.data()), input.size());
+                    }
+
+                    if (!target)
+                    {
+                        fail(state, "failed to write quantized model");
+                        return;
+                    }
+
+                    const uint64_t processed = state.processedBytes += input.size();
+                    if (*state.onProgress)
+                        (*state.onProgress)(static_cast<double>(processed) / state.totalBytes);
+                }
+            }
+
+            target.flush();
+            if (!target)
+                fail(state, "failed to write quantized model");
+        }
+    };
+
+} // namespace Model
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "config.hpp"
+#include "crypto/crypto.hpp"
+#include "profiling/trace.hpp"
+
+#include <types.h>
+#include <openssl/evp.h>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+namespace Model
+{
+    /**
+     * @brief Exact-match cache of finished chat completions, stored encrypted on disk.
+     *
+     * An entry is keyed by a SHA-256 over the model file's identity (path, size and
+     * modification time), the variant, every message of the request, the sampling
+     * parameters and the stop sequences. The seed is left out of the key for greedy requests,
+     * whose output does not depend on it. Entries are AES-GCM encrypted with the machine key, one file per entry;
+     * a file's modification time is its last use, which keeps the LRU order across restarts.
+     * The total size is bounded by Config::ResponseCache::MAX_BYTES.
+     */
+    class ResponseCache
+    {
+    public:
+        static ResponseCache& getInstance()
+        {
+            static ResponseCache instance(Config::ResponseCache::DIRECTORY, Crypto::generateKey());
+            return instance;
+        }
+
+        ResponseCache(const ResponseCache&) = delete;
+        ResponseCache& operator=(const ResponseCache&) = delete;
+
+        // Hex digest identifying a request; empty if the model file cannot be read
+        static std::string makeKey(const std::string& modelPath, const std::string& variantType,
+            const ChatCompletionParameters& params, const std::vector<std::string>& stopSequences = {})
+        {
+            std::error_code ec;
+            const uint64_t fileSize = std::filesystem::file_size(modelPath, ec);
+            if (ec)
+            {
+                return {};
+            }
+            const auto writeTime = std::filesystem::last_write_time(modelPath, ec);
+            if (ec)
+            {
+                return {};
+            }
+
+            // Length-prefixed fields, so no two requests serialize to the same bytes
+            std::string data;
+            auto addField = [&data](const void* bytes, size_t size) {
+                const uint64_t length = size;
+                data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+                data.append(static_cast<const char*>(bytes), size);
+                };
+            auto addString = [&addField](const std::string& text) { addField(text.data(), text.size()); };
+            auto addValue = [&addField](const auto& value) { addField(&value, sizeof(value)); };
+
+            addString(modelPath);
+            addValue(fileSize);
+            addValue(static_cast<int64_t>(writeTime.time_since_epoch().count()));
+            addString(variantType);
+
+            addValue(static_cast<uint64_t>(params.messages.size()));
+            for (const auto& message : params.messages)
+            {
+                addString(message.role);
+                addString(message.content);
+            }
+
+            const bool greedy = params.temperature <= Config::ResponseCache::GREEDY_TEMPERATURE;
+            addValue(greedy ? 0 : params.randomSeed);
+            addValue(params.maxNewTokens);
+            addValue(params.minLength);
+            addValue(greedy ? 0.0F : params.temperature);
+            addValue(greedy ? 0.0F : params.topP);
+
+            addValue(static_cast<uint64_t>(stopSequences.size()));
+            for (const auto& sequence : stopSequences)
+            {
+                addString(sequence);
+            }
+
+            unsigned char digest[EVP_MAX_MD_SIZE];
+            unsigned int digestLength = 0;
+            if (EVP_Digest(data.data(), data.size(), digest, &digestLength, EVP_sha256(), nullptr) != 1)
+            {
+                return {};
+            }
+
+            static constexpr char HEX[] = "0123456789abcdef";
+            std::string key;
+            key.reserve(digestLength * 2);
+            for (unsigned int i = 0; i < digestLength; ++i)
+            {
+                key.push_back(HEX[digest[i] >> 4]);
+                key.push_back(HEX[digest[i] & 0x0F]);
+            }
+            return key;
+        }
+
+        // Returns the cached response and marks it as most recently used
+        std::optional<std::string> lookup(const std::string& key)
+        {
+            KOLOSAL_TRACE_SCOPE("ResponseCache::lookup", "inference");
+            std::lock_guard<std::mutex> lock(m_mutex);
+            loadIndexLocked();
+
+            auto entry = m_entries.find(key);
+            if (entry == m_entries.end())
+            {
+                return std::nullopt;
+            }
+
+            std::ifstream file(entryPath(key), std::ios::binary);
+            std::vector<uint8_t> encrypted((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            try
+            {
+                std::vector<uint8_t> plaintext = Crypto::decrypt(encrypted, m_key);
+
+                // The entry starts with its own key so a renamed or swapped file is not served
+                if (plaintext.size() < key.size() || !std::equal(key.begin(), key.end(), plaintext.begin()))
+                {
+                    throw std::runtime_error("key mismatch");
+                }
+
+                entry->second.lastUsed = ++m_useCounter;
+                std::error_code ec;
+                std::filesystem::last_write_time(entryPath(key), std::filesystem::file_time_type::clock::now(), ec);
+                return std::string(plaintext.begin() + key.size(), plaintext.end());
+            }
+            catch (const std::exception& e)
+            {
+                // Written on another machine or damaged; drop it
+                std::cerr << "[ResponseCache] Discarding unreadable entry " << key << ": " << e.what() << "\n";
+                removeLocked(entry);
+                return std::nullopt;
+            }
+        }
+
+        void store(const std::string& key, const std::string& response)
+        {
+            KOLOSAL_TRACE_SCOPE("ResponseCache::store", "inference");
+            std::vector<uint8_t> plaintext(key.begin(), key.end());
+            plaintext.insert(plaintext.end(), response.begin(), response.end());
+
+            std::vector<uint8_t> encrypted;
+            try
+            {
+                encrypted = Crypto::encrypt(plaintext, m_key);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[ResponseCache] Failed to encrypt entry: " << e.what() << "\n";
+                return;
+            }
+            if (encrypted.size() > Config::ResponseCache::MAX_BYTES)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            loadIndexLocked();
+
+            std::error_code ec;
+            std::filesystem::create_directories(m_directory, ec);
+            {
+                std::ofstream file(entryPath(key), std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(encrypted.data()), static_cast<std::streamsize>(encrypted.size()));
+                if (!file)
+                {
+                    std::cerr << "[ResponseCache] Failed to write entry " << key << "\n";
+                    return;
+                }
+            }
+
+            auto entry = m_entries.find(key);
+            if (entry != m_entries.end())
+            {
+                m_totalBytes -= entry->second.size;
+            }
+            m_entries[key] = { encrypted.size(), ++m_useCounter };
+            m_totalBytes += encrypted.size();
+
+            evictLocked();
+        }
+
+        uint64_t getTotalBytes() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_totalBytes;
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t size;
+            uint64_t lastUsed;  // larger is more recent
+        };
+
+        ResponseCache(std::filesystem::path directory, const std::array<uint8_t, Crypto::KEY_SIZE>& key)
+            : m_directory(std::move(directory)), m_key(key)
+        {
+        }
+
+        std::filesystem::path entryPath(const std::string& key) const
+        {
+            return m_directory / (key + ".bin");
+        }
+
+        // Reads the entries left by earlier runs on first use, oldest first by modification time
+        void loadIndexLocked()
+        {
+            if (m_indexLoaded)
+            {
+                return;
+            }
+            m_indexLoaded = true;
+
+            std::error_code ec;
+            if (!std::filesystem::exists(m_directory, ec))
+            {
+                return;
+            }
+
+            struct Found
+            {
+                std::string key;
+                uint64_t size;
+                std::filesystem::file_time_type writeTime;
+            };
+            std::vector<Found> found;
+            for (const auto& file : std::filesystem::directory_iterator(m_directory, ec))
+            {
+                if (!file.is_regular_file(ec) || file.path().extension() != ".bin")
+                {
+                    continue;
+                }
+                const uint64_t size = file.file_size(ec);
+                const auto writeTime = file.last_write_time(ec);
+                if (!ec)
+                {
+                    found.push_back({ file.path().stem().string(), size, writeTime });
+                }
+            }
+
+            std::sort(found.begin(), found.end(),
+                [](const Found& a, const Found& b) { return a.writeTime < b.writeTime; });
+            for (const Found& file : found)
+            {
+                m_entries[file.key] = { file.size, ++m_useCounter };
+                m_totalBytes += file.size;
+            }
+
+            evictLocked();
+        }
+
+        void evictLocked()
+        {
+            while (m_totalBytes > Config::ResponseCache::MAX_BYTES && !m_entries.empty())
+            {
+                auto oldest = std::min_element(m_entries.begin(), m_entries.end(),
+                    [](const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+                removeLocked(oldest);
+            }
+        }
+
+        void removeLocked(std::unordered_map<std::string, Entry>::iterator entry)
+        {
+            std::error_code ec;
+            std::filesystem::remove(entryPath(entry->first), ec);
+            m_totalBytes -= entry->second.size;
+            m_entries.erase(entry);
+        }
+
+        const std::filesystem::path m_directory;
+        const std::array<uint8_t, Crypto::KEY_SIZE> m_key;
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+        uint64_t m_totalBytes = 0;
+        uint64_t m_useCounter = 0;
+        bool m_indexLoaded = false;
+    };
+
+} // namespace Model
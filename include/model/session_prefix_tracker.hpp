@@ -0,0 +1,84 @@
+#pragma once
+
+#include <types.h>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <cstdint>
+#include <algorithm>
+
+namespace Model
+{
+    /**
+     * @brief Tracks which conversation prefix the inference engine has already evaluated.
+     *
+     * Every prompt message is keyed by a chained hash of its role, its content and the key of
+     * the message before it, so a key names one node of the conversation tree together with
+     * the whole path leading to it. Sibling branches share the keys of their common ancestors,
+     * which is exactly the part of the prompt the engine can keep from its previous evaluation.
+     */
+    class SessionPrefixTracker
+    {
+    public:
+        static std::vector<uint64_t> buildNodeKeys(const std::vector<Message>& messages)
+        {
+            std::vector<uint64_t> keys;
+            keys.reserve(messages.size());
+
+            uint64_t parentKey = FNV_OFFSET_BASIS;
+            for (const auto& message : messages)
+            {
+                uint64_t key = hashBytes(parentKey, message.role);
+                key = hashBytes(key ^ FNV_PRIME, message.content);
+                keys.push_back(key);
+                parentKey = key;
+            }
+            return keys;
+        }
+
+        /**
+         * @brief Records the prompt about to be evaluated.
+         *
+         * @return The number of leading messages shared with the previously evaluated prompt.
+         */
+        size_t update(const std::vector<Message>& messages)
+        {
+            std::vector<uint64_t> keys = buildNodeKeys(messages);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto mismatch = std::mismatch(keys.begin(), keys.end(), m_lastKeys.begin(), m_lastKeys.end());
+            size_t shared = static_cast<size_t>(mismatch.first - keys.begin());
+            m_lastKeys = std::move(keys);
+            return shared;
+        }
+
+        // Forgets the evaluated prefix, e.g. after a different model was loaded.
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_lastKeys.clear();
+        }
+
+    private:
+        static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+        static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+        static uint64_t hashBytes(uint64_t seed, const std::string& bytes)
+        {
+            uint64_t hash = seed;
+            for (unsigned char c : bytes)
+            {
+                hash ^= c;
+                hash *= FNV_PRIME;
+            }
+            // Terminator so that ("ab", "c") and ("a", "bc") do not collide
+            hash ^= 0xFF;
+            hash *= FNV_PRIME;
+            return hash;
+        }
+
+        std::vector<uint64_t> m_lastKeys;
+        std::mutex m_mutex;
+    };
+
+} // namespace Model
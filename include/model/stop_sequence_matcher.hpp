@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Model
+{
+    /**
+     * @brief Finds the first of a set of stop sequences in text that arrives in pieces.
+     *
+     * An Aho-Corasick automaton compiled to a full transition table, so each byte costs one
+     * lookup however the stream is split: a sequence that spans two deltas is found like any
+     * other. The matcher also reports how much of the stream can no longer turn into a match,
+     * which is what may be shown while the rest is held back.
+     *
+     * The stream is cut where the earliest-starting sequence starts, not where the first one
+     * completes: with "ser" and "\nUser:", the text "\nUser:" is cut before the newline. A
+     * completed match is therefore held as a candidate while a partial match that starts
+     * earlier can still complete.
+     */
+    class StopSequenceMatcher
+    {
+    public:
+        static constexpr size_t NO_MATCH = static_cast<size_t>(-1);
+
+        explicit StopSequenceMatcher(const std::vector<std::string>& sequences)
+        {
+            m_nodes.emplace_back();
+            for (const std::string& sequence : sequences)
+            {
+                if (sequence.empty())
+                    continue;
+
+                int node = 0;
+                for (unsigned char c : sequence)
+                {
+                    if (m_nodes[node].next[c] == 0)
+                    {
+                        m_nodes[node].next[c] = static_cast<int>(m_nodes.size());
+                        m_nodes.emplace_back();
+                        m_nodes.back().depth = m_nodes[node].depth + 1;
+                    }
+                    node = m_nodes[node].next[c];
+                }
+                m_nodes[node].matchLength = sequence.size();
+            }
+            build();
+        }
+
+        bool empty() const { return m_nodes.size() == 1; }
+
+        /**
+         * @brief Advances over the next bytes of the stream.
+         *
+         * @return The stream offset at which the earliest-starting stop sequence starts, once
+         * no partial match starting before it is left, or NO_MATCH. Once a match is found
+         * further input is ignored.
+         */
+        size_t feed(const char* data, size_t size)
+        {
+            for (size_t i = 0; i < size && m_match == NO_MATCH; ++i)
+            {
+                m_state = m_nodes[m_state].next[static_cast<unsigned char>(data[i])];
+                ++m_consumed;
+                if (m_nodes[m_state].matchLength > 0)
+                {
+                    // The longest sequence ending here starts earliest
+                    m_candidate = std::min(m_candidate, m_consumed - m_nodes[m_state].matchLength);
+                }
+
+                // The deepest node is the partial match that started earliest
+                if (m_candidate <= m_consumed - m_nodes[m_state].depth)
+                {
+                    m_match = m_candidate;
+                }
+            }
+            return m_match;
+        }
+
+        /**
+         * @brief Ends the stream: partial matches can no longer complete, so a held candidate
+         * becomes the match.
+         */
+        size_t finish()
+        {
+            if (m_match == NO_MATCH)
+            {
+                m_match = m_candidate;
+            }
+            return m_match;
+        }
+
+        size_t getMatch() const { return m_match; }
+
+        // Length of the stream prefix that no stop sequence can start in
+        size_t getSafeLength() const
+        {
+            return m_match != NO_MATCH ? m_match : std::min(m_candidate, m_consumed - m_nodes[m_state].depth);
+        }
+
+    private:
+        struct Node
+        {
+            std::array<int, 256> next{};
+            int fail = 0;
+            size_t depth = 0;
+            size_t matchLength = 0;     // longest sequence that is a suffix of this node's path
+        };
+
+        // Breadth-first over the trie: fills the failure links and turns missing edges into
+        // the edges of the failure node, so matching never has to follow links
+        void build()
+        {
+            std::vector<int> queue;
+            for (int c = 0; c < 256; ++c)
+            {
+                if (m_nodes[0].next[c] != 0)
+                    queue.push_back(m_nodes[0].next[c]);
+            }
+
+            for (size_t head = 0; head < queue.size(); ++head)
+            {
+                const int node = queue[head];
+                const int fail = m_nodes[node].fail;
+                if (m_nodes[node].matchLength == 0)
+                    m_nodes[node].matchLength = m_nodes[fail].matchLength;
+
+                for (int c = 0; c < 256; ++c)
+                {
+                    const int child = m_nodes[node].next[c];
+                    if (child != 0)
+                    {
+                        m_nodes[child].fail = m_nodes[fail].next[c];
+                        queue.push_back(child);
+                    }
+                    else
+                    {
+                        m_nodes[node].next[c] = m_nodes[fail].next[c];
+                    }
+                }
+            }
+        }
+
+        std::vector<Node> m_nodes;
+        int m_state = 0;
+        size_t m_consumed = 0;
+        size_t m_candidate = NO_MATCH;  // earliest completed match, see feed
+        size_t m_match = NO_MATCH;
+    };
+
+} // namespace Model
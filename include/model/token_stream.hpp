@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <algorithm>
+
+namespace Model
+{
+    /**
+     * @brief Lock-free single-producer/single-consumer ring carrying the streamed text of one job.
+     *
+     * The job's polling thread is the only producer and the UI thread the only consumer, so
+     * the two sides synchronize through the head and tail indices alone. They live on
+     * separate cache lines so the producer and consumer do not false-share.
+     */
+    class TokenStream
+    {
+    public:
+        // capacity is rounded up to a power of two
+        TokenStream(int jobId, size_t capacity)
+            : m_jobId(jobId)
+        {
+            size_t size = 1;
+            while (size < capacity)
+                size <<= 1;
+            m_buffer = std::make_unique<char[]>(size);
+            m_mask = size - 1;
+        }
+
+        TokenStream(const TokenStream&) = delete;
+        TokenStream& operator=(const TokenStream&) = delete;
+
+        int getJobId() const { return m_jobId; }
+
+        //--------------------------------------------------------------------------------------------
+        // Producer side
+        //--------------------------------------------------------------------------------------------
+
+        // Writes as much of data as fits and returns the number of bytes written.
+        size_t push(const char* data, size_t size)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            const size_t tail = m_tail.load(std::memory_order_acquire);
+            const size_t count = std::min(size, capacity() - (head - tail));
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_buffer[(head + i) & m_mask] = data[i];
+            }
+            m_head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        // Must be called after the last push; the consumer sees it after draining everything.
+        void finish(bool succeeded)
+        {
+            m_succeeded.store(succeeded, std::memory_order_relaxed);
+            m_finished.store(true, std::memory_order_release);
+        }
+
+        //--------------------------------------------------------------------------------------------
+        // Consumer side
+        //--------------------------------------------------------------------------------------------
+
+        // Appends every byte available so far to out and returns how many were appended.
+        size_t drain(std::string& out)
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            const size_t head = m_head.load(std::memory_order_acquire);
+
+            for (size_t i = tail; i != head; ++i)
+            {
+                out.push_back(m_buffer[i & m_mask]);
+            }
+            m_tail.store(head, std::memory_order_release);
+            return head - tail;
+        }
+
+        // True once the producer is done; a drain after observing this gets all remaining text.
+        bool isFinished() const
+        {
+            return m_finished.load(std::memory_order_acquire);
+        }
+
+        bool hasSucceeded() const
+        {
+            return m_succeeded.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Length of text[0, end) without a trailing incomplete UTF-8 sequence.
+         *
+         * Producers only push whole code points so the UI never displays half a character.
+         */
+        static size_t completeUtf8Length(const std::string& text, size_t end)
+        {
+            size_t lead = end;
+            for (size_t back = 0; back < 4 && lead > 0; ++back)
+            {
+                unsigned char c = static_cast<unsigned char>(text[lead - 1]);
+                if ((c & 0xC0) != 0x80)
+                {
+                    size_t sequenceLength = (c & 0x80) == 0 ? 1 : (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : 4;
+                    return (end - (lead - 1)) >= sequenceLength ? end : lead - 1;
+                }
+                --lead;
+            }
+            return end;
+        }
+
+    private:
+        size_t capacity() const { return m_mask + 1; }
+
+        const int m_jobId;
+        std::unique_ptr<char[]> m_buffer;
+        size_t m_mask = 0;
+
+        alignas(64) std::atomic<size_t> m_head{ 0 };   // written by the producer
+        alignas(64) std::atomic<size_t> m_tail{ 0 };   // written by the consumer
+        std::atomic<bool> m_finished{ false };
+        std::atomic<bool> m_succeeded{ false };
+    };
+
+} // namespace Model
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "config.hpp"
+#include "profiling/trace.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace Profiling
+{
+    enum class FrameStage
+    {
+        ProcessEvents,
+        NewFrame,
+        BuildUI,
+        ImGuiRender,
+        RenderGradient,
+        RenderDrawData,
+        SwapBuffers,
+        Count
+    };
+
+    inline const char* getFrameStageName(FrameStage stage)
+    {
+        switch (stage)
+        {
+        case FrameStage::ProcessEvents:  return "ProcessEvents";
+        case FrameStage::NewFrame:       return "NewFrame";
+        case FrameStage::BuildUI:        return "BuildUI";
+        case FrameStage::ImGuiRender:    return "ImGui::Render";
+        case FrameStage::RenderGradient: return "RenderGradient";
+        case FrameStage::RenderDrawData: return "RenderDrawData";
+        case FrameStage::SwapBuffers:    return "SwapBuffers";
+        default:                         return "Unknown";
+        }
+    }
+
+    /**
+     * @brief Per-frame CPU timings of the main loop.
+     *
+     * Only touched from the UI thread. Recording is a couple of clock reads per stage, so it
+     * stays on even when nothing is displaying the numbers.
+     */
+    class FrameStats
+    {
+    public:
+        static constexpr size_t STAGE_COUNT = static_cast<size_t>(FrameStage::Count);
+        static constexpr size_t HISTORY_SIZE = Config::PerformanceOverlay::FRAME_HISTORY_SIZE;
+
+        static FrameStats& getInstance()
+        {
+            static FrameStats instance;
+            return instance;
+        }
+
+        FrameStats(const FrameStats&) = delete;
+        FrameStats& operator=(const FrameStats&) = delete;
+
+        void recordStage(FrameStage stage, double milliseconds)
+        {
+            m_currentStages[static_cast<size_t>(stage)] += milliseconds;
+        }
+
+        // Closes the current frame: stores its total time and folds stage times into the averages.
+        void endFrame(double frameMilliseconds)
+        {
+            m_frameHistory[m_historyOffset] = static_cast<float>(frameMilliseconds);
+            m_historyOffset = (m_historyOffset + 1) % HISTORY_SIZE;
+            if (m_historyCount < HISTORY_SIZE)
+                ++m_historyCount;
+
+            constexpr double smoothing = Config::PerformanceOverlay::STAGE_SMOOTHING;
+            for (size_t i = 0; i < STAGE_COUNT; ++i)
+            {
+                m_averageStages[i] = m_averageStages[i] * (1.0 - smoothing) + m_currentStages[i] * smoothing;
+                m_currentStages[i] = 0.0;
+            }
+        }
+
+        double getAverageStageMs(FrameStage stage) const
+        {
+            return m_averageStages[static_cast<size_t>(stage)];
+        }
+
+        // Ring buffer of frame times in milliseconds; read starting at getHistoryOffset().
+        const float* getFrameHistory() const { return m_frameHistory.data(); }
+        size_t getHistoryOffset() const { return m_historyOffset; }
+        size_t getHistoryCount() const { return m_historyCount; }
+
+    private:
+        FrameStats() = default;
+
+        std::array<double, STAGE_COUNT> m_currentStages{};
+        std::array<double, STAGE_COUNT> m_averageStages{};
+        std::array<float, HISTORY_SIZE> m_frameHistory{};
+        size_t m_historyOffset = 0;
+        size_t m_historyCount = 0;
+    };
+
+    /**
+     * @brief Times one main loop stage into FrameStats and, when enabled, the tracer.
+     */
+    class ScopedFrameStage
+    {
+    public:
+        explicit ScopedFrameStage(FrameStage stage)
+            : m_stage(stage)
+            , m_start(std::chrono::steady_clock::now()) {}
+
+        ~ScopedFrameStage()
+        {
+            auto end = std::chrono::steady_clock::now();
+            FrameStats::getInstance().recordStage(m_stage,
+                std::chrono::duration<double, std::milli>(end - m_start).count());
+
+#ifdef KOLOSAL_ENABLE_TRACING
+            Tracer& tracer = Tracer::getInstance();
+            int64_t durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - m_start).count();
+            int64_t endUs = tracer.nowUs();
+            tracer.complete(getFrameStageName(m_stage), "frame", endUs - durationUs, endUs);
+#endif
+        }
+
+        ScopedFrameStage(const ScopedFrameStage&) = delete;
+        ScopedFrameStage& operator=(const ScopedFrameStage&) = delete;
+
+    private:
+        FrameStage m_stage;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+} // namespace Profiling
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <iomanip>
+
+namespace Profiling
+{
+    enum class MemorySubsystem
+    {
+        ChatHistory,        // ChatManager containers and message contents
+        Presets,            // PresetManager containers
+        ModelCatalog,       // ModelManager containers
+        FontAtlas,          // ImGui font atlas texture (GPU)
+        GradientTexture,    // Background gradient texture (GPU)
+        DownloadBuffers,    // Transfer buffers of in-flight downloads
+        ModelMappings,      // Memory-mapped model files (prefetch)
+        ModelWeights,       // Weights handed to the inference engine
+        Count
+    };
+
+    inline const char* getMemorySubsystemName(MemorySubsystem subsystem)
+    {
+        switch (subsystem)
+        {
+        case MemorySubsystem::ChatHistory:     return "ChatHistory";
+        case MemorySubsystem::Presets:         return "Presets";
+        case MemorySubsystem::ModelCatalog:    return "ModelCatalog";
+        case MemorySubsystem::FontAtlas:       return "FontAtlas";
+        case MemorySubsystem::GradientTexture: return "GradientTexture";
+        case MemorySubsystem::DownloadBuffers: return "DownloadBuffers";
+        case MemorySubsystem::ModelMappings:   return "ModelMappings";
+        case MemorySubsystem::ModelWeights:    return "ModelWeights";
+        default:                               return "Unknown";
+        }
+    }
+
+    struct MemoryUsage
+    {
+        MemorySubsystem subsystem;
+        int64_t currentBytes;
+        int64_t peakBytes;
+        int64_t budgetBytes; // 0 when the subsystem has no budget
+    };
+
+    struct MemorySnapshot
+    {
+        std::vector<MemoryUsage> subsystems;
+        int64_t totalBytes = 0;
+    };
+
+    /**
+     * @brief Process-wide per-subsystem byte counters with high-water marks.
+     *
+     * Counters are fed either by TrackingAllocator for manager-owned containers or by explicit
+     * add/release/set calls for memory the allocator cannot see (GPU textures, file mappings,
+     * engine-owned weights). All operations are lock-free.
+     */
+    class MemoryTracker
+    {
+    public:
+        static constexpr size_t SUBSYSTEM_COUNT = static_cast<size_t>(MemorySubsystem::Count);
+        static_assert(sizeof(Config::Memory::BUDGETS) / sizeof(Config::Memory::BUDGETS[0]) == SUBSYSTEM_COUNT,
+            "Config::Memory::BUDGETS must have one entry per memory subsystem");
+
+        static MemoryTracker& getInstance()
+        {
+            static MemoryTracker instance;
+            return instance;
+        }
+
+        MemoryTracker(const MemoryTracker&) = delete;
+        MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+        void add(MemorySubsystem subsystem, int64_t bytes)
+        {
+            const size_t index = static_cast<size_t>(subsystem);
+            int64_t current = m_current[index].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            updatePeak(index, current);
+        }
+
+        void release(MemorySubsystem subsystem, int64_t bytes)
+        {
+            m_current[static_cast<size_t>(subsystem)].fetch_sub(bytes, std::memory_order_relaxed);
+        }
+
+        // Replaces the counter, for subsystems that report an absolute size (e.g. a texture).
+        void set(MemorySubsystem subsystem, int64_t bytes)
+        {
+            const size_t index = static_cast<size_t>(subsystem);
+            m_current[index].store(bytes, std::memory_order_relaxed);
+            updatePeak(index, bytes);
+        }
+
+        int64_t getCurrentBytes(MemorySubsystem subsystem) const
+        {
+            return m_current[static_cast<size_t>(subsystem)].load(std::memory_order_relaxed);
+        }
+
+        int64_t getPeakBytes(MemorySubsystem subsystem) const
+        {
+            return m_peak[static_cast<size_t>(subsystem)].load(std::memory_order_relaxed);
+        }
+
+        MemorySnapshot snapshot() const
+        {
+            MemorySnapshot result;
+            result.subsystems.reserve(SUBSYSTEM_COUNT);
+            for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i)
+            {
+                auto subsystem = static_cast<MemorySubsystem>(i);
+                MemoryUsage usage{
+                    subsystem,
+                    getCurrentBytes(subsystem),
+                    getPeakBytes(subsystem),
+                    Config::Memory::BUDGETS[i]
+                };
+                result.totalBytes += usage.currentBytes;
+                result.subsystems.push_back(usage);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Returns the subsystems whose current usage exceeds their configured budget.
+         */
+        std::vector<MemoryUsage> checkBudgets() const
+        {
+            std::vector<MemoryUsage> violations;
+            for (const auto& usage : snapshot().subsystems)
+            {
+                if (usage.budgetBytes > 0 && usage.currentBytes > usage.budgetBytes)
+                {
+                    violations.push_back(usage);
+                }
+            }
+            return violations;
+        }
+
+        void dump(std::ostream& out) const
+        {
+            MemorySnapshot current = snapshot();
+
+            out << "[MemoryTracker] Subsystem usage (current / peak / budget):\n";
+            for (const auto& usage : current.subsystems)
+            {
+                out << "  " << std::left << std::setw(16) << getMemorySubsystemName(usage.subsystem)
+                    << std::right << std::fixed << std::setprecision(2)
+                    << std::setw(10) << toMiB(usage.currentBytes) << " MiB / "
+                    << std::setw(10) << toMiB(usage.peakBytes) << " MiB / ";
+                if (usage.budgetBytes > 0)
+                    out << toMiB(usage.budgetBytes) << " MiB";
+                else
+                    out << "-";
+                out << "\n";
+            }
+            out << "  Total tracked: " << toMiB(current.totalBytes) << " MiB" << std::endl;
+        }
+
+        static double toMiB(int64_t bytes)
+        {
+            return static_cast<double>(bytes) / (1024.0 * 1024.0);
+        }
+
+    private:
+        MemoryTracker() = default;
+
+        void updatePeak(size_t index, int64_t value)
+        {
+            int64_t peak = m_peak[index].load(std::memory_order_relaxed);
+            while (value > peak &&
+                !m_peak[index].compare_exchange_weak(peak, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        std::array<std::atomic<int64_t>, SUBSYSTEM_COUNT> m_current{};
+        std::array<std::atomic<int64_t>, SUBSYSTEM_COUNT> m_peak{};
+    };
+
+    /**
+     * @brief Standard allocator that charges its allocations to a memory subsystem.
+     */
+    template <typename T, MemorySubsystem Subsystem>
+    class TrackingAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = TrackingAllocator<U, Subsystem>;
+        };
+
+        TrackingAllocator() noexcept = default;
+
+        template <typename U>
+        TrackingAllocator(const TrackingAllocator<U, Subsystem>&) noexcept {}
+
+        T* allocate(size_t count)
+        {
+            T* pointer = std::allocator<T>().allocate(count);
+            MemoryTracker::getInstance().add(Subsystem, static_cast<int64_t>(count * sizeof(T)));
+            return pointer;
+        }
+
+        void deallocate(T* pointer, size_t count) noexcept
+        {
+            MemoryTracker::getInstance().release(Subsystem, static_cast<int64_t>(count * sizeof(T)));
+            std::allocator<T>().deallocate(pointer, count);
+        }
+
+        template <typename U>
+        bool operator==(const TrackingAllocator<U, Subsystem>&) const noexcept { return true; }
+
+        template <typename U>
+        bool operator!=(const TrackingAllocator<U, Subsystem>&) const noexcept { return false; }
+    };
+
+    template <typename T, MemorySubsystem Subsystem>
+    using TrackedVector = std::vector<T, TrackingAllocator<T, Subsystem>>;
+
+    /**
+     * @brief Charges a fixed number of bytes to a subsystem for its own lifetime.
+     */
+    class ScopedMemoryCharge
+    {
+    public:
+        ScopedMemoryCharge(MemorySubsystem subsystem, int64_t bytes)
+            : m_subsystem(subsystem)
+            , m_bytes(bytes)
+        {
+            MemoryTracker::getInstance().add(m_subsystem, m_bytes);
+        }
+
+        ~ScopedMemoryCharge()
+        {
+            MemoryTracker::getInstance().release(m_subsystem, m_bytes);
+        }
+
+        ScopedMemoryCharge(const ScopedMemoryCharge&) = delete;
+        ScopedMemoryCharge& operator=(const ScopedMemoryCharge&) = delete;
+
+    private:
+        MemorySubsystem m_subsystem;
+        int64_t m_bytes;
+    };
+
+} // namespace Profiling
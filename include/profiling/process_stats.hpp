@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Profiling
+{
+    /**
+     * @brief Returns the resident set size (working set on Windows) of this process in bytes.
+     */
+    inline uint64_t getProcessResidentBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return static_cast<uint64_t>(counters.WorkingSetSize);
+        }
+        return 0;
+#else
+        FILE* statm = std::fopen("/proc/self/statm", "r");
+        if (!statm)
+        {
+            return 0;
+        }
+
+        unsigned long totalPages = 0;
+        unsigned long residentPages = 0;
+        int fields = std::fscanf(statm, "%lu %lu", &totalPages, &residentPages);
+        std::fclose(statm);
+        if (fields != 2)
+        {
+            return 0;
+        }
+        return static_cast<uint64_t>(residentPages) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+} // namespace Profiling
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <json.hpp>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+using json = nlohmann::json;
+
+namespace Profiling
+{
+    /**
+     * @brief Records named milestones relative to process start.
+     *
+     * Milestones may be marked from any thread. Each one is logged as it happens, and the
+     * whole run is appended as a single JSON line to Config::Startup::TIMELINE_FILE so that
+     * time-to-first-frame and time-to-interactive can be tracked across builds.
+     */
+    class StartupTimeline
+    {
+    public:
+        static StartupTimeline& getInstance()
+        {
+            static StartupTimeline instance;
+            return instance;
+        }
+
+        StartupTimeline(const StartupTimeline&) = delete;
+        StartupTimeline& operator=(const StartupTimeline&) = delete;
+
+        // Records the first occurrence of a milestone; repeated marks are ignored.
+        void mark(const std::string& name)
+        {
+            double elapsedMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - m_start).count();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& milestone : m_milestones)
+            {
+                if (milestone.name == name)
+                    return;
+            }
+
+            m_milestones.push_back({ name, elapsedMs });
+            std::cout << "[StartupTimeline] " << name << " at " << elapsedMs << " ms" << std::endl;
+        }
+
+        bool hasMark(const std::string& name) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& milestone : m_milestones)
+            {
+                if (milestone.name == name)
+                    return true;
+            }
+            return false;
+        }
+
+        // Appends the milestones recorded so far as one JSON line.
+        void save() const
+        {
+            json run;
+            run["timestamp"] = static_cast<int64_t>(std::time(nullptr));
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                json milestones = json::object();
+                for (const auto& milestone : m_milestones)
+                {
+                    milestones[milestone.name] = milestone.elapsedMs;
+                }
+                run["milestones"] = milestones;
+            }
+
+            std::ofstream file(Config::Startup::TIMELINE_FILE, std::ios::app);
+            if (!file.is_open())
+            {
+                std::cerr << "[StartupTimeline] Failed to open timeline file: "
+                    << Config::Startup::TIMELINE_FILE << std::endl;
+                return;
+            }
+            file << run.dump() << "\n";
+        }
+
+    private:
+        struct Milestone
+        {
+            std::string name;
+            double elapsedMs;
+        };
+
+        StartupTimeline() : m_start(std::chrono::steady_clock::now()) {}
+
+        std::chrono::steady_clock::time_point m_start;
+        std::vector<Milestone> m_milestones;
+        mutable std::mutex m_mutex;
+    };
+
+} // namespace Profiling
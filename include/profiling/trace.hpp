@@ -0,0 +1,273 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+#include <algorithm>
+
+namespace Profiling
+{
+    /**
+     * @brief A single trace record. Names and categories must be string literals.
+     */
+    struct TraceEvent
+    {
+        const char* name;
+        const char* category;
+        int64_t timestampUs;
+        int64_t durationUs;
+        int64_t arg;        // Optional numeric argument (e.g. a job id), -1 if unused
+        char phase;         // 'X' complete event, 'i' instant event
+    };
+
+    /**
+     * @brief Fixed-size ring of events owned by a single thread.
+     *
+     * Only the owning thread records into the ring; the lock is uncontended except while a
+     * dump is copying it out.
+     */
+    class TraceBuffer
+    {
+    public:
+        TraceBuffer(uint32_t threadId, size_t capacity)
+            : m_threadId(threadId)
+            , m_events(capacity)
+            , m_written(0) {}
+
+        void record(const TraceEvent& event)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_events[m_written % m_events.size()] = event;
+            ++m_written;
+        }
+
+        // Copies the retained events, oldest first.
+        std::vector<TraceEvent> snapshot() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::vector<TraceEvent> events;
+            size_t count = std::min(m_written, m_events.size());
+            events.reserve(count);
+            for (size_t i = m_written - count; i < m_written; ++i)
+            {
+                events.push_back(m_events[i % m_events.size()]);
+            }
+            return events;
+        }
+
+        uint32_t getThreadId() const { return m_threadId; }
+
+        void setThreadName(const char* name)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_threadName = name;
+        }
+
+        const char* getThreadName() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_threadName;
+        }
+
+    private:
+        const uint32_t m_threadId;
+        const char* m_threadName = nullptr;
+        std::vector<TraceEvent> m_events;
+        size_t m_written;
+        mutable std::mutex m_mutex;
+    };
+
+    /**
+     * @brief Process-wide registry of per-thread trace buffers.
+     *
+     * Each thread lazily registers its own TraceBuffer on the first recorded event. Buffers
+     * are shared with the registry so events from threads that have already exited (e.g.
+     * std::async workers) survive until the next dump.
+     */
+    class Tracer
+    {
+    public:
+        static Tracer& getInstance()
+        {
+            static Tracer instance;
+            return instance;
+        }
+
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        int64_t nowUs() const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_epoch).count();
+        }
+
+        void complete(const char* name, const char* category, int64_t startUs, int64_t endUs, int64_t arg = -1)
+        {
+            localBuffer().record({ name, category, startUs, endUs - startUs, arg, 'X' });
+        }
+
+        void instant(const char* name, const char* category, int64_t arg = -1)
+        {
+            localBuffer().record({ name, category, nowUs(), 0, arg, 'i' });
+        }
+
+        void setThreadName(const char* name)
+        {
+            localBuffer().setThreadName(name);
+        }
+
+        /**
+         * @brief Writes every retained event as Chrome trace-event JSON.
+         *
+         * The output loads directly in Perfetto (ui.perfetto.dev) or chrome://tracing.
+         */
+        bool dumpChromeTrace(const std::string& path) const
+        {
+            std::vector<std::shared_ptr<TraceBuffer>> buffers;
+            {
+                std::lock_guard<std::mutex> lock(m_registryMutex);
+                buffers = m_buffers;
+            }
+
+            std::ofstream file(path, std::ios::trunc);
+            if (!file.is_open())
+            {
+                std::cerr << "[Tracer] Failed to open trace file: " << path << std::endl;
+                return false;
+            }
+
+            size_t eventCount = 0;
+            bool first = true;
+            auto separator = [&]() -> std::ofstream& {
+                if (!first)
+                    file << ",\n";
+                first = false;
+                return file;
+            };
+
+            file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            for (const auto& buffer : buffers)
+            {
+                const uint32_t tid = buffer->getThreadId();
+                if (const char* threadName = buffer->getThreadName())
+                {
+                    separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << tid
+                        << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+                }
+
+                for (const auto& event : buffer->snapshot())
+                {
+                    separator() << "{\"ph\":\"" << event.phase
+                        << "\",\"name\":\"" << event.name
+                        << "\",\"cat\":\"" << event.category
+                        << "\",\"pid\":1,\"tid\":" << tid
+                        << ",\"ts\":" << event.timestampUs;
+                    if (event.phase == 'X')
+                        file << ",\"dur\":" << event.durationUs;
+                    else
+                        file << ",\"s\":\"t\"";
+                    if (event.arg >= 0)
+                        file << ",\"args\":{\"id\":" << event.arg << "}";
+                    file << "}";
+                    ++eventCount;
+                }
+            }
+            file << "\n]}\n";
+
+            std::cout << "[Tracer] Wrote " << eventCount << " events to " << path << std::endl;
+            return true;
+        }
+
+    private:
+        Tracer() : m_epoch(std::chrono::steady_clock::now()) {}
+
+        TraceBuffer& localBuffer()
+        {
+            thread_local std::shared_ptr<TraceBuffer> buffer = registerThread();
+            return *buffer;
+        }
+
+        std::shared_ptr<TraceBuffer> registerThread()
+        {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            auto buffer = std::make_shared<TraceBuffer>(m_nextThreadId++, Config::Tracing::RING_CAPACITY);
+            m_buffers.push_back(buffer);
+
+            // Bound the registry when many short-lived worker threads come and go. Only the
+            // oldest buffer of a thread that has exited is dropped: the registry holds its last
+            // reference. A live thread, such as the UI thread, always keeps its buffer.
+            if (m_buffers.size() > Config::Tracing::MAX_THREAD_BUFFERS)
+            {
+                auto exited = std::find_if(m_buffers.begin(), m_buffers.end(),
+                    [](const std::shared_ptr<TraceBuffer>& candidate) { return candidate.use_count() == 1; });
+                if (exited != m_buffers.end())
+                {
+                    m_buffers.erase(exited);
+                }
+            }
+            return buffer;
+        }
+
+        const std::chrono::steady_clock::time_point m_epoch;
+        std::vector<std::shared_ptr<TraceBuffer>> m_buffers;
+        uint32_t m_nextThreadId = 1;
+        mutable std::mutex m_registryMutex;
+    };
+
+    /**
+     * @brief Records a complete event spanning its own lifetime.
+     */
+    class ScopedTrace
+    {
+    public:
+        ScopedTrace(const char* name, const char* category, int64_t arg = -1)
+            : m_name(name)
+            , m_category(category)
+            , m_arg(arg)
+            , m_startUs(Tracer::getInstance().nowUs()) {}
+
+        ~ScopedTrace()
+        {
+            Tracer& tracer = Tracer::getInstance();
+            tracer.complete(m_name, m_category, m_startUs, tracer.nowUs(), m_arg);
+        }
+
+        ScopedTrace(const ScopedTrace&) = delete;
+        ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+    private:
+        const char* m_name;
+        const char* m_category;
+        int64_t m_arg;
+        int64_t m_startUs;
+    };
+
+} // namespace Profiling
+
+#define KOLOSAL_TRACE_CONCAT_INNER(a, b) a##b
+#define KOLOSAL_TRACE_CONCAT(a, b) KOLOSAL_TRACE_CONCAT_INNER(a, b)
+
+// Tracing is compiled out entirely unless the build enables it (cmake -DENABLE_TRACING=ON).
+#ifdef KOLOSAL_ENABLE_TRACING
+#define KOLOSAL_TRACE_SCOPE(name, category) \
+    Profiling::ScopedTrace KOLOSAL_TRACE_CONCAT(kolosalTraceScope, __LINE__)(name, category)
+#define KOLOSAL_TRACE_SCOPE_ARG(name, category, arg) \
+    Profiling::ScopedTrace KOLOSAL_TRACE_CONCAT(kolosalTraceScope, __LINE__)(name, category, static_cast<int64_t>(arg))
+#define KOLOSAL_TRACE_INSTANT(name, category, arg) \
+    Profiling::Tracer::getInstance().instant(name, category, static_cast<int64_t>(arg))
+#define KOLOSAL_TRACE_THREAD_NAME(name) \
+    Profiling::Tracer::getInstance().setThreadName(name)
+#else
+#define KOLOSAL_TRACE_SCOPE(name, category) ((void)0)
+#define KOLOSAL_TRACE_SCOPE_ARG(name, category, arg) ((void)0)
+#define KOLOSAL_TRACE_INSTANT(name, category, arg) ((void)0)
+#define KOLOSAL_TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "imgui.h"
+#include "config.hpp"
+#include "ui/widgets.hpp"
+#include "model/model_manager.hpp"
+#include "model/preset_manager.hpp"
+#include "model/benchmark_runner.hpp"
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include <utility>
+#include <optional>
+#include <filesystem>
+
+namespace BenchmarkView
+{
+    struct ViewState
+    {
+        std::set<std::pair<std::string, std::string>> selectedTargets; // (model, variant)
+        std::set<std::string> selectedPresets;
+        std::vector<std::filesystem::path> savedRuns;
+        int selectedRun = -1;   // index into savedRuns, -1 for the live run
+        std::optional<Model::BenchmarkRun> loadedRun;
+        bool savedRunsStale = true;
+        bool wasRunning = false;
+    };
+
+    inline ViewState& getViewState()
+    {
+        static ViewState state;
+        return state;
+    }
+
+    // Results of one model variant and preset, averaged over the prompt set
+    struct ResultSummary
+    {
+        int runs = 0;
+        int errors = 0;
+        double ttftMs = 0.0;
+        double tokensPerSecond = 0.0;
+        double outputTokens = 0.0;
+        uint64_t peakResidentBytes = 0;
+        int64_t modelWeightsBytes = 0;
+        std::string lastError;
+    };
+
+    using SummaryKey = std::tuple<std::string, std::string, std::string>;
+
+    inline std::map<SummaryKey, ResultSummary> summarize(const Model::BenchmarkRun& run)
+    {
+        std::map<SummaryKey, ResultSummary> summaries;
+        for (const auto& result : run.results)
+        {
+            ResultSummary& summary = summaries[{ result.modelName, result.variantType, result.presetName }];
+            if (!result.error.empty())
+            {
+                ++summary.errors;
+                summary.lastError = result.error;
+                continue;
+            }
+
+            ++summary.runs;
+            summary.ttftMs += result.ttftMs;
+            summary.tokensPerSecond += result.tokensPerSecond;
+            summary.outputTokens += result.outputTokens;
+            summary.peakResidentBytes = std::max(summary.peakResidentBytes, result.peakResidentBytes);
+            summary.modelWeightsBytes = std::max(summary.modelWeightsBytes, result.modelWeightsBytes);
+        }
+
+        for (auto& [key, summary] : summaries)
+        {
+            if (summary.runs > 0)
+            {
+                summary.ttftMs /= summary.runs;
+                summary.tokensPerSecond /= summary.runs;
+                summary.outputTokens /= summary.runs;
+            }
+        }
+        return summaries;
+    }
+
+    inline void renderSelection(ViewState& state)
+    {
+        std::shared_ptr<const Model::ModelCatalogSnapshot> catalog = Model::ModelManager::getInstance().getCatalogSnapshot();
+        const std::vector<Model::ModelCardView>& models = catalog->models;
+
+        ImGui::TextUnformatted("Models");
+        ImGui::BeginChild("##benchmarkModels", ImVec2(ImGui::GetContentRegionAvail().x * 0.6F, 120.0F), true);
+        for (size_t i = 0; i < models.size(); ++i)
+        {
+            for (size_t kind = 0; kind < Model::VARIANT_KIND_COUNT; ++kind)
+            {
+                // Only downloaded variants can be measured
+                if (!models[i].variants[kind].isDownloaded)
+                {
+                    continue;
+                }
+
+                const char* variantType = Model::getVariantTypeName(static_cast<Model::VariantKind>(kind));
+                std::pair<std::string, std::string> target{ models[i].name, variantType };
+                bool selected = state.selectedTargets.count(target) > 0;
+                std::string label = models[i].name + " - " + variantType;
+                if (ImGui::Checkbox(label.c_str(), &selected))
+                {
+                    if (selected)
+                        state.selectedTargets.insert(target);
+                    else
+                        state.selectedTargets.erase(target);
+                }
+            }
+        }
+        ImGui::EndChild();
+
+        ImGui::SameLine();
+
+        ImGui::BeginGroup();
+        ImGui::TextUnformatted("Presets");
+        ImGui::BeginChild("##benchmarkPresets", ImVec2(0, 120.0F), true);
+        for (const auto& preset : Model::PresetManager::getInstance().getPresets())
+        {
+            bool selected = state.selectedPresets.count(preset.name) > 0;
+            if (ImGui::Checkbox(preset.name.c_str(), &selected))
+            {
+                if (selected)
+                    state.selectedPresets.insert(preset.name);
+                else
+                    state.selectedPresets.erase(preset.name);
+            }
+        }
+        ImGui::EndChild();
+        ImGui::EndGroup();
+    }
+
+    inline void renderControls(ViewState& state)
+    {
+        Model::BenchmarkRunner& runner = Model::BenchmarkRunner::getInstance();
+        const bool running = runner.isRunning();
+
+        std::vector<ButtonConfig> buttons;
+
+        ButtonConfig runButton;
+        runButton.id = "##runBenchmark";
+        runButton.label = running ? "Cancel" : "Run";
+        runButton.icon = running ? ICON_CI_CLOSE : ICON_CI_DEBUG_START;
+        runButton.size = ImVec2(100, 0);
+        runButton.backgroundColor = RGBAToImVec4(26, 95, 180, 255);
+        runButton.hoverColor = RGBAToImVec4(53, 132, 228, 255);
+        runButton.activeColor = RGBAToImVec4(26, 95, 180, 255);
+        if (!running && (state.selectedTargets.empty() || state.selectedPresets.empty()))
+        {
+            runButton.state = ButtonState::DISABLED;
+            runButton.tooltip = "Select at least one model and one preset";
+        }
+        runButton.onClick = [&state, &runner, running]()
+            {
+                if (running)
+                {
+                    runner.cancel();
+                    return;
+                }
+
+                std::vector<Model::BenchmarkTarget> targets;
+                for (const auto& [modelName, variantType] : state.selectedTargets)
+                {
+                    targets.push_back({ modelName, variantType });
+                }
+                std::vector<std::string> presetNames(state.selectedPresets.begin(), state.selectedPresets.end());
+
+                if (runner.start(Model::BenchmarkRunner::loadPrompts(), targets, presetNames))
+                {
+                    state.selectedRun = -1;
+                    state.loadedRun.reset();
+                }
+            };
+        buttons.push_back(runButton);
+
+        Button::renderGroup(buttons, ImGui::GetCursorPosX(), ImGui::GetCursorPosY());
+
+        if (running)
+        {
+            ImGui::SameLine();
+            const size_t total = std::max<size_t>(runner.getTotalCount(), 1);
+            char overlay[64];
+            std::snprintf(overlay, sizeof(overlay), "%zu / %zu", runner.getCompletedCount(), total);
+            ImGui::ProgressBar(static_cast<float>(runner.getCompletedCount()) / total, ImVec2(-1, 0), overlay);
+        }
+        else
+        {
+            // Saved runs, for comparing against earlier measurements
+            if (state.wasRunning || state.savedRunsStale)
+            {
+                state.savedRuns = Model::BenchmarkRunner::listSavedRuns();
+                state.savedRunsStale = false;
+            }
+
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(-1);
+            std::string preview = state.selectedRun < 0 || state.selectedRun >= static_cast<int>(state.savedRuns.size())
+                ? "Latest run"
+                : state.savedRuns[state.selectedRun].filename().string();
+            if (ImGui::BeginCombo("##benchmarkSavedRuns", preview.c_str()))
+            {
+                if (ImGui::Selectable("Latest run", state.selectedRun < 0))
+                {
+                    state.selectedRun = -1;
+                    state.loadedRun.reset();
+                }
+                for (int i = 0; i < static_cast<int>(state.savedRuns.size()); ++i)
+                {
+                    if (ImGui::Selectable(state.savedRuns[i].filename().string().c_str(), state.selectedRun == i))
+                    {
+                        state.selectedRun = i;
+                        state.loadedRun = Model::BenchmarkRunner::loadRun(state.savedRuns[i]);
+                    }
+                }
+                ImGui::EndCombo();
+            }
+        }
+
+        state.wasRunning = running;
+    }
+
+    inline void renderResultsTable(const Model::BenchmarkRun& run)
+    {
+        const ImGuiTableFlags flags = ImGuiTableFlags_Borders |
+            ImGuiTableFlags_RowBg |
+            ImGuiTableFlags_ScrollY |
+            ImGuiTableFlags_SizingStretchProp;
+
+        if (!ImGui::BeginTable("##benchmarkResults", 9, flags, ImGui::GetContentRegionAvail()))
+        {
+            return;
+        }
+
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Model");
+        ImGui::TableSetupColumn("Variant");
+        ImGui::TableSetupColumn("Preset");
+        ImGui::TableSetupColumn("TTFT (ms)");
+        ImGui::TableSetupColumn("Tokens/s");
+        ImGui::TableSetupColumn("Output tokens");
+        ImGui::TableSetupColumn("Peak RSS (MB)");
+        ImGui::TableSetupColumn("Weights (MB)");
+        ImGui::TableSetupColumn("Runs");
+        ImGui::TableHeadersRow();
+
+        for (const auto& [key, summary] : summarize(run))
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(std::get<0>(key).c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(std::get<1>(key).c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(std::get<2>(key).c_str());
+
+            if (summary.runs > 0)
+            {
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", summary.ttftMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", summary.tokensPerSecond);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", summary.outputTokens);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", Profiling::MemoryTracker::toMiB(static_cast<int64_t>(summary.peakResidentBytes)));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", Profiling::MemoryTracker::toMiB(summary.modelWeightsBytes));
+            }
+            else
+            {
+                for (int column = 0; column < 5; ++column)
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::TextDisabled("-");
+                }
+            }
+
+            ImGui::TableNextColumn();
+            if (summary.errors > 0)
+            {
+                ImGui::Text("%d (%d failed)", summary.runs, summary.errors);
+                if (ImGui::IsItemHovered())
+                {
+                    ImGui::SetTooltip("%s", summary.lastError.c_str());
+                }
+            }
+            else
+            {
+                ImGui::Text("%d", summary.runs);
+            }
+        }
+
+        ImGui::EndTable();
+    }
+} // namespace BenchmarkView
+
+/**
+ * @brief Renders the benchmark modal: grid selection, run progress and the results table.
+ *
+ * Results are averaged over the prompt set per model variant and preset. Earlier runs are
+ * loaded from the saved result files for comparison.
+ */
+inline void renderBenchmarkModal(bool& openModal)
+{
+    ModalConfig modalConfig
+    {
+        "Benchmark",
+        "Benchmark",
+        ImVec2(Config::Benchmark::MODAL_WIDTH, Config::Benchmark::MODAL_HEIGHT),
+        []()
+        {
+            BenchmarkView::ViewState& state = BenchmarkView::getViewState();
+
+            BenchmarkView::renderSelection(state);
+            ImGui::Spacing();
+            BenchmarkView::renderControls(state);
+            ImGui::Spacing();
+
+            if (state.loadedRun.has_value())
+            {
+                BenchmarkView::renderResultsTable(state.loadedRun.value());
+            }
+            else
+            {
+                BenchmarkView::renderResultsTable(Model::BenchmarkRunner::getInstance().getLastRun());
+            }
+
+            // Keep the progress and live results moving without user input
+            if (Model::BenchmarkRunner::getInstance().isRunning())
+            {
+                ImGui::SetMaxWaitBeforeNextFrame(Config::PerformanceOverlay::THROUGHPUT_SAMPLE_INTERVAL);
+            }
+        },
+        openModal
+    };
+    modalConfig.padding = ImVec2(16.0F, 8.0F);
+
+    ModalWindow::render(modalConfig);
+}
@@ -4,71 +4,385 @@
 #include "config.hpp"
 #include "ui/widgets.hpp"
 #include "chat/chat_manager.hpp"
+#include "chat/chat_archive.hpp"
 
-inline void renderChatHistoryList(ImVec2 contentArea)
+#include <ctime>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/**
+ * @brief Chat names prepared for filtering, rebuilt only when the chat list changes.
+ *
+ * Lowercase names and tooltips are computed once per change of the list rather than per
+ * frame, and the filter is only re-run when its text or the list changes.
+ */
+class ChatHistoryIndex
 {
-    // Render chat history buttons scroll region
-    ImGui::BeginChild("ChatHistoryButtons", contentArea, false, ImGuiWindowFlags_NoScrollbar);
+public:
+    struct Entry
+    {
+        int id;
+        std::string name;
+        std::string lowerName;
+        std::string tooltip;
+    };
 
-    // Get sorted chats from ChatManager
-    const auto& chats = Chat::ChatManager::getInstance().getChats();
-    const auto currentChatName = Chat::ChatManager::getInstance().getCurrentChatName();
+    void update(const std::string& filter)
+    {
+        const uint64_t version = Chat::ChatManager::getInstance().getListVersion();
+        const bool listChanged = !m_built || version != m_version;
+        if (listChanged)
+        {
+            rebuild(version);
+        }
+        if (listChanged || filter != m_filter)
+        {
+            m_filter = filter;
+            refilter();
+        }
+    }
+
+    // Indices of the entries to show, in display order
+    const std::vector<size_t>& getMatches() const { return m_matches; }
+    const Entry& getEntry(size_t index) const { return m_entries[index]; }
+
+    /**
+     * @brief Scores a name against a filter, both lowercase. Every non-space filter character
+     * must appear in the name in order; runs of adjacent characters and characters starting a
+     * word score higher. Returns -1 if the name does not match.
+     */
+    static int fuzzyScore(const std::string& filter, const std::string& name)
+    {
+        int score = 0;
+        size_t position = 0;
+        size_t previous = std::string::npos;
+        for (char c : filter)
+        {
+            if (c == ' ')
+            {
+                continue;
+            }
+
+            const size_t found = name.find(c, position);
+            if (found == std::string::npos)
+            {
+                return -1;
+            }
+
+            score += 1;
+            if (previous != std::string::npos && found == previous + 1)
+            {
+                score += Config::ChatHistorySidebar::FUZZY_CONSECUTIVE_BONUS;
+            }
+            if (found == 0 || isWordSeparator(name[found - 1]))
+            {
+                score += Config::ChatHistorySidebar::FUZZY_WORD_START_BONUS;
+            }
+            if (previous == std::string::npos)
+            {
+                score -= static_cast<int>(std::min<size_t>(found, Config::ChatHistorySidebar::FUZZY_MAX_LEADING_PENALTY));
+            }
+
+            previous = found;
+            position = found + 1;
+        }
+        return score;
+    }
 
-    for (const auto& chat : chats)
+    static std::string toLower(const std::string& text)
     {
-        ButtonConfig chatButtonConfig;
-        chatButtonConfig.id = "##chat" + std::to_string(chat.id);
-        chatButtonConfig.label = chat.name;
-        chatButtonConfig.icon = ICON_CI_COMMENT;
-        chatButtonConfig.size = ImVec2(contentArea.x - 44, 0);
-        chatButtonConfig.gap = 10.0F;
-        chatButtonConfig.onClick = [chatName = chat.name]() {
-            Chat::ChatManager::getInstance().switchToChat(chatName);
-            };
-
-        // Set active state if this is the current chat
-        chatButtonConfig.state = (currentChatName && *currentChatName == chat.name)
-            ? ButtonState::ACTIVE
-            : ButtonState::NORMAL;
-
-        chatButtonConfig.alignment = Alignment::LEFT;
-
-        // Add tooltip showing last modified time
-        if (ImGui::IsItemHovered()) {
-            std::time_t time = static_cast<std::time_t>(chat.lastModified);
+        std::string lower(text);
+        for (char& c : lower)
+        {
+            if (c >= 'A' && c <= 'Z')
+            {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+        }
+        return lower;
+    }
+
+private:
+    void rebuild(uint64_t version)
+    {
+        KOLOSAL_TRACE_SCOPE("ChatHistoryIndex::rebuild", "ui");
+        std::vector<Chat::ChatSummary> summaries = Chat::ChatManager::getInstance().getChatSummaries();
+
+        m_entries.clear();
+        m_entries.reserve(summaries.size());
+        for (auto& summary : summaries)
+        {
+            std::time_t time = static_cast<std::time_t>(summary.lastModified);
             char timeStr[26];
+#ifdef _WIN32
             ctime_s(timeStr, sizeof(timeStr), &time);
-            ImGui::SetTooltip("Last modified: %s", timeStr);
+#else
+            ctime_r(&time, timeStr);
+#endif
+
+            std::string lowerName = toLower(summary.name);
+            m_entries.push_back({ summary.id, std::move(summary.name), std::move(lowerName),
+                std::string("Last modified: ") + timeStr });
         }
 
-        Button::render(chatButtonConfig);
+        m_version = version;
+        m_built = true;
+    }
 
-		// same line for delete button
-		ImGui::SameLine(contentArea.x - 38);
-		// Set position to be a bit to the right and up
-		ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 3);
+    // Best matches first; ties keep the most recent chat first
+    void refilter()
+    {
+        const std::string filter = toLower(m_filter);
+        m_matches.clear();
+        if (filter.find_first_not_of(' ') == std::string::npos)
+        {
+            for (size_t i = 0; i < m_entries.size(); ++i)
+            {
+                m_matches.push_back(i);
+            }
+            return;
+        }
 
-		// Delete button
-		ButtonConfig deleteButtonConfig;
-		deleteButtonConfig.id = "##delete" + std::to_string(chat.id);
-		deleteButtonConfig.icon = ICON_CI_TRASH;
-		deleteButtonConfig.size = ImVec2(24, 0);
-		deleteButtonConfig.alignment = Alignment::CENTER;
-		deleteButtonConfig.onClick = [chatName = chat.name]() {
-			Chat::ChatManager::getInstance().deleteChat(chatName);
-			};
-		deleteButtonConfig.tooltip = "Delete Chat";
+        m_scores.clear();
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+            const int score = fuzzyScore(filter, m_entries[i].lowerName);
+            if (score >= 0)
+            {
+                m_matches.push_back(i);
+                m_scores.push_back(score);
+            }
+        }
 
-		Button::render(deleteButtonConfig);
+        std::vector<size_t> order(m_matches.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+            [this](size_t a, size_t b) { return m_scores[a] > m_scores[b]; });
+        for (size_t& index : order)
+        {
+            index = m_matches[index];
+        }
+        m_matches.swap(order);
+    }
 
-        ImGui::Spacing();
+    static bool isWordSeparator(char c)
+    {
+        return c == ' ' || c == '_' || c == '-' || c == '.' || c == '(' || c == '/';
     }
 
+    std::vector<Entry> m_entries;
+    std::vector<size_t> m_matches;
+    std::vector<int> m_scores;
+    std::string m_filter;
+    uint64_t m_version = 0;
+    bool m_built = false;
+};
+
+inline void renderChatHistoryList(ImVec2 contentArea)
+{
+    static ChatHistoryIndex index;
+    static std::string filter;
+    static bool focusFilter = false;
+
+    InputFieldConfig filterConfig("##chatHistoryFilter", ImVec2(contentArea.x - 16, 0), filter, focusFilter);
+    filterConfig.placeholderText = "Search chats";
+    InputField::render(filterConfig);
+
+    ImGui::Spacing();
+
+    index.update(filter);
+
+    // Render chat history buttons scroll region
+    const float filterHeight = ImGui::GetFrameHeightWithSpacing() + ImGui::GetStyle().ItemSpacing.y;
+    ImGui::BeginChild("ChatHistoryButtons", ImVec2(contentArea.x, contentArea.y - filterHeight), false, ImGuiWindowFlags_NoScrollbar);
+
+    const auto currentChatName = Chat::ChatManager::getInstance().getCurrentChatName();
+    const auto generatingChatIds = Chat::ChatManager::getInstance().getGeneratingChatIds();
+    const std::vector<size_t>& matches = index.getMatches();
+
+    // Only the rows in view are submitted, so frame time does not grow with the chat count
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(matches.size()));
+    while (clipper.Step())
+    {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+        {
+            const ChatHistoryIndex::Entry& chat = index.getEntry(matches[row]);
+
+            const bool isGenerating = generatingChatIds.count(chat.id) > 0;
+
+            ButtonStyle chatButtonStyle;
+            chatButtonStyle.icon = isGenerating ? ICON_CI_LOADING : ICON_CI_COMMENT;
+            chatButtonStyle.gap = 10.0F;
+
+            // Set active state if this is the current chat
+            chatButtonStyle.state = (currentChatName && *currentChatName == chat.name)
+                ? ButtonState::ACTIVE
+                : ButtonState::NORMAL;
+
+            chatButtonStyle.alignment = Alignment::LEFT;
+            chatButtonStyle.tooltip = isGenerating ? "Generating a reply" : chat.tooltip.c_str();
+
+            if (Button::draw(makeWidgetId("##chat", chat.id), chat.name, ImVec2(contentArea.x - 44, 0), chatButtonStyle))
+            {
+                Chat::ChatManager::getInstance().switchToChat(chat.name);
+            }
+
+            // same line for delete button
+            ImGui::SameLine(contentArea.x - 38);
+            // Set position to be a bit to the right and up
+            ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 3);
+
+            // Delete button
+            ButtonStyle deleteButtonStyle;
+            deleteButtonStyle.icon = ICON_CI_TRASH;
+            deleteButtonStyle.alignment = Alignment::CENTER;
+            deleteButtonStyle.tooltip = "Delete Chat";
+
+            if (Button::draw(makeWidgetId("##delete", chat.id), {}, ImVec2(24, 0), deleteButtonStyle))
+            {
+                Chat::ChatManager::getInstance().deleteChat(chat.name);
+            }
+
+            ImGui::Spacing();
+        }
+    }
+    clipper.End();
+
     ImGui::EndChild();
 }
 
+/**
+ * @brief Exports all chats to, or imports them from, a passphrase-protected archive.
+ */
+inline void renderChatArchiveModal(bool& openModal)
+{
+    static std::string archivePath = Config::ChatArchive::DEFAULT_PATH;
+    static std::string passphrase;
+    static bool focusPathField = true;
+    static bool focusPassphraseField = false;
+    static Chat::ArchiveFormat format = Chat::ArchiveFormat::Jsonl;
+    static std::future<bool> pendingArchiveJob;
+
+    ModalConfig modalConfig
+    {
+        "Chat Archive",
+        "Export / Import Chats",
+        ImVec2(420, 250),
+        [&]()
+        {
+            Chat::ChatArchiver& archiver = Chat::ChatArchiver::getInstance();
+            const float fieldWidth = ImGui::GetWindowSize().x - 32.0F;
+
+            InputFieldConfig pathConfig("##archivePath", ImVec2(fieldWidth, 0), archivePath, focusPathField);
+            pathConfig.placeholderText = "Archive path";
+            InputField::render(pathConfig);
+
+            ImGui::Spacing();
+
+            InputFieldConfig passphraseConfig("##archivePassphrase", ImVec2(fieldWidth, 0), passphrase, focusPassphraseField);
+            passphraseConfig.placeholderText = "Passphrase";
+            passphraseConfig.flags = ImGuiInputTextFlags_Password;
+            InputField::render(passphraseConfig);
+
+            ImGui::Spacing();
+
+            // Record encoding used for exports; imports read it from the archive header
+            std::vector<ButtonConfig> formatButtons;
+
+            ButtonConfig jsonlButton;
+            jsonlButton.id = "##archiveFormatJsonl";
+            jsonlButton.label = "JSONL";
+            jsonlButton.size = ImVec2(80, 0);
+            jsonlButton.state = format == Chat::ArchiveFormat::Jsonl ? ButtonState::ACTIVE : ButtonState::NORMAL;
+            jsonlButton.onClick = []() { format = Chat::ArchiveFormat::Jsonl; };
+            formatButtons.push_back(jsonlButton);
+
+            ButtonConfig binaryButton;
+            binaryButton.id = "##archiveFormatBinary";
+            binaryButton.label = "Binary";
+            binaryButton.size = ImVec2(80, 0);
+            binaryButton.state = format == Chat::ArchiveFormat::Binary ? ButtonState::ACTIVE : ButtonState::NORMAL;
+            binaryButton.onClick = []() { format = Chat::ArchiveFormat::Binary; };
+            binaryButton.tooltip = "Smaller archives using CBOR encoding";
+            formatButtons.push_back(binaryButton);
+
+            Button::renderGroup(formatButtons, 16, ImGui::GetCursorPosY());
+
+            ImGui::Spacing();
+
+            std::vector<ButtonConfig> actionButtons;
+            const bool canStart = !archiver.isBusy() && !archivePath.empty() && !passphrase.empty();
+
+            ButtonConfig exportButton;
+            exportButton.id = "##exportChats";
+            exportButton.label = "Export";
+            exportButton.icon = ICON_CI_EXPORT;
+            exportButton.size = ImVec2(130, 0);
+            exportButton.backgroundColor = RGBAToImVec4(26, 95, 180, 255);
+            exportButton.hoverColor = RGBAToImVec4(53, 132, 228, 255);
+            exportButton.activeColor = RGBAToImVec4(26, 95, 180, 255);
+            exportButton.state = canStart ? ButtonState::NORMAL : ButtonState::DISABLED;
+            exportButton.onClick = []()
+                {
+                    pendingArchiveJob = Chat::ChatArchiver::getInstance().exportChats(archivePath, passphrase, format);
+                };
+            actionButtons.push_back(exportButton);
+
+            ButtonConfig importButton;
+            importButton.id = "##importChats";
+            importButton.label = "Import";
+            importButton.icon = ICON_CI_DESKTOP_DOWNLOAD;
+            importButton.size = ImVec2(130, 0);
+            importButton.backgroundColor = RGBAToImVec4(26, 95, 180, 255);
+            importButton.hoverColor = RGBAToImVec4(53, 132, 228, 255);
+            importButton.activeColor = RGBAToImVec4(26, 95, 180, 255);
+            importButton.state = canStart ? ButtonState::NORMAL : ButtonState::DISABLED;
+            importButton.onClick = []()
+                {
+                    pendingArchiveJob = Chat::ChatArchiver::getInstance().importChats(archivePath, passphrase);
+                };
+            actionButtons.push_back(importButton);
+
+            Button::renderGroup(actionButtons, 16, ImGui::GetCursorPosY());
+
+            ImGui::Spacing();
+
+            std::string status = archiver.getStatus();
+            if (archiver.isBusy() && archiver.getTotalCount() > 0)
+            {
+                status += " " + std::to_string(archiver.getProcessedCount()) + " / " +
+                    std::to_string(archiver.getTotalCount());
+            }
+
+            LabelConfig statusLabel;
+            statusLabel.id = "##archiveStatus";
+            statusLabel.label = status;
+            statusLabel.size = ImVec2(0, 0);
+            statusLabel.fontSize = FontsManager::SM;
+            statusLabel.alignment = Alignment::LEFT;
+            Label::render(statusLabel);
+
+            if (archiver.isBusy())
+            {
+                ImGui::SetMaxWaitBeforeNextFrame(Config::PerformanceOverlay::THROUGHPUT_SAMPLE_INTERVAL);
+            }
+        },
+        openModal
+    };
+    modalConfig.padding = ImVec2(16.0F, 8.0F);
+
+    ModalWindow::render(modalConfig);
+}
+
 inline void renderChatHistorySidebar(float& sidebarWidth)
 {
+    static bool openChatArchiveModal = false;
+
     ImGuiIO& io = ImGui::GetIO();
     const float sidebarHeight = io.DisplaySize.y - Config::TITLE_BAR_HEIGHT;
 
@@ -89,38 +403,47 @@ inline void renderChatHistorySidebar(float& sidebarWidth)
     ImVec2 currentSize = ImGui::GetWindowSize();
     sidebarWidth = currentSize.x;
 
-    LabelConfig labelConfig;
-    labelConfig.id = "##chathistory";
-    labelConfig.label = "Recents";
-    labelConfig.size = ImVec2(Config::Icon::DEFAULT_FONT_SIZE, 0);
-    labelConfig.iconPaddingX = 10.0F;
-	labelConfig.fontType = FontsManager::BOLD;
-    Label::render(labelConfig);
+    LabelStyle labelStyle;
+    labelStyle.size = ImVec2(Config::Icon::DEFAULT_FONT_SIZE, 0);
+    labelStyle.iconPaddingX = 10.0F;
+	labelStyle.fontType = FontsManager::BOLD;
+    Label::draw("Recents", labelStyle);
 
     // Calculate label height
-    ImVec2 labelSize = ImGui::CalcTextSize(labelConfig.label.c_str());
+    ImVec2 labelSize = ImGui::CalcTextSize("Recents");
     float labelHeight = labelSize.y;
 
     // Button dimensions
     float buttonHeight = 24.0f;
 
-    ImGui::SameLine(ImGui::GetWindowContentRegionMax().x - 22);
+    ImGui::SameLine(ImGui::GetWindowContentRegionMax().x - 54);
     ImGui::SetCursorPosY(ImGui::GetCursorPosY() + ((labelHeight - buttonHeight) / 2.0f));
 
-    ButtonConfig createNewChatButtonConfig;
-    createNewChatButtonConfig.id = "##createNewChat";
-    createNewChatButtonConfig.icon = ICON_CI_ADD;
-    createNewChatButtonConfig.size = ImVec2(buttonHeight, 24);
-    createNewChatButtonConfig.onClick = []() {
+    ButtonStyle chatArchiveButtonStyle;
+    chatArchiveButtonStyle.icon = ICON_CI_ARCHIVE;
+    chatArchiveButtonStyle.alignment = Alignment::CENTER;
+    chatArchiveButtonStyle.tooltip = "Export / Import Chats";
+    if (Button::draw("##chatArchive", {}, ImVec2(buttonHeight, 24), chatArchiveButtonStyle))
+    {
+        openChatArchiveModal = true;
+    }
+
+    ImGui::SameLine();
+
+    ButtonStyle createNewChatButtonStyle;
+    createNewChatButtonStyle.icon = ICON_CI_ADD;
+    createNewChatButtonStyle.alignment = Alignment::CENTER;
+    if (Button::draw("##createNewChat", {}, ImVec2(buttonHeight, 24), createNewChatButtonStyle))
+    {
         Chat::ChatManager::getInstance().createNewChat(
             Chat::ChatManager::getDefaultChatName() + " " + std::to_string(Chat::ChatManager::getInstance().getChatsSize()));
-        };
-    createNewChatButtonConfig.alignment = Alignment::CENTER;
-    Button::render(createNewChatButtonConfig);
+    }
 
     ImGui::Spacing();
 
     renderChatHistoryList(ImVec2(sidebarWidth, sidebarHeight - labelHeight));
 
+    renderChatArchiveModal(openChatArchiveModal);
+
     ImGui::End();
 }
\ No newline at end of file
@@ -4,13 +4,227 @@
 #include "config.hpp"
 #include "ui/widgets.hpp"
 #include "chat/chat_manager.hpp"
+#include "chat/attachment_processor.hpp"
 #include "model/preset_manager.hpp"
 #include "model/model_manager.hpp"
+#include "ui/benchmark_view.hpp"
+#include "ui/text_editor.hpp"
+#include "nfd.h"
 
 #include <iostream>
-#include <inference.h>
+#include <algorithm>
+#include <random>
+#include <filesystem>
+#include <limits>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <types.h>
+
+/**
+ * @brief Builds the completion request for the active path of a chat using the current preset.
+ */
+inline ChatCompletionParameters buildChatCompletionParameters(const Chat::ChatHistory& chat)
+{
+    const Model::ModelPreset& preset = Model::PresetManager::getInstance().getCurrentPreset().value().get();
+
+    // A trailing empty assistant message is the placeholder of a reply being regenerated
+    size_t promptLength = chat.messages.size();
+    if (promptLength > 0 && chat.messages.back().role == "assistant" && chat.messages.back().content.empty())
+    {
+        --promptLength;
+    }
+
+    // Turns covered by the chat's memory are sent as its summary
+    const size_t summarizedLength = preset.summarize_history ? std::min(chat.summarizedLength(), promptLength) : 0;
+
+    ChatCompletionParameters completionParams;
+    completionParams.messages.push_back({ "system", summarizedLength > 0
+        ? preset.systemPrompt + "\n\nSummary of the earlier conversation:\n" + chat.memory.summary
+        : preset.systemPrompt });
+    for (size_t i = summarizedLength; i < promptLength; ++i)
+    {
+        completionParams.messages.push_back({ chat.messages[i].role, chat.messages[i].content });
+    }
+
+    completionParams.randomSeed     = preset.random_seed;
+    completionParams.maxNewTokens   = static_cast<int>(preset.max_new_tokens);
+    completionParams.minLength      = static_cast<int>(preset.min_length);
+    completionParams.temperature    = preset.temperature;
+    completionParams.topP           = preset.top_p;
+    // TODO: add top_k to the completion parameters
+    // completionParams.topK        = preset.top_k;
+    completionParams.streaming      = true;
+    return completionParams;
+}
+
+/**
+ * @brief Starts generating the assistant reply to the current chat's active path.
+ *
+ * @param randomSeed Overrides the preset's seed, e.g. to get a different answer on regenerate.
+ */
+inline bool startAssistantResponse(std::optional<int> randomSeed = std::nullopt)
+{
+    auto& chatManager = Chat::ChatManager::getInstance();
+    auto currentChat = chatManager.getCurrentChat();
+    if (!currentChat.has_value())
+    {
+        std::cerr << "[ChatSection] No chat selected. Cannot start a response.\n";
+        return false;
+    }
+
+    ChatCompletionParameters completionParams = buildChatCompletionParameters(currentChat.value());
+    if (randomSeed.has_value())
+    {
+        completionParams.randomSeed = randomSeed.value();
+    }
+
+    // Route the job to this chat before its first output arrives
+    const int chatId = currentChat.value().id;
+    const Model::ModelPreset& preset = Model::PresetManager::getInstance().getCurrentPreset().value().get();
+    int jobId = Model::ModelManager::getInstance().startChatCompletionJob(completionParams,
+        [&chatManager, chatId](const int submittedJobId) {
+            chatManager.setJobId(chatId, submittedJobId);
+        },
+        preset.stop_sequences);
+    return jobId >= 0;
+}
+
+// The message tree must not change under a reply that is still streaming into it
+inline bool canEditMessageTree()
+{
+    auto& chatManager = Chat::ChatManager::getInstance();
+    const std::optional<int> currentChatId = chatManager.getCurrentChatId();
+    return Model::ModelManager::getInstance().isModelReady() &&
+        !chatManager.isCurrentChatGenerating() &&
+        !(currentChatId.has_value() && Chat::AttachmentProcessor::getInstance().isProcessing(*currentChatId));
+}
+
+// File to send with the next message, empty if none
+inline std::string& getPendingAttachmentPath()
+{
+    static std::string path;
+    return path;
+}
+
+/**
+ * @brief Lets the user pick a text file to attach to the next message.
+ */
+inline void openAttachmentDialog()
+{
+    nfdu8char_t* outPath = nullptr;
+    nfdu8filteritem_t filters[2] = {
+        { "Text Documents", "txt,md,csv,tsv,json,log,xml,html,htm,rst,tex" },
+        { "Source Code", "c,cpp,h,hpp,cs,java,js,ts,py,go,rs,rb,php,sql,yaml,yml" } };
+
+    nfdopendialogu8args_t args;
+    memset(&args, 0, sizeof(nfdopendialogu8args_t));
+    args.filterList = filters;
+    args.filterCount = 2;
+
+    nfdresult_t result = NFD_OpenDialogU8_With(&outPath, &args);
+    if (result == NFD_OKAY)
+    {
+        getPendingAttachmentPath() = outPath;
+        NFD_FreePathU8(outPath);
+    }
+    else if (result == NFD_ERROR)
+    {
+        std::cerr << "[ChatSection] Error from NFD: " << NFD_GetError() << std::endl;
+    }
+}
+
+/**
+ * @brief Replaces the assistant reply at pathIndex with a freshly sampled sibling.
+ *
+ * The prompt up to the preceding user turn is resubmitted unchanged, so the engine keeps its
+ * evaluated state for it and only decodes the new answer.
+ */
+inline void regenerateResponse(size_t pathIndex)
+{
+    if (!canEditMessageTree())
+    {
+        return;
+    }
+
+    // Empty placeholder; the streaming callback fills it in as tokens arrive, and finishJob
+    // drops it again if none do
+    auto& chatManager = Chat::ChatManager::getInstance();
+    Chat::Message placeholder;
+    placeholder.role = "assistant";
+    if (chatManager.forkCurrentChat(pathIndex, placeholder) == 0)
+    {
+        return;
+    }
+
+    static std::mt19937 seedGenerator{ std::random_device{}() };
+    std::uniform_int_distribution<int> seedDistribution(0, std::numeric_limits<int>::max());
+    if (!startAssistantResponse(seedDistribution(seedGenerator)))
+    {
+        if (auto chatId = chatManager.getCurrentChatId())
+        {
+            chatManager.discardEmptyReply(*chatId);
+        }
+    }
+}
+
+struct MessageEditState
+{
+    bool open = false;
+    size_t pathIndex = 0;
+    TextEditorState editor;     // no size limit, so long messages are edited whole
+};
+
+inline MessageEditState& getMessageEditState()
+{
+    static MessageEditState state;
+    return state;
+}
+
+struct ChatSnapshot
+{
+    std::optional<Chat::ChatHistory> chat;
+    std::unordered_map<int, std::vector<int>> childIndex;   // sibling lookups, empty until the chat branches
+    Chat::ChatRevision revision;
+};
+
+/**
+ * @brief The open chat as of this frame, copied from the chat manager only after it changed.
+ *
+ * A long conversation would otherwise be copied, and its branches indexed, on every frame
+ * just to be drawn. Changes to other chats are ignored, and while a reply streams only its
+ * text is copied into the snapshot.
+ */
+inline const ChatSnapshot& getCurrentChatSnapshot()
+{
+    static ChatSnapshot snapshot;
+
+    // Read before copying, so a change made meanwhile is picked up on the next frame
+    auto& chatManager = Chat::ChatManager::getInstance();
+    const Chat::ChatRevision revision = chatManager.getCurrentChatRevision();
+    if (revision == snapshot.revision)
+    {
+        return snapshot;
+    }
+
+    const bool replyOnly = revision.chatId == snapshot.revision.chatId
+        && revision.content == snapshot.revision.content
+        && snapshot.chat.has_value() && !snapshot.chat->messages.empty();
+    if (!replyOnly || !chatManager.copyTrailingReply(revision.chatId, snapshot.chat->messages.back()))
+    {
+        snapshot.chat = chatManager.getCurrentChat();
+        snapshot.childIndex.clear();
+        if (snapshot.chat.has_value() && !snapshot.chat->branches.empty())
+        {
+            snapshot.childIndex = snapshot.chat->buildChildIndex();
+        }
+    }
+    snapshot.revision = revision;
+    return snapshot;
+}
 
-inline void pushIDAndColors(const Chat::Message msg, int index)
+inline void pushIDAndColors(const Chat::Message& msg, int index)
 {
     ImGui::PushID(index);
 
@@ -31,7 +245,7 @@ inline void pushIDAndColors(const Chat::Message msg, int index)
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0F, 1.0F, 1.0F, 1.0F)); // White text
 }
 
-inline auto calculateDimensions(const Chat::Message msg, float windowWidth) -> std::tuple<float, float, float>
+inline auto calculateDimensions(const Chat::Message& msg, float windowWidth) -> std::tuple<float, float, float>
 {
     float bubbleWidth = windowWidth * Config::Bubble::WIDTH_RATIO;
     float bubblePadding = Config::Bubble::PADDING;
@@ -46,7 +260,62 @@ inline auto calculateDimensions(const Chat::Message msg, float windowWidth) -> s
     return {bubbleWidth, bubblePadding, paddingX};
 }
 
-inline void renderMessageContent(const Chat::Message msg, float bubbleWidth, float bubblePadding)
+// Height of a message's bubble at the given content width
+inline float measureMessageHeight(const Chat::Message& msg, float contentWidth)
+{
+    auto [bubbleWidth, bubblePadding, paddingX] = calculateDimensions(msg, contentWidth);
+    ImVec2 textSize = ImGui::CalcTextSize(msg.content.c_str(), nullptr, true, bubbleWidth - bubblePadding * 2);
+    return textSize.y + bubblePadding * 2 + ImGui::GetTextLineHeightWithSpacing();
+}
+
+/**
+ * @brief Bubble heights of the open chat, measured once per message and content width.
+ *
+ * Wrapping a long conversation's text on every frame costs more than drawing the few
+ * bubbles in view; a message is measured again only if its text length changes. The last
+ * message, which replies stream into, is always measured again.
+ */
+class MessageHeightCache
+{
+public:
+    void update(const Chat::ChatHistory& chat, float contentWidth)
+    {
+        const std::vector<Chat::Message>& messages = chat.messages;
+        if (chat.id != m_chatId || contentWidth != m_width)
+        {
+            m_chatId = chat.id;
+            m_width = contentWidth;
+            m_entries.clear();
+        }
+        m_entries.resize(messages.size());
+
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            Entry& entry = m_entries[i];
+            const Chat::Message& msg = messages[i];
+            if (entry.id != msg.id || entry.length != msg.content.size() || i + 1 == messages.size())
+            {
+                entry = { msg.id, msg.content.size(), measureMessageHeight(msg, contentWidth) };
+            }
+        }
+    }
+
+    float getHeight(size_t index) const { return m_entries[index].height; }
+
+private:
+    struct Entry
+    {
+        int id = -1;
+        size_t length = 0;
+        float height = 0.0F;
+    };
+
+    int m_chatId = -1;
+    float m_width = -1.0F;
+    std::vector<Entry> m_entries;
+};
+
+inline void renderMessageContent(const Chat::Message& msg, float bubbleWidth, float bubblePadding)
 {
     ImGui::SetCursorPosX(bubblePadding);
     ImGui::SetCursorPosY(bubblePadding);
@@ -55,7 +324,7 @@ inline void renderMessageContent(const Chat::Message msg, float bubbleWidth, flo
     ImGui::PopTextWrapPos();
 }
 
-inline void renderTimestamp(const Chat::Message msg, float bubblePadding)
+inline void renderTimestamp(const Chat::Message& msg, float bubblePadding)
 {
     // Set timestamp color to a lighter gray
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.7F, 0.7F, 0.7F, 1.0F)); // Light gray for timestamp
@@ -75,7 +344,55 @@ inline void renderTimestamp(const Chat::Message msg, float bubblePadding)
     ImGui::PopStyleColor(); // Restore original text color
 }
 
-inline void renderButtons(const Chat::Message msg, int index, float bubbleWidth, float bubblePadding)
+inline void renderBranchNavigation(const Chat::Message& msg, int index, const std::vector<int>& siblingIds,
+    float bubblePadding, float buttonPosY, bool editable)
+{
+    auto position = std::find(siblingIds.begin(), siblingIds.end(), msg.id);
+    if (position == siblingIds.end())
+    {
+        return;
+    }
+    const size_t siblingIndex = static_cast<size_t>(position - siblingIds.begin());
+
+    std::optional<int> switchToSibling;
+    Button::Row row(bubblePadding, buttonPosY, 0.0F);
+
+    ButtonStyle previousButton;
+    previousButton.icon = ICON_CI_CHEVRON_LEFT;
+    previousButton.state = (editable && siblingIndex > 0) ? ButtonState::NORMAL : ButtonState::DISABLED;
+    if (row.draw("##previousBranch", {}, ImVec2(Config::Button::WIDTH, 0), previousButton))
+    {
+        switchToSibling = siblingIds[siblingIndex - 1];
+    }
+
+    char positionText[32];
+    const int positionLength = std::snprintf(positionText, sizeof(positionText), "%zu/%zu", siblingIndex + 1, siblingIds.size());
+
+    ButtonStyle positionLabel;
+    positionLabel.fontSize = FontsManager::SM;
+    positionLabel.hoverColor = Config::Color::TRANSPARENT_COL;
+    positionLabel.activeColor = Config::Color::TRANSPARENT_COL;
+    row.draw("##branchPosition", std::string_view(positionText, positionLength), ImVec2(Config::Button::WIDTH * 1.5F, 0), positionLabel);
+
+    ButtonStyle nextButton;
+    nextButton.icon = ICON_CI_CHEVRON_RIGHT;
+    nextButton.state = (editable && siblingIndex + 1 < siblingIds.size()) ? ButtonState::NORMAL : ButtonState::DISABLED;
+    if (row.draw("##nextBranch", {}, ImVec2(Config::Button::WIDTH, 0), nextButton))
+    {
+        switchToSibling = siblingIds[siblingIndex + 1];
+    }
+
+    if (switchToSibling)
+    {
+        Chat::ChatManager::getInstance().switchCurrentChatBranch(static_cast<size_t>(index), *switchToSibling);
+    }
+}
+
+/**
+ * @param editable Result of canEditMessageTree() for this frame, shared by every message.
+ */
+inline void renderButtons(const Chat::Message& msg, int index, float bubbleWidth, float bubblePadding,
+    const std::vector<int>* siblingIds = nullptr, bool isLastMessage = false, bool editable = false)
 {
     ImVec2 textSize = ImGui::CalcTextSize(msg.content.c_str(), nullptr, true, bubbleWidth - bubblePadding * 2);
     float buttonPosY = textSize.y + bubblePadding;
@@ -85,34 +402,61 @@ inline void renderButtons(const Chat::Message msg, int index, float bubbleWidth,
 		buttonPosY += 10;
 	}
 
-    ButtonConfig copyButtonConfig;
-    copyButtonConfig.id = "##copy" + std::to_string(index);
-    copyButtonConfig.label = std::nullopt;
-    copyButtonConfig.icon = ICON_CI_COPY;
-    copyButtonConfig.size = ImVec2(Config::Button::WIDTH, 0);
-    copyButtonConfig.onClick = [&index]()
+    // Regenerate or edit, then copy, right-aligned in the bubble
+    const bool canEdit = msg.role == "user";
+    const bool canRegenerate = msg.role == "assistant" && isLastMessage;
+    const int buttonCount = (canEdit || canRegenerate) ? 2 : 1;
+    const float groupWidth = buttonCount * Config::Button::WIDTH +
+        (buttonCount - 1) * Config::Button::SPACING;
+    Button::Row row(bubbleWidth - bubblePadding - groupWidth, buttonPosY);
+
+    if (canRegenerate)
+    {
+        ButtonStyle regenerateButton;
+        regenerateButton.icon = ICON_CI_REFRESH;
+        regenerateButton.tooltip = "Regenerate response";
+        regenerateButton.state = editable ? ButtonState::NORMAL : ButtonState::DISABLED;
+        if (row.draw("##regenerate", {}, ImVec2(Config::Button::WIDTH, 0), regenerateButton))
         {
-			Chat::ChatHistory chatHistory = Chat::ChatManager::getInstance().getCurrentChat().value();
-			const Chat::Message& msg = chatHistory.messages[index];
-            ImGui::SetClipboardText(msg.content.c_str());
-        };
-    std::vector<ButtonConfig> userButtons = { copyButtonConfig };
-
-    Button::renderGroup(
-        userButtons,
-        bubbleWidth - bubblePadding - Config::Button::WIDTH,
-        buttonPosY);
+            regenerateResponse(static_cast<size_t>(index));
+        }
+    }
+
+    if (canEdit)
+    {
+        ButtonStyle editButton;
+        editButton.icon = ICON_CI_EDIT;
+        editButton.tooltip = "Edit message";
+        editButton.state = editable ? ButtonState::NORMAL : ButtonState::DISABLED;
+        if (row.draw("##edit", {}, ImVec2(Config::Button::WIDTH, 0), editButton))
+        {
+            MessageEditState& editState = getMessageEditState();
+            editState.open = true;
+            editState.pathIndex = static_cast<size_t>(index);
+            TextEditor::setText(editState.editor, msg.content);
+        }
+    }
+
+    ButtonStyle copyButton;
+    copyButton.icon = ICON_CI_COPY;
+    if (row.draw("##copy", {}, ImVec2(Config::Button::WIDTH, 0), copyButton))
+    {
+        ImGui::SetClipboardText(msg.content.c_str());
+    }
+
+    if (siblingIds != nullptr && siblingIds->size() > 1)
+    {
+        renderBranchNavigation(msg, index, *siblingIds, bubblePadding, buttonPosY, editable);
+    }
 }
 
-inline void renderMessage(const Chat::Message &msg, int index, float contentWidth)
+inline void renderMessage(const Chat::Message &msg, int index, float contentWidth, float estimatedHeight,
+    const std::vector<int>* siblingIds = nullptr, bool isLastMessage = false, bool editable = false)
 {
     pushIDAndColors(msg, index);
     float windowWidth = contentWidth;
     auto [bubbleWidth, bubblePadding, paddingX] = calculateDimensions(msg, windowWidth);
 
-    ImVec2 textSize = ImGui::CalcTextSize(msg.content.c_str(), nullptr, true, bubbleWidth - bubblePadding * 2);
-    float estimatedHeight = textSize.y + bubblePadding * 2 + ImGui::GetTextLineHeightWithSpacing();
-
     ImGui::SetCursorPosX(paddingX);
 
     if (msg.role == "user")
@@ -122,7 +466,7 @@ inline void renderMessage(const Chat::Message &msg, int index, float contentWidt
 
     ImGui::BeginGroup();
     ImGui::BeginChild(
-        ("MessageCard" + std::to_string(index)).c_str(),
+        makeWidgetId("MessageCard", index),
         ImVec2(bubbleWidth, estimatedHeight),
         false,
         ImGuiWindowFlags_NoScrollbar);
@@ -130,7 +474,7 @@ inline void renderMessage(const Chat::Message &msg, int index, float contentWidt
     renderMessageContent(msg, bubbleWidth, bubblePadding);
     ImGui::Spacing();
     renderTimestamp(msg, bubblePadding);
-    renderButtons(msg, index, bubbleWidth, bubblePadding);
+    renderButtons(msg, index, bubbleWidth, bubblePadding, siblingIds, isLastMessage, editable);
 
     ImGui::EndChild();
     ImGui::EndGroup();
@@ -145,7 +489,8 @@ inline void renderMessage(const Chat::Message &msg, int index, float contentWidt
     ImGui::Spacing();
 }
 
-inline void renderChatHistory(const Chat::ChatHistory chatHistory, float contentWidth)
+inline void renderChatHistory(const Chat::ChatHistory& chatHistory,
+    const std::unordered_map<int, std::vector<int>>& childIndex, float contentWidth)
 {
     static size_t lastMessageCount = 0;
     size_t currentMessageCount = chatHistory.messages.size();
@@ -158,11 +503,28 @@ inline void renderChatHistory(const Chat::ChatHistory chatHistory, float content
     float scrollMaxY = ImGui::GetScrollMaxY();
     bool isAtBottom = (scrollMaxY <= 0.0F) || (scrollY >= scrollMaxY - 1.0F);
 
-    // Render messages
+    // Checked once per frame; it takes the chat and job locks
+    const bool editable = canEditMessageTree();
+
+    static MessageHeightCache heights;
+    heights.update(chatHistory, contentWidth);
+
+    // Render messages; those outside the view only take up their space
     const std::vector<Chat::Message> &messages = chatHistory.messages;
     for (size_t i = 0; i < messages.size(); ++i)
     {
-        renderMessage(messages[i], static_cast<int>(i), contentWidth);
+        const float height = heights.getHeight(i);
+        if (!ImGui::IsRectVisible(ImVec2(contentWidth, height)))
+        {
+            ImGui::Dummy(ImVec2(contentWidth, height));
+            ImGui::Spacing();
+            continue;
+        }
+
+        auto siblings = childIndex.find(messages[i].parentId);
+        renderMessage(messages[i], static_cast<int>(i), contentWidth, height,
+            siblings != childIndex.end() ? &siblings->second : nullptr,
+            i + 1 == messages.size(), editable);
     }
 
     // If the user was at the bottom and new messages were added, scroll to bottom
@@ -220,15 +582,98 @@ inline void renderRenameChatDialog(bool &showRenameChatDialog)
     ModalWindow::render(modalConfig);
 }
 
+/**
+ * @brief Edits a user message by branching the conversation at it and regenerating the reply.
+ *
+ * The original message and everything after it stay reachable through the branch navigation.
+ */
+inline void renderEditMessageDialog()
+{
+    MessageEditState& editState = getMessageEditState();
+    ModalConfig modalConfig
+    {
+        "Edit Message",
+        "Edit Message",
+        ImVec2(500, 220),
+        [&editState]()
+        {
+            static bool focusEditField = true;
+
+            auto processInput = [&editState](const std::string& input)
+            {
+                if (canEditMessageTree())
+                {
+                    Chat::Message userMessage;
+                    userMessage.role = "user";
+                    userMessage.content = input;
+
+                    if (Chat::ChatManager::getInstance().forkCurrentChat(editState.pathIndex, userMessage) != 0)
+                    {
+                        startAssistantResponse();
+                    }
+                }
+                ImGui::CloseCurrentPopup();
+                focusEditField = true;
+            };
+
+            TextEditorConfig inputConfig(
+                "##editmessage",
+                ImVec2(ImGui::GetWindowSize().x - 32.0F, 150.0F),
+                editState.editor,
+                focusEditField);
+            inputConfig.placeholderText = "Press Enter to branch and resend (Shift+Enter for new line)";
+            inputConfig.processInput = processInput;
+            inputConfig.frameRounding = 5.0F;
+            TextEditor::render(inputConfig);
+        },
+        editState.open
+    };
+    modalConfig.padding = ImVec2(16.0F, 8.0F);
+
+    ModalWindow::render(modalConfig);
+}
+
+/**
+ * @brief One of the variant checkboxes of a model card. Does not allocate.
+ *
+ * @return true if the checkbox was clicked.
+ */
+inline bool renderVariantOption(const char* name, int card, bool checked, std::string_view label)
+{
+    // add left padding
+    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 4.0f);
+    ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 4.0f);
+
+    ButtonStyle checkbox;
+    checkbox.icon = checked ? ICON_CI_CHECK : ICON_CI_CLOSE;
+    if (!checked)
+    {
+        // TODO's workarounds for the button size issue
+        checkbox.textColor = RGBAToImVec4(34, 34, 34, 255);
+    }
+    checkbox.fontSize = FontsManager::SM;
+    checkbox.backgroundColor = RGBAToImVec4(34, 34, 34, 255);
+    const bool clicked = Button::draw(makeWidgetId(name, card), {}, ImVec2(24, 0), checkbox);
+
+    ImGui::SameLine(0.0f, 4.0f);
+
+    LabelStyle labelStyle;
+    labelStyle.fontSize = FontsManager::SM;
+    labelStyle.alignment = Alignment::LEFT;
+    ImGui::SetCursorPosY(ImGui::GetCursorPosY() - ImGui::GetTextLineHeight() / 4.0f + 2.0f);
+    Label::draw(label, labelStyle);
+    return clicked;
+}
+
 inline void renderModelManager(bool &openModal)
 {
     ImVec2 windowSize = ImGui::GetWindowSize();
     const float targetWidth = windowSize.x;
 
-    // Card constants
-    const float cardWidth = 200;
-    const float cardHeight = 220;
-    const float cardSpacing = 10.0f;
+    // Card constants, constexpr so the content callback below only captures numCards
+    constexpr float cardWidth = 200;
+    constexpr float cardHeight = 220;
+    constexpr float cardSpacing = 10.0f;
     const float cardUnit = cardWidth + cardSpacing;
     const float paddingTotal = 2 * 16.0F; // 16.0F is the default padding value defined in the ModalWindow::render function
 
@@ -252,23 +697,18 @@ inline void renderModelManager(bool &openModal)
         "Model Manager",
         "Model Manager",
         modalSize,
-        [numCards, cardSpacing, cardWidth, cardHeight, targetWidth]()
+        [numCards]()
         {
-            std::vector<Model::ModelData> models = Model::ModelManager::getInstance().getModels();
-            static std::vector<std::string> modelVariants;
-            if (modelVariants.empty())
-            {
-                for (int8_t i = 0; i < models.size(); i++)
-                {
-                    if (models[i].name == Model::ModelManager::getInstance().getCurrentModelName())
-                    {
-                        modelVariants.push_back(Model::ModelManager::getInstance().getCurrentVariantType());
-                        continue;
-                    }
+            // One snapshot per frame; the cards below read it without locking the manager
+            std::shared_ptr<const Model::ModelCatalogSnapshot> catalog = Model::ModelManager::getInstance().getCatalogSnapshot();
+            const std::vector<Model::ModelCardView>& models = catalog->models;
 
-					// Default to 8-bit quantized
-                    modelVariants.push_back("8-bit Quantized");
-                }
+            // Variant picked on each card, starting at the one in use or 8-bit quantized
+            static std::vector<Model::VariantKind> modelVariants;
+            while (modelVariants.size() < models.size())
+            {
+                const size_t i = modelVariants.size();
+                modelVariants.push_back(catalog->selectedModel == i ? catalog->selectedVariant : Model::VariantKind::Quantized8Bit);
             }
 
             for (size_t i = 0; i < models.size(); i++)
@@ -283,208 +723,102 @@ inline void renderModelManager(bool &openModal)
                 ImGui::PushStyleColor(ImGuiCol_ChildBg, RGBAToImVec4(26, 26, 26, 255));
                 ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 8.0F);
 
-                ImGui::BeginChild(("ModelCard" + std::to_string(i)).c_str(),
-                                  ImVec2(cardWidth, cardHeight), true);
+                const int card = static_cast<int>(i);
+                ImGui::BeginChild(makeWidgetId("ModelCard", card), ImVec2(cardWidth, cardHeight), true);
 
                 // Render author label
-                LabelConfig modelAuthorLabel;
-                modelAuthorLabel.id = "##modelAuthor" + std::to_string(i);
-                modelAuthorLabel.label = models[i].author;
-                modelAuthorLabel.size = ImVec2(0, 0);
+                LabelStyle modelAuthorLabel;
                 modelAuthorLabel.fontType = FontsManager::ITALIC;
                 modelAuthorLabel.alignment = Alignment::LEFT;
                 modelAuthorLabel.fontSize = FontsManager::SM;
-                Label::render(modelAuthorLabel);
-
-                // Get the height of the author label
-                float authorLabelHeight = ImGui::GetTextLineHeightWithSpacing();
+                Label::draw(models[i].author, modelAuthorLabel);
 
                 // Render model name label
-                LabelConfig modelNameLabel;
-                modelNameLabel.id = "##modelName" + std::to_string(i);
-                modelNameLabel.label = models[i].name;
-                modelNameLabel.size = ImVec2(0, 0);
+                LabelStyle modelNameLabel;
                 modelNameLabel.fontType = FontsManager::BOLD;
                 modelNameLabel.alignment = Alignment::LEFT;
-                Label::render(modelNameLabel);
-
-                // Get the height of the model name label
-                float modelNameLabelHeight = ImGui::GetTextLineHeightWithSpacing();
-
-                // Calculate the total height of the labels
-                float totalLabelHeight = authorLabelHeight + modelNameLabelHeight;
+                Label::draw(models[i].name, modelNameLabel);
 
-                // add left padding
-                ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 4.0f);
-                ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 4.0f);
-
-				ButtonConfig fullPrecisionButton;
-				fullPrecisionButton.id = "##useFullPrecision" + std::to_string(i);
-				if (modelVariants[i] == "Full Precision")
-				{
-					fullPrecisionButton.icon = ICON_CI_CHECK;
-				}
-				else
-				{
-					// TODO's workarounds for the button size issue
-					fullPrecisionButton.icon = ICON_CI_CLOSE;
-					fullPrecisionButton.textColor = RGBAToImVec4(34, 34, 34, 255);
-				}
-				fullPrecisionButton.fontSize = FontsManager::SM;
-				fullPrecisionButton.size = ImVec2(24, 0);
-				fullPrecisionButton.backgroundColor = RGBAToImVec4(34, 34, 34, 255);
-				fullPrecisionButton.onClick = [i, models]()
-					{
-						modelVariants[i] = "Full Precision";
-					};
-				Button::render(fullPrecisionButton);
-
-				// Get the height of the full precision checkbox button
-				float fullPrecisionHeight = ImGui::GetTextLineHeightWithSpacing();
-
-				ImGui::SameLine(0.0f, 4.0f);
-
-				// Render labels
-				LabelConfig fullPrecisionLabel;
-				fullPrecisionLabel.id = "##fullprecision" + std::to_string(i);
-				fullPrecisionLabel.label = "Use Full Precision";
-				fullPrecisionLabel.size = ImVec2(0, 0);
-				fullPrecisionLabel.fontType = FontsManager::REGULAR;
-				fullPrecisionLabel.fontSize = FontsManager::SM;
-				fullPrecisionLabel.alignment = Alignment::LEFT;
-				float fullPrecisionLabelOffsetY = (fullPrecisionButton.size.y - ImGui::GetTextLineHeight()) / 4.0f + 2.0f;
-				ImGui::SetCursorPosY(ImGui::GetCursorPosY() + fullPrecisionLabelOffsetY);
-				Label::render(fullPrecisionLabel);
-
-                ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 4.0f);
-                ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 4.0f);
-
-                // TODO: Check button rect size is bigger when no icon is present
-                //       make sure to adjust the size of the button accordingly     
-                
-				ButtonConfig use8bitButton;
-				use8bitButton.id = "##use8bit" + std::to_string(i);
-				if (modelVariants[i] == "8-bit Quantized")
-				{
-					use8bitButton.icon = ICON_CI_CHECK;
-				}
-				else
-				{
-					// TODO's workarounds for the button size issue
-					use8bitButton.icon = ICON_CI_CLOSE;
-					use8bitButton.textColor = RGBAToImVec4(34, 34, 34, 255);
-				}
-				use8bitButton.fontSize = FontsManager::SM;
-				use8bitButton.size = ImVec2(24, 0);
-				use8bitButton.backgroundColor = RGBAToImVec4(34, 34, 34, 255);
-				use8bitButton.onClick = [i, models]()
-					{
-						modelVariants[i] = "8-bit Quantized";
-					};
-				Button::render(use8bitButton);
-
-				// Get the height of the quantization checkbox button
-				float _8bitquantizationHeight = ImGui::GetTextLineHeightWithSpacing();
-
-				ImGui::SameLine(0.0f, 4.0f);
-
-				// Render labels
-				LabelConfig _8BitQuantizationLabel;
-				_8BitQuantizationLabel.id = "##8bitquantization" + std::to_string(i);
-				_8BitQuantizationLabel.label = "Use 8-bit quantization";
-				_8BitQuantizationLabel.size = ImVec2(0, 0);
-				_8BitQuantizationLabel.fontType = FontsManager::REGULAR;
-				_8BitQuantizationLabel.fontSize = FontsManager::SM;
-				_8BitQuantizationLabel.alignment = Alignment::LEFT;
-				float _8BitLabelOffsetY = (use8bitButton.size.y - ImGui::GetTextLineHeight()) / 4.0f + 2.0f;
-				ImGui::SetCursorPosY(ImGui::GetCursorPosY() + _8BitLabelOffsetY);
-				Label::render(_8BitQuantizationLabel);
-
-				// add left padding
-				ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 4.0f);
-				ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 4.0f);
-
-                ButtonConfig use4bitButton;
-                use4bitButton.id = "##use4bit" + std::to_string(i);
-                if (modelVariants[i] == "4-bit Quantized")
+                if (renderVariantOption("##useFullPrecision", card, modelVariants[i] == Model::VariantKind::FullPrecision, "Use Full Precision"))
                 {
-                    use4bitButton.icon = ICON_CI_CHECK;
+                    modelVariants[i] = Model::VariantKind::FullPrecision;
                 }
-                else
+                if (renderVariantOption("##use8bit", card, modelVariants[i] == Model::VariantKind::Quantized8Bit, "Use 8-bit quantization"))
                 {
-                    // TODO's workarounds for the button size issue
-                    use4bitButton.icon = ICON_CI_CLOSE;
-                    use4bitButton.textColor = RGBAToImVec4(34, 34, 34, 255);
+                    modelVariants[i] = Model::VariantKind::Quantized8Bit;
+                }
+                if (renderVariantOption("##use4bit", card, modelVariants[i] == Model::VariantKind::Quantized4Bit, "Use 4-bit quantization"))
+                {
+                    modelVariants[i] = Model::VariantKind::Quantized4Bit;
                 }
-                use4bitButton.fontSize = FontsManager::SM;
-                use4bitButton.size = ImVec2(24, 0);
-                use4bitButton.backgroundColor = RGBAToImVec4(34, 34, 34, 255);
-                use4bitButton.onClick = [i, models]()
-                    {
-						modelVariants[i] = "4-bit Quantized";
-                    };
-                Button::render(use4bitButton);
 
                 // Get the height of the quantization checkbox button
                 float _4BitQantizationHeight = ImGui::GetTextLineHeightWithSpacing();
 
-                ImGui::SameLine(0.0f, 4.0f);
-
-                // Render labels
-                LabelConfig _4BitQuantizationLabel;
-                _4BitQuantizationLabel.id = "##quantization" + std::to_string(i);
-                _4BitQuantizationLabel.label = "Use 4-bit quantization";
-                _4BitQuantizationLabel.size = ImVec2(0, 0);
-                _4BitQuantizationLabel.fontType = FontsManager::REGULAR;
-                _4BitQuantizationLabel.fontSize = FontsManager::SM;
-                _4BitQuantizationLabel.alignment = Alignment::LEFT;
-                float labelOffsetY = (use4bitButton.size.y - ImGui::GetTextLineHeight()) / 4.0f + 2.0f;
-                ImGui::SetCursorPosY(ImGui::GetCursorPosY() + labelOffsetY);
-                Label::render(_4BitQuantizationLabel);
-
                 // Render select button at the bottom of the card
-				ImGui::SetCursorPosY(cardHeight - 35);
+                ImGui::SetCursorPosY(cardHeight - 35);
 
-                bool isSelected = models[i].name == Model::ModelManager::getInstance().getCurrentModelName() &&
-                                  modelVariants[i] == Model::ModelManager::getInstance().getCurrentVariantType();
-                bool isDownloaded = Model::ModelManager::getInstance().isModelDownloaded(i, modelVariants[i]);
+                const Model::VariantView& variant = models[i].getVariant(modelVariants[i]);
+                bool isSelected = catalog->isSelected(i, modelVariants[i]);
+                bool isDownloaded = variant.isDownloaded;
 
-                ButtonConfig selectButton;
-                selectButton.size = ImVec2(cardWidth - 18, 0);
+                ButtonStyle selectButton;
+                ImVec2 selectButtonSize(cardWidth - 18, 0);
+                const char* selectId = "##select";
+                std::string_view selectLabel;
+                char issueTooltip[256];
+                bool canQuantize = false;
 
                 if (!isDownloaded)
                 {
-                    selectButton.id = "##download" + std::to_string(i);
-                    selectButton.label = "Download";
+                    selectId = "##download";
+                    selectLabel = "Download";
                     selectButton.backgroundColor = RGBAToImVec4(26, 95, 180, 255);
                     selectButton.hoverColor = RGBAToImVec4(53, 132, 228, 255);
                     selectButton.activeColor = RGBAToImVec4(26, 95, 180, 255);
                     selectButton.icon = ICON_CI_CLOUD_DOWNLOAD;
                     selectButton.borderSize = 1.0F;
 
-                    selectButton.onClick = [i, models]()
+                    // Point out what the integrity scan found instead of a plain download
+                    if (const auto& issue = variant.integrityIssue)
                     {
-                        Model::ModelManager::getInstance().downloadModel(i, modelVariants[i]);
-                    };
+                        const bool resumable = issue->status == Model::GgufIntegrity::Truncated;
+                        selectLabel = resumable ? "Resume download" : "Download again";
+                        std::snprintf(issueTooltip, sizeof(issueTooltip), resumable
+                            ? "The download was interrupted (%s)"
+                            : "The downloaded file was damaged (%s) and has been removed", issue->message.c_str());
+                        selectButton.tooltip = issueTooltip;
+                    }
 
-                    if (Model::ModelManager::getInstance().getModelDownloadProgress(i, modelVariants[i]) > 0.0)
+                    if (variant.downloadProgress > 0.0)
                     {
-                        selectButton.label = "Downloading";
-                        selectButton.icon = ICON_CI_CLOUD_DOWNLOAD;
+                        bool isQuantizing = variant.isQuantizing;
+                        selectLabel = isQuantizing ? "Quantizing" : "Downloading";
+                        selectButton.icon = isQuantizing ? ICON_CI_SERVER_PROCESS : ICON_CI_CLOUD_DOWNLOAD;
                         selectButton.state = ButtonState::DISABLED;
 
+                        // Quantization progress comes from local work, not network events, so keep redrawing
+                        if (isQuantizing)
+                        {
+                            ImGui::SetMaxWaitBeforeNextFrame(Config::PerformanceOverlay::THROUGHPUT_SAMPLE_INTERVAL);
+                        }
+
                         ImGui::SetCursorPosY(ImGui::GetCursorPosY() - _4BitQantizationHeight - 6);
 
                         // Add a progress bar
-                        ImGui::ProgressBar(
-                            Model::ModelManager::getInstance().getModelDownloadProgress(i, modelVariants[i]) / 100.0,
-                            ImVec2(cardWidth - 18, 0));
+                        ImGui::ProgressBar(variant.downloadProgress / 100.0, ImVec2(cardWidth - 18, 0));
+                    }
+                    else if (modelVariants[i] != Model::VariantKind::FullPrecision &&
+                             models[i].getVariant(Model::VariantKind::FullPrecision).isDownloaded)
+                    {
+                        // The full-precision file is already here; offer converting it next to the download
+                        canQuantize = true;
+                        selectButtonSize.x -= 28;
                     }
                 }
                 else
                 {
-                    selectButton.id = "##select" + std::to_string(i);
-                    selectButton.label = isSelected ? "selected" : "select";
+                    selectLabel = isSelected ? "selected" : "select";
                     selectButton.backgroundColor = RGBAToImVec4(34, 34, 34, 255);
                     if (isSelected)
                     {
@@ -493,17 +827,37 @@ inline void renderModelManager(bool &openModal)
                         selectButton.borderSize = 1.0F;
                         selectButton.state = ButtonState::ACTIVE;
                     }
+                }
 
-                    selectButton.onClick = [i, models]()
+                if (Button::draw(makeWidgetId(selectId, card), selectLabel, selectButtonSize, selectButton))
+                {
+                    Model::ModelManager& modelManager = Model::ModelManager::getInstance();
+                    if (isDownloaded)
                     {
-                        Model::ModelManager::getInstance().switchModel(
-                            models[i].name,
-                            modelVariants[i]
-                        );
-                    };
+                        modelManager.switchModel(models[i].name, Model::getVariantTypeName(modelVariants[i]));
+                    }
+                    else
+                    {
+                        modelManager.downloadModel(i, Model::getVariantTypeName(modelVariants[i]));
+                    }
                 }
 
-                Button::render(selectButton);
+                if (canQuantize)
+                {
+                    ImGui::SameLine(0.0f, 4.0f);
+
+                    ButtonStyle quantizeButton;
+                    quantizeButton.icon = ICON_CI_SERVER_PROCESS;
+                    quantizeButton.backgroundColor = RGBAToImVec4(26, 95, 180, 255);
+                    quantizeButton.hoverColor = RGBAToImVec4(53, 132, 228, 255);
+                    quantizeButton.activeColor = RGBAToImVec4(26, 95, 180, 255);
+                    quantizeButton.borderSize = 1.0F;
+                    quantizeButton.tooltip = "Quantize the downloaded full precision model on this device";
+                    if (Button::draw(makeWidgetId("##quantize", card), {}, ImVec2(24, 0), quantizeButton))
+                    {
+                        Model::ModelManager::getInstance().quantizeModel(i, Model::getVariantTypeName(modelVariants[i]));
+                    }
+                }
 
                 ImGui::EndChild();
 
@@ -595,48 +949,98 @@ inline void renderChatFeatureButtons(const float startX = 0, const float startY
 {
     static bool openModelSelectionModal = false;
 	static bool openClearChatModal      = false;
+	static bool openBenchmarkModal      = false;
 
-    // Configure the button
-    std::vector<ButtonConfig> buttons;
+    Button::Row row(startX, startY);
 
-    std::string currentModelName = Model::ModelManager::getInstance()
-        .getCurrentModelName().value_or("Select Model");
+    const auto currentModelName = Model::ModelManager::getInstance().getCurrentModelName();
 
-    ButtonConfig openModelManager;
-    openModelManager.id = "##openModalButton";
-    openModelManager.label = currentModelName;
+    ButtonStyle openModelManager;
     openModelManager.icon = ICON_CI_SPARKLE;
-    openModelManager.size = ImVec2(128, 0);
     openModelManager.alignment = Alignment::LEFT;
-    openModelManager.onClick = [&]()
-    { openModelSelectionModal = true; };
-
-    buttons.push_back(openModelManager);
+    std::string modelLoadError; // the tooltip points into it until the button is drawn
+    if (currentModelName.has_value() && !Model::ModelManager::getInstance().isModelReady())
+    {
+        modelLoadError = Model::ModelManager::getInstance().getModelLoadError();
+        openModelManager.tooltip = modelLoadError.empty() ? "Loading model..." : modelLoadError.c_str();
+    }
+    if (row.draw("##openModalButton", currentModelName ? std::string_view(*currentModelName) : std::string_view("Select Model"),
+        ImVec2(128, 0), openModelManager))
+    {
+        openModelSelectionModal = true;
+    }
 
-	ButtonConfig clearChatButton;
-	clearChatButton.id = "##clearChatButton";
+	ButtonStyle clearChatButton;
 	clearChatButton.icon = ICON_CI_CLEAR_ALL;
-	clearChatButton.size = ImVec2(24, 0);
-	clearChatButton.alignment = Alignment::CENTER;
-	clearChatButton.onClick = []()
-		{
-			openClearChatModal = true;
-		};
 	clearChatButton.tooltip = "Clear Chat";
+	if (row.draw("##clearChatButton", {}, ImVec2(24, 0), clearChatButton))
+	{
+		openClearChatModal = true;
+	}
 
-	buttons.push_back(clearChatButton);
+	ButtonStyle benchmarkButton;
+	benchmarkButton.icon = ICON_CI_DASHBOARD;
+	benchmarkButton.tooltip = Model::BenchmarkRunner::getInstance().isRunning()
+		? "Benchmark (running)"
+		: "Benchmark";
+	if (row.draw("##benchmarkButton", {}, ImVec2(24, 0), benchmarkButton))
+	{
+		openBenchmarkModal = true;
+	}
+
+	// Attach a file, remove the attached one, or stop reading the one being processed
+	const std::optional<int> currentChatId = Chat::ChatManager::getInstance().getCurrentChatId();
+	auto& attachmentProcessor = Chat::AttachmentProcessor::getInstance();
+	std::string& attachmentPath = getPendingAttachmentPath();
+
+	ButtonStyle attachButton;
+	if (currentChatId.has_value() && attachmentProcessor.isProcessing(*currentChatId))
+	{
+		attachButton.icon = ICON_CI_DEBUG_STOP;
+		attachButton.tooltip = "Stop reading the attachment";
+		if (row.draw("##attachFileButton", {}, ImVec2(24, 0), attachButton))
+		{
+			attachmentProcessor.cancel(*currentChatId);
+		}
+	}
+	else if (!attachmentPath.empty())
+	{
+		// Shown as selected, but still clickable
+		const std::string_view fileName = std::string_view(attachmentPath).substr(attachmentPath.find_last_of("/\\") + 1);
+		attachButton.icon = ICON_CI_CLOSE;
+		attachButton.alignment = Alignment::LEFT;
+		attachButton.backgroundColor = attachButton.activeColor;
+		attachButton.tooltip = "Remove attachment";
+		if (row.draw("##attachFileButton", fileName, ImVec2(160, 0), attachButton))
+		{
+			attachmentPath.clear();
+		}
+	}
+	else
+	{
+		attachButton.icon = ICON_CI_ATTACH;
+		attachButton.tooltip = "Attach a file; it is read in parts, so it can be larger than the model's context";
+		if (row.draw("##attachFileButton", {}, ImVec2(24, 0), attachButton))
+		{
+			openAttachmentDialog();
+		}
+	}
 
-    // Render the button using renderGroup
-    Button::renderGroup(buttons, startX, startY);
+	// Keep frames coming while the reply shows the progress of an attachment
+	if (attachmentProcessor.isBusy())
+	{
+		ImGui::SetMaxWaitBeforeNextFrame(Config::TokenStream::DRAIN_INTERVAL);
+	}
 
     // Open the modal window if the button was clicked
     renderModelManager(openModelSelectionModal);
 	renderClearChatModal(openClearChatModal);
+	renderBenchmarkModal(openBenchmarkModal);
 }
 
 inline void renderInputField(const float inputHeight, const float inputWidth)
 {
-    static std::string inputTextBuffer(Config::InputField::TEXT_SIZE, '\0');
+    static TextEditorState inputEditorState;
     static bool focusInputField = true;
 
     // Define the input size
@@ -662,62 +1066,61 @@ inline void renderInputField(const float inputHeight, const float inputWidth)
 			return;
 		}
 
+		// Wait for the model to finish loading and warming up
+		if (!Model::ModelManager::getInstance().isModelReady())
+		{
+			const std::string loadError = Model::ModelManager::getInstance().getModelLoadError();
+			std::cerr << "[ChatSection] " << (loadError.empty() ? std::string("Model is still loading") : loadError)
+				<< ". Cannot send message.\n";
+			return;
+		}
+
+		// Other chats may keep generating, but each chat streams one reply at a time
+		if (chatManager.isCurrentChatGenerating() ||
+			Chat::AttachmentProcessor::getInstance().isProcessing(currentChat->id))
+		{
+			std::cerr << "[ChatSection] A reply is still being generated in this chat.\n";
+			return;
+		}
+
+		// Attachments are read in parts on a worker; the answer streams in when they are done
+		std::string& attachmentPath = getPendingAttachmentPath();
+		if (!attachmentPath.empty())
+		{
+			const std::string fileName = std::filesystem::u8path(attachmentPath).filename().u8string();
+
+			Chat::Message userMessage;
+			userMessage.role = "user";
+			userMessage.content = input + "\n\n[Attached file: " + fileName + "]";
+			chatManager.addMessageToCurrentChat(userMessage);
+
+			Chat::AttachmentProcessor::getInstance().process(currentChat->id, attachmentPath, input);
+			attachmentPath.clear();
+			return;
+		}
+
         // Handle user message
         {
             Chat::Message userMessage;
-            userMessage.id = static_cast<int>(currentChat.value().messages.size()) + 1;
             userMessage.role = "user";
             userMessage.content = input;
 
-            // Add message directly to current chat
+            // Add message directly to current chat; the id and parent are assigned on insertion
             chatManager.addMessageToCurrentChat(userMessage);
         }
 
-        // Handle assistant response
-        // TODO: Implement assistant response through callback
-        {
-			Model::PresetManager& presetManager = Model::PresetManager::getInstance();
-			Model::ModelManager& modelManager = Model::ModelManager::getInstance();
-
-			// Prepare completion parameters
-            ChatCompletionParameters completionParams;
-            {
-                // push system prompt
-                completionParams.messages.push_back(
-                    { "system", presetManager.getCurrentPreset().value().get().systemPrompt.c_str()});
-                for (const auto& msg : currentChat.value().messages)
-                {
-                    completionParams.messages.push_back({ msg.role.c_str(), msg.content.c_str()});
-                }
-                // push user new message
-                completionParams.messages.push_back({ "user", input.c_str()});
-
-				// set the preset parameters
-                completionParams.randomSeed     = presetManager.getCurrentPreset().value().get().random_seed;
-                completionParams.maxNewTokens   = static_cast<int>(presetManager.getCurrentPreset().value().get().max_new_tokens);
-                completionParams.minLength      = static_cast<int>(presetManager.getCurrentPreset().value().get().min_length);
-                completionParams.temperature    = presetManager.getCurrentPreset().value().get().temperature;
-                completionParams.topP           = presetManager.getCurrentPreset().value().get().top_p;
-				// TODO: add top_k to the completion parameters
-				// completionParams.topK        = presetManager.getCurrentPreset().value().get().top_k;
-                completionParams.streaming      = true;
-            }
-            int jobId = modelManager.startChatCompletionJob(completionParams);
-
-			// track the job ID in the chat manager
-			chatManager.setCurrentJobId(jobId);
-        }
+        // Handle assistant response, streamed in through the model manager callback
+        startAssistantResponse();
     };
 
-    // input field settings
-    InputFieldConfig inputConfig(
+    // input field settings; the editor has no size limit, so long pastes are kept whole
+    TextEditorConfig inputConfig(
         "##chatinput",                                                           // ID
         ImVec2(inputSize.x, inputSize.y - Config::Font::DEFAULT_FONT_SIZE - 20), // Size (excluding button height)
-        inputTextBuffer,                                                         // Input text buffer
+        inputEditorState,                                                        // Text and cursor
         focusInputField);                                                        // Focus
     {
         inputConfig.placeholderText = "Type a message and press Enter to send (Ctrl+Enter or Shift+Enter for new line)";
-        inputConfig.flags = ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_CtrlEnterForNewLine | ImGuiInputTextFlags_ShiftEnterForNewLine;
         inputConfig.processInput = processInput;
     }
 
@@ -736,7 +1139,7 @@ inline void renderInputField(const float inputHeight, const float inputWidth)
     ImGui::BeginGroup();
 
     // Render the input field
-    InputField::renderMultiline(inputConfig);
+    TextEditor::render(inputConfig);
 
     {
         // Calculate position for feature buttons
@@ -787,22 +1190,23 @@ inline void renderChatWindow(float inputHeight, float leftSidebarWidth, float ri
     }
 
     // Render the rename button
-    ButtonConfig renameButtonConfig;
-    renameButtonConfig.id = "##renameChat";
-    renameButtonConfig.label = Chat::ChatManager::getInstance().getCurrentChatName();
-    renameButtonConfig.size = ImVec2(renameButtonWidth, 30);
-    renameButtonConfig.gap = 10.0F;
-    renameButtonConfig.onClick = []()
+    const auto currentChatName = Chat::ChatManager::getInstance().getCurrentChatName();
+    ButtonStyle renameButton;
+    renameButton.gap = 10.0F;
+    renameButton.alignment = Alignment::CENTER;
+    renameButton.hoverColor = ImVec4(0.1F, 0.1F, 0.1F, 0.5F);
+    if (Button::draw("##renameChat", currentChatName ? std::string_view(*currentChatName) : std::string_view(),
+        ImVec2(renameButtonWidth, 30), renameButton))
     {
         showRenameChatDialog = true;
-    };
-    renameButtonConfig.alignment = Alignment::CENTER;
-    renameButtonConfig.hoverColor = ImVec4(0.1F, 0.1F, 0.1F, 0.5F);
-    Button::render(renameButtonConfig);
+    }
 
     // Render the rename chat dialog
     renderRenameChatDialog(showRenameChatDialog);
 
+    // Render the edit message dialog, opened from a user message's edit button
+    renderEditMessageDialog();
+
     ImGui::Spacing();
     ImGui::Spacing();
     ImGui::Spacing();
@@ -819,7 +1223,8 @@ inline void renderChatWindow(float inputHeight, float leftSidebarWidth, float ri
     ImGui::BeginChild("ChatHistoryRegion", ImVec2(contentWidth, availableHeight), false, ImGuiWindowFlags_NoScrollbar);
 
     // Render chat history
-    renderChatHistory(Chat::ChatManager::getInstance().getCurrentChat().value(), contentWidth);
+    const ChatSnapshot& snapshot = getCurrentChatSnapshot();
+    renderChatHistory(snapshot.chat.value(), snapshot.childIndex, contentWidth);
 
     ImGui::EndChild(); // End of ChatHistoryRegion
 
@@ -6,6 +6,97 @@
 #include "config.hpp"
 #include "nfd.h"
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Stop sequences are edited one per line, with "\n" standing for a line break inside a sequence
+inline std::string formatStopSequences(const std::vector<std::string>& sequences)
+{
+    std::string text;
+    for (const std::string& sequence : sequences)
+    {
+        if (!text.empty())
+            text += '\n';
+        for (char c : sequence)
+        {
+            if (c == '\n')
+                text += "\\n";
+            else
+                text += c;
+        }
+    }
+    return text;
+}
+
+inline std::vector<std::string> parseStopSequences(const char* text)
+{
+    std::vector<std::string> sequences;
+    std::string sequence;
+    for (const char* c = text; ; ++c)
+    {
+        if (*c == '\0' || *c == '\n')
+        {
+            if (!sequence.empty())
+                sequences.push_back(std::move(sequence));
+            sequence.clear();
+            if (*c == '\0')
+                break;
+        }
+        else if (c[0] == '\\' && c[1] == 'n')
+        {
+            sequence += '\n';
+            ++c;
+        }
+        else
+        {
+            sequence += *c;
+        }
+    }
+    return sequences;
+}
+
+/**
+ * @brief Renders the stop sequences of a preset as a multiline field, one per line.
+ */
+inline void renderStopSequences(Model::ModelPreset& preset, const float inputWidth, const float paddingX = 5.0F)
+{
+    static char text[1024];
+    static std::vector<std::string> shownSequences;
+    static bool shown = false;
+
+    // Refill the field when the preset is switched or changed elsewhere
+    if (!shown || preset.stop_sequences != shownSequences)
+    {
+        const std::string formatted = formatStopSequences(preset.stop_sequences);
+        std::snprintf(text, sizeof(text), "%s", formatted.c_str());
+        shownSequences = preset.stop_sequences;
+        shown = true;
+    }
+
+    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + paddingX);
+    Label::draw("Stop sequences");
+    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + paddingX);
+
+    ImGui::PushStyleColor(ImGuiCol_FrameBg, Config::Color::SECONDARY);
+    ImGui::PushStyleColor(ImGuiCol_FrameBgHovered, Config::Color::SECONDARY);
+    ImGui::PushStyleColor(ImGuiCol_FrameBgActive, Config::Color::PRIMARY);
+    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 2.0F);
+
+    if (ImGui::InputTextMultiline("##stop_sequences", text, sizeof(text), ImVec2(inputWidth, 60)))
+    {
+        preset.stop_sequences = parseStopSequences(text);
+        shownSequences = preset.stop_sequences;
+    }
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::SetTooltip("One per line; write \\n for a line break, e.g. \\nUser:");
+    }
+
+    ImGui::PopStyleVar();
+    ImGui::PopStyleColor(3);
+}
+
 /**
  * @brief Renders the model settings sidebar with the specified width.
  *
@@ -16,13 +107,11 @@ void renderSamplingSettings(const float sidebarWidth)
     ImGui::Spacing();
     ImGui::Spacing();
 
-    LabelConfig labelConfig;
-    labelConfig.id = "##systempromptlabel";
-    labelConfig.label = "System Prompt";
-    labelConfig.icon = ICON_CI_GEAR;
-    labelConfig.size = ImVec2(Config::Icon::DEFAULT_FONT_SIZE, 0);
-    labelConfig.fontType = FontsManager::BOLD;
-    Label::render(labelConfig);
+    LabelStyle labelStyle;
+    labelStyle.icon = ICON_CI_GEAR;
+    labelStyle.size = ImVec2(Config::Icon::DEFAULT_FONT_SIZE, 0);
+    labelStyle.fontType = FontsManager::BOLD;
+    Label::draw("System Prompt", labelStyle);
 
     ImGui::Spacing();
     ImGui::Spacing();
@@ -58,13 +147,11 @@ void renderSamplingSettings(const float sidebarWidth)
     ImGui::Spacing();
 
     // Model settings label
-    LabelConfig modelSettingsLabelConfig;
-    modelSettingsLabelConfig.id = "##modelsettings";
-    modelSettingsLabelConfig.label = "Model Settings";
-    modelSettingsLabelConfig.icon = ICON_CI_SETTINGS;
-    modelSettingsLabelConfig.size = ImVec2(Config::Icon::DEFAULT_FONT_SIZE, 0);
-	modelSettingsLabelConfig.fontType = FontsManager::BOLD;
-    Label::render(modelSettingsLabelConfig);
+    LabelStyle modelSettingsLabelStyle;
+    modelSettingsLabelStyle.icon = ICON_CI_SETTINGS;
+    modelSettingsLabelStyle.size = ImVec2(Config::Icon::DEFAULT_FONT_SIZE, 0);
+	modelSettingsLabelStyle.fontType = FontsManager::BOLD;
+    Label::draw("Model Settings", modelSettingsLabelStyle);
 
     ImGui::Spacing();
     ImGui::Spacing();
@@ -81,6 +168,14 @@ void renderSamplingSettings(const float sidebarWidth)
     // Generation settings
     Slider::render("##min_length", currentPreset.min_length, 0.0f, 4096.0f, sidebarWidth - 30, "%.0f");
     Slider::render("##max_new_tokens", currentPreset.max_new_tokens, 0.0f, 4096.0f, sidebarWidth - 30, "%.0f");
+    renderStopSequences(currentPreset, sidebarWidth - 30);
+
+    ImGui::Spacing();
+    ImGui::Checkbox("Summarize long history", &currentPreset.summarize_history);
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::SetTooltip("Replace the oldest turns of long chats with a summary written in the background");
+    }
 }
 
 /**
@@ -166,13 +261,11 @@ void renderModelPresetsSelection(const float sidebarWidth)
 
     // Model presets label
     {
-        LabelConfig labelConfig;
-        labelConfig.id = "##modelpresets";
-        labelConfig.label = "Model Presets";
-        labelConfig.icon = ICON_CI_PACKAGE;
-        labelConfig.size = ImVec2(Config::Icon::DEFAULT_FONT_SIZE, 0);
-		labelConfig.fontType = FontsManager::BOLD;
-        Label::render(labelConfig);
+        LabelStyle labelStyle;
+        labelStyle.icon = ICON_CI_PACKAGE;
+        labelStyle.size = ImVec2(Config::Icon::DEFAULT_FONT_SIZE, 0);
+		labelStyle.fontType = FontsManager::BOLD;
+        Label::draw("Model Presets", labelStyle);
     }
 
     ImGui::Spacing();
@@ -180,7 +273,9 @@ void renderModelPresetsSelection(const float sidebarWidth)
 
     // Get the current presets and create a vector of names
     const std::vector<Model::ModelPreset>& presets = Model::PresetManager::getInstance().getPresets();
-    std::vector<const char*> presetNames;
+    // Reused across frames so the list is not reallocated every frame
+    static std::vector<const char*> presetNames;
+    presetNames.clear();
     for (const Model::ModelPreset& preset : presets)
     {
         presetNames.push_back(preset.name.c_str());
@@ -213,45 +308,34 @@ void renderModelPresetsSelection(const float sidebarWidth)
 
     // Delete button
     {
-        ButtonConfig deleteButtonConfig;
-        deleteButtonConfig.id = "##delete";
-        deleteButtonConfig.label = std::nullopt;
-        deleteButtonConfig.icon = ICON_CI_TRASH;
-        deleteButtonConfig.size = ImVec2(24, 0);
-        deleteButtonConfig.onClick = [&]()
-            {
-                if (Model::PresetManager::getInstance().getPresets().size() > 1)
-                { // Prevent deleting last preset
-                    auto currentPresetOpt = Model::PresetManager::getInstance().getCurrentPreset();
-                    if (currentPresetOpt)
-                    {
-                        const std::string& presetName = currentPresetOpt->get().name;
-                        // Start the asynchronous deletion and wait for completion
-                        if (Model::PresetManager::getInstance().deletePreset(presetName).get())
-                        {
-                            // Update UI by reloading presets
-                            // Since we're not using observers, we need to refresh the presets and current index
-                        }
-                        else
-                        {
-                            // Handle failure
-                            std::cerr << "Failed to delete preset." << std::endl;
-                        }
-                    }
-                }
-            };
-        deleteButtonConfig.backgroundColor = Config::Color::TRANSPARENT_COL;
-        deleteButtonConfig.hoverColor = RGBAToImVec4(191, 88, 86, 255);
-        deleteButtonConfig.activeColor = RGBAToImVec4(165, 29, 45, 255);
-        deleteButtonConfig.alignment = Alignment::CENTER;
+        ButtonStyle deleteButtonStyle;
+        deleteButtonStyle.icon = ICON_CI_TRASH;
+        deleteButtonStyle.backgroundColor = Config::Color::TRANSPARENT_COL;
+        deleteButtonStyle.hoverColor = RGBAToImVec4(191, 88, 86, 255);
+        deleteButtonStyle.activeColor = RGBAToImVec4(165, 29, 45, 255);
+        deleteButtonStyle.alignment = Alignment::CENTER;
 
         // Only enable delete button if we have more than one preset
         if (presets.size() <= 1)
         {
-            deleteButtonConfig.state = ButtonState::DISABLED;
+            deleteButtonStyle.state = ButtonState::DISABLED;
         }
 
-        Button::render(deleteButtonConfig);
+        if (Button::draw("##delete", {}, ImVec2(24, 0), deleteButtonStyle) &&
+            Model::PresetManager::getInstance().getPresets().size() > 1)
+        { // Prevent deleting last preset
+            auto currentPresetOpt = Model::PresetManager::getInstance().getCurrentPreset();
+            if (currentPresetOpt)
+            {
+                const std::string& presetName = currentPresetOpt->get().name;
+                // Start the asynchronous deletion and wait for completion
+                if (!Model::PresetManager::getInstance().deletePreset(presetName).get())
+                {
+                    // Handle failure
+                    std::cerr << "Failed to delete preset." << std::endl;
+                }
+            }
+        }
 
     } // End of delete button
 
@@ -260,46 +344,27 @@ void renderModelPresetsSelection(const float sidebarWidth)
 
     // Save and Save as New buttons
     {
-        ButtonConfig saveButtonConfig;
-        saveButtonConfig.id = "##save";
-        saveButtonConfig.label = "Save";
-        saveButtonConfig.icon = std::nullopt;
-        saveButtonConfig.size = ImVec2(sidebarWidth / 2 - 15, 0);
-        saveButtonConfig.onClick = [&]()
-            {
-                bool hasChanges = Model::PresetManager::getInstance().hasUnsavedChanges();
-                if (hasChanges)
-                {
-                    // Start the asynchronous save operation and wait for completion
-                    if (Model::PresetManager::getInstance().saveCurrentPreset().get())
-                    {
-                        // Preset saved successfully
-                    }
-                    else
-                    {
-                        // Handle failure
-                        std::cerr << "Failed to save preset." << std::endl;
-                    }
-                }
-            };
-        saveButtonConfig.backgroundColor = Model::PresetManager::getInstance().hasUnsavedChanges() ? RGBAToImVec4(26, 95, 180, 255) : RGBAToImVec4(26, 95, 180, 128);
-        saveButtonConfig.hoverColor = RGBAToImVec4(53, 132, 228, 255);
-        saveButtonConfig.activeColor = RGBAToImVec4(26, 95, 180, 255);
-
-        ButtonConfig saveAsNewButtonConfig;
-        saveAsNewButtonConfig.id = "##saveasnew";
-        saveAsNewButtonConfig.label = "Save as New";
-        saveAsNewButtonConfig.icon = std::nullopt;
-        saveAsNewButtonConfig.size = ImVec2(sidebarWidth / 2 - 15, 0);
-        saveAsNewButtonConfig.onClick = [&]()
+        const bool hasChanges = Model::PresetManager::getInstance().hasUnsavedChanges();
+        Button::Row row(9, ImGui::GetCursorPosY(), 10);
+
+        ButtonStyle saveButtonStyle;
+        saveButtonStyle.backgroundColor = hasChanges ? RGBAToImVec4(26, 95, 180, 255) : RGBAToImVec4(26, 95, 180, 128);
+        saveButtonStyle.hoverColor = RGBAToImVec4(53, 132, 228, 255);
+        saveButtonStyle.activeColor = RGBAToImVec4(26, 95, 180, 255);
+        if (row.draw("##save", "Save", ImVec2(sidebarWidth / 2 - 15, 0), saveButtonStyle) && hasChanges)
+        {
+            // Start the asynchronous save operation and wait for completion
+            if (!Model::PresetManager::getInstance().saveCurrentPreset().get())
             {
-                showSaveAsDialog = true;
-            };
-
-        std::vector<ButtonConfig> buttons = { saveButtonConfig, saveAsNewButtonConfig };
+                // Handle failure
+                std::cerr << "Failed to save preset." << std::endl;
+            }
+        }
 
-        // Render the buttons
-        Button::renderGroup(buttons, 9, ImGui::GetCursorPosY(), 10);
+        if (row.draw("##saveasnew", "Save as New", ImVec2(sidebarWidth / 2 - 15, 0)))
+        {
+            showSaveAsDialog = true;
+        }
 
     } // End of save and save as new buttons
 
@@ -400,19 +465,14 @@ void renderModelPresetSidebar(float& sidebarWidth)
     ImGui::Spacing();
 
     // Export button
-    ButtonConfig exportButtonConfig;
-    exportButtonConfig.id = "##export";
-    exportButtonConfig.label = "Export as JSON";
-    exportButtonConfig.icon = std::nullopt;
-    exportButtonConfig.size = ImVec2(sidebarWidth - 20, 0);
-    exportButtonConfig.onClick = [&]()
-        {
-            exportPresets();
-        };
-    exportButtonConfig.backgroundColor = Config::Color::SECONDARY;
-    exportButtonConfig.hoverColor = Config::Color::PRIMARY;
-    exportButtonConfig.activeColor = Config::Color::SECONDARY;
-    Button::render(exportButtonConfig);
+    ButtonStyle exportButtonStyle;
+    exportButtonStyle.backgroundColor = Config::Color::SECONDARY;
+    exportButtonStyle.hoverColor = Config::Color::PRIMARY;
+    exportButtonStyle.activeColor = Config::Color::SECONDARY;
+    if (Button::draw("##export", "Export as JSON", ImVec2(sidebarWidth - 20, 0), exportButtonStyle))
+    {
+        exportPresets();
+    }
 
     ImGui::End();
 }
\ No newline at end of file
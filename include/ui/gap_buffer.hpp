@@ -0,0 +1,162 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+/**
+ * @brief Text storage with a movable gap at the edit position.
+ *
+ * Edits at the same place, such as typing or deleting, are O(1) amortized; moving to a
+ * different place costs the distance moved. The start of every line is kept in an index
+ * that edits update in place, so lines can be located without scanning the text.
+ */
+class GapBuffer
+{
+public:
+    explicit GapBuffer(size_t initialCapacity = MIN_GAP)
+        : m_data(initialCapacity), m_gapStart(0), m_gapEnd(initialCapacity), m_lineStarts{ 0 } {}
+
+    size_t size() const { return m_data.size() - (m_gapEnd - m_gapStart); }
+    bool empty() const { return size() == 0; }
+
+    char at(size_t pos) const
+    {
+        return pos < m_gapStart ? m_data[pos] : m_data[pos + (m_gapEnd - m_gapStart)];
+    }
+
+    void insert(size_t pos, std::string_view text)
+    {
+        if (text.empty())
+            return;
+
+        pos = std::min(pos, size());
+        moveGap(pos);
+        reserveGap(text.size());
+        std::memcpy(m_data.data() + m_gapStart, text.data(), text.size());
+        m_gapStart += text.size();
+
+        // Shift the lines after the insertion point, then add the ones the text starts
+        const size_t line = getLineOfPosition(pos);
+        for (size_t i = line + 1; i < m_lineStarts.size(); ++i)
+            m_lineStarts[i] += text.size();
+
+        std::vector<size_t> newStarts;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            if (text[i] == '\n')
+                newStarts.push_back(pos + i + 1);
+        }
+        m_lineStarts.insert(m_lineStarts.begin() + line + 1, newStarts.begin(), newStarts.end());
+    }
+
+    void erase(size_t pos, size_t count)
+    {
+        pos = std::min(pos, size());
+        count = std::min(count, size() - pos);
+        if (count == 0)
+            return;
+
+        moveGap(pos);
+        m_gapEnd += count;
+
+        // Lines starting inside the erased range disappear, later ones move back
+        auto first = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), pos);
+        auto last = std::upper_bound(first, m_lineStarts.end(), pos + count);
+        for (auto it = last; it != m_lineStarts.end(); ++it)
+            *it -= count;
+        m_lineStarts.erase(first, last);
+    }
+
+    void clear()
+    {
+        m_gapStart = 0;
+        m_gapEnd = m_data.size();
+        m_lineStarts.assign(1, 0);
+    }
+
+    // Copies [pos, pos + count) into out, reusing its storage
+    void copyTo(std::string& out, size_t pos, size_t count) const
+    {
+        pos = std::min(pos, size());
+        count = std::min(count, size() - pos);
+        out.resize(count);
+        if (count == 0)
+            return;
+
+        const size_t beforeGap = pos < m_gapStart ? std::min(count, m_gapStart - pos) : 0;
+        if (beforeGap > 0)
+            std::memcpy(&out[0], m_data.data() + pos, beforeGap);
+        if (count > beforeGap)
+        {
+            const size_t afterPos = pos + beforeGap + (m_gapEnd - m_gapStart);
+            std::memcpy(&out[beforeGap], m_data.data() + afterPos, count - beforeGap);
+        }
+    }
+
+    std::string substr(size_t pos, size_t count) const
+    {
+        std::string out;
+        copyTo(out, pos, count);
+        return out;
+    }
+
+    std::string toString() const { return substr(0, size()); }
+
+    size_t getLineCount() const { return m_lineStarts.size(); }
+    size_t getLineStart(size_t line) const { return m_lineStarts[line]; }
+
+    // End of the line, before its newline
+    size_t getLineEnd(size_t line) const
+    {
+        return line + 1 < m_lineStarts.size() ? m_lineStarts[line + 1] - 1 : size();
+    }
+
+    size_t getLineOfPosition(size_t pos) const
+    {
+        return static_cast<size_t>(std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), pos) - m_lineStarts.begin()) - 1;
+    }
+
+private:
+    static constexpr size_t MIN_GAP = 256;
+
+    void moveGap(size_t pos)
+    {
+        if (pos < m_gapStart)
+        {
+            const size_t count = m_gapStart - pos;
+            std::memmove(m_data.data() + m_gapEnd - count, m_data.data() + pos, count);
+            m_gapStart -= count;
+            m_gapEnd -= count;
+        }
+        else if (pos > m_gapStart)
+        {
+            const size_t count = pos - m_gapStart;
+            std::memmove(m_data.data() + m_gapStart, m_data.data() + m_gapEnd, count);
+            m_gapStart += count;
+            m_gapEnd += count;
+        }
+    }
+
+    void reserveGap(size_t needed)
+    {
+        if (m_gapEnd - m_gapStart >= needed)
+            return;
+
+        // Grow geometrically so a run of inserts stays amortized O(1)
+        const size_t tail = m_data.size() - m_gapEnd;
+        const size_t capacity = std::max(m_data.size() * 2, size() + needed + MIN_GAP);
+        std::vector<char> data(capacity);
+        std::memcpy(data.data(), m_data.data(), m_gapStart);
+        std::memcpy(data.data() + capacity - tail, m_data.data() + m_gapEnd, tail);
+        m_data.swap(data);
+        m_gapEnd = capacity - tail;
+    }
+
+    std::vector<char> m_data;
+    size_t m_gapStart;
+    size_t m_gapEnd;
+    std::vector<size_t> m_lineStarts;   // offset of the first character of each line
+};
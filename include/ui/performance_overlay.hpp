@@ -0,0 +1,210 @@
+#pragma once
+
+#include "imgui.h"
+#include "config.hpp"
+#include "ui/widgets.hpp"
+#include "profiling/frame_stats.hpp"
+#include "profiling/process_stats.hpp"
+#include "profiling/memory_tracker.hpp"
+#include "chat/chat_manager.hpp"
+#include "model/model_manager.hpp"
+
+#include <cstdio>
+#include <cstdarg>
+#include <algorithm>
+#include <string_view>
+
+namespace PerformanceOverlay
+{
+    /**
+     * @brief Draws "name: value", with the value formatted printf-style into a stack buffer,
+     * so the overlay does not allocate while it is open.
+     */
+    inline void renderStatLine(const char* name, const char* format, ...) IM_FMTARGS(2);
+
+    inline void renderStatLine(const char* name, const char* format, ...)
+    {
+        char text[128];
+        int length = std::snprintf(text, sizeof(text), "%s: ", name);
+        if (length > 0 && static_cast<size_t>(length) < sizeof(text))
+        {
+            va_list args;
+            va_start(args, format);
+            std::vsnprintf(text + length, sizeof(text) - length, format, args);
+            va_end(args);
+        }
+
+        LabelStyle labelStyle;
+        labelStyle.iconPaddingY = 2.0F;
+        labelStyle.fontSize = FontsManager::SM;
+        labelStyle.alignment = Alignment::LEFT;
+        Label::draw(std::string_view(text), labelStyle);
+    }
+
+    inline void renderSectionHeader(const char* title)
+    {
+        LabelStyle labelStyle;
+        labelStyle.fontType = FontsManager::BOLD;
+        labelStyle.alignment = Alignment::LEFT;
+        Label::draw(title, labelStyle);
+    }
+
+    inline void renderFrameSection()
+    {
+        const Profiling::FrameStats& stats = Profiling::FrameStats::getInstance();
+        const size_t count = stats.getHistoryCount();
+        const float* history = stats.getFrameHistory();
+
+        float average = 0.0F;
+        float maximum = 0.0F;
+        for (size_t i = 0; i < count; ++i)
+        {
+            average += history[i];
+            maximum = std::max(maximum, history[i]);
+        }
+        if (count > 0)
+        {
+            average /= static_cast<float>(count);
+        }
+
+        renderSectionHeader("Frame");
+
+        char overlayText[64];
+        std::snprintf(overlayText, sizeof(overlayText), "avg %.2f ms  max %.2f ms", average, maximum);
+
+        ImGui::PushStyleColor(ImGuiCol_FrameBg, Config::Color::SECONDARY);
+        ImGui::PlotHistogram("##frameTimes",
+            history,
+            static_cast<int>(count),
+            count < Profiling::FrameStats::HISTORY_SIZE ? 0 : static_cast<int>(stats.getHistoryOffset()),
+            overlayText,
+            0.0F,
+            std::max(maximum, static_cast<float>(Config::TARGET_FRAME_TIME * 1000.0)),
+            ImVec2(ImGui::GetContentRegionAvail().x, Config::PerformanceOverlay::HISTOGRAM_HEIGHT));
+        ImGui::PopStyleColor();
+
+        for (size_t i = 0; i < Profiling::FrameStats::STAGE_COUNT; ++i)
+        {
+            auto stage = static_cast<Profiling::FrameStage>(i);
+            renderStatLine(Profiling::getFrameStageName(stage), "%.2f ms", stats.getAverageStageMs(stage));
+        }
+    }
+
+    inline void renderManagerSection()
+    {
+        // Download throughput is derived from the byte counter at a fixed interval
+        static uint64_t lastDownloadedBytes = 0;
+        static double lastSampleTime = -1.0;
+        static double downloadBytesPerSecond = 0.0;
+
+        Model::ModelManager& modelManager = Model::ModelManager::getInstance();
+        Chat::ChatManager& chatManager = Chat::ChatManager::getInstance();
+
+        const double now = ImGui::GetTime();
+        const uint64_t downloadedBytes = modelManager.getDownloadedBytes();
+        if (lastSampleTime < 0.0)
+        {
+            lastSampleTime = now;
+            lastDownloadedBytes = downloadedBytes;
+        }
+        else if (now - lastSampleTime >= Config::PerformanceOverlay::THROUGHPUT_SAMPLE_INTERVAL)
+        {
+            downloadBytesPerSecond = (downloadedBytes - lastDownloadedBytes) / (now - lastSampleTime);
+            lastDownloadedBytes = downloadedBytes;
+            lastSampleTime = now;
+        }
+
+        ImGui::Spacing();
+        renderSectionHeader("Inference");
+        renderStatLine("Tokens/s", "%.1f", static_cast<double>(modelManager.getTokensPerSecond()));
+        renderStatLine("Active jobs", "%d", modelManager.getActiveJobCount());
+        renderStatLine("Queued background", "%zu", modelManager.getQueuedBackgroundJobCount());
+        // Messages in common with the previous prompt; the engine does not report what it reused
+        renderStatLine("Shared prefix", "%zu msgs", modelManager.getLastSharedPrefixLength());
+
+        ImGui::Spacing();
+        renderSectionHeader("I/O");
+        renderStatLine("Pending writes", "%zu", chatManager.getPendingWriteCount());
+        renderStatLine("Download", "%.2f MB/s", downloadBytesPerSecond / (1024.0 * 1024.0));
+    }
+
+    inline void renderMemorySection()
+    {
+        ImGui::Spacing();
+        renderSectionHeader("Memory");
+
+        // Read counter by counter; snapshot() would allocate its list every frame
+        const Profiling::MemoryTracker& tracker = Profiling::MemoryTracker::getInstance();
+        int64_t totalBytes = 0;
+        for (size_t i = 0; i < Profiling::MemoryTracker::SUBSYSTEM_COUNT; ++i)
+        {
+            const auto subsystem = static_cast<Profiling::MemorySubsystem>(i);
+            const int64_t currentBytes = tracker.getCurrentBytes(subsystem);
+            const int64_t budgetBytes = Config::Memory::BUDGETS[i];
+            totalBytes += currentBytes;
+            renderStatLine(Profiling::getMemorySubsystemName(subsystem), "%.2f MB (peak %.2f)%s",
+                Profiling::MemoryTracker::toMiB(currentBytes),
+                Profiling::MemoryTracker::toMiB(tracker.getPeakBytes(subsystem)),
+                budgetBytes > 0 && currentBytes > budgetBytes ? " over budget" : "");
+        }
+        renderStatLine("Tracked total", "%.2f MB", Profiling::MemoryTracker::toMiB(totalBytes));
+    }
+} // namespace PerformanceOverlay
+
+/**
+ * @brief Renders the performance overlay in the top-right corner of the window.
+ *
+ * Everything shown is read from counters that are maintained regardless, so the overlay
+ * adds no cost while hidden.
+ *
+ * @param managersReady Whether the chat and model managers can be queried yet.
+ */
+inline void renderPerformanceOverlay(const bool managersReady)
+{
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui::SetNextWindowPos(
+        ImVec2(io.DisplaySize.x - Config::PerformanceOverlay::WIDTH - Config::FRAME_PADDING_X,
+               Config::TITLE_BAR_HEIGHT + Config::FRAME_PADDING_Y),
+        ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(Config::PerformanceOverlay::WIDTH, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.85F);
+
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoTitleBar |
+        ImGuiWindowFlags_NoResize |
+        ImGuiWindowFlags_NoMove |
+        ImGuiWindowFlags_NoCollapse |
+        ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav |
+        ImGuiWindowFlags_AlwaysAutoResize;
+
+    ImGui::Begin("##performanceOverlay", nullptr, flags);
+
+    PerformanceOverlay::renderFrameSection();
+
+    if (managersReady)
+    {
+        PerformanceOverlay::renderManagerSection();
+    }
+
+    // Querying the OS is not free, so the resident size is refreshed at the sample interval
+    static uint64_t residentBytes = 0;
+    static double lastResidentSample = -1.0;
+    if (lastResidentSample < 0.0 ||
+        ImGui::GetTime() - lastResidentSample >= Config::PerformanceOverlay::THROUGHPUT_SAMPLE_INTERVAL)
+    {
+        residentBytes = Profiling::getProcessResidentBytes();
+        lastResidentSample = ImGui::GetTime();
+    }
+
+    PerformanceOverlay::renderMemorySection();
+
+    ImGui::Spacing();
+    PerformanceOverlay::renderSectionHeader("Process");
+    PerformanceOverlay::renderStatLine("RSS", "%.1f MB", residentBytes / (1024.0 * 1024.0));
+
+    ImGui::End();
+
+    // Keep the numbers moving even without user input in power saving mode
+    ImGui::SetMaxWaitBeforeNextFrame(Config::PerformanceOverlay::THROUGHPUT_SAMPLE_INTERVAL);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "config.hpp"
+#include "ui/chat/chat_history_sidebar.hpp"
+#include "ui/chat/chat_section.hpp"
+#include "ui/chat/preset_sidebar.hpp"
+
+/**
+ * @brief Draws the main view: chat history on the left, presets on the right and the chat
+ * window in between.
+ *
+ * Kept apart from the platform code so it can also be driven without a window, see
+ * benchmarks/ui_frame_benchmark.cpp.
+ */
+inline void renderPlayground(float& chatHistorySidebarWidth, float& modelPresetSidebarWidth)
+{
+    renderChatHistorySidebar(chatHistorySidebarWidth);
+    renderModelPresetSidebar(modelPresetSidebarWidth);
+    renderChatWindow(Config::INPUT_HEIGHT, chatHistorySidebarWidth, modelPresetSidebarWidth);
+}
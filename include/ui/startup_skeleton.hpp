@@ -0,0 +1,94 @@
+#pragma once
+
+#include "config.hpp"
+#include "ui/fonts.hpp"
+
+#include <imgui.h>
+#include <cmath>
+
+namespace StartupSkeleton
+{
+    inline void drawPlaceholder(ImDrawList* drawList, const ImVec2& min, const ImVec2& max, float alpha)
+    {
+        ImVec4 color = Config::Color::SECONDARY;
+        color.w *= alpha;
+        drawList->AddRectFilled(min, max, ImGui::ColorConvertFloat4ToU32(color), 5.0F);
+    }
+
+    inline void drawSidebar(ImDrawList* drawList, float x, float width, float alpha)
+    {
+        const float top = Config::TITLE_BAR_HEIGHT + Config::FRAME_PADDING_Y;
+        const float rowHeight = 24.0F;
+        const float rowSpacing = 8.0F;
+
+        // Header followed by a handful of list rows
+        drawPlaceholder(drawList,
+            ImVec2(x + Config::FRAME_PADDING_X, top),
+            ImVec2(x + width * 0.5F, top + rowHeight), alpha);
+
+        for (int i = 1; i <= 5; ++i)
+        {
+            float rowTop = top + i * (rowHeight + rowSpacing);
+            drawPlaceholder(drawList,
+                ImVec2(x + Config::FRAME_PADDING_X, rowTop),
+                ImVec2(x + width - Config::FRAME_PADDING_X, rowTop + rowHeight), alpha);
+        }
+    }
+} // namespace StartupSkeleton
+
+/**
+ * @brief Draws placeholder shapes in the layout of the playground while the managers load.
+ *
+ * Needs nothing beyond ImGui and the fonts, so it can be shown on the very first frame.
+ */
+inline void renderStartupSkeleton(const float leftSidebarWidth, const float rightSidebarWidth)
+{
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui::SetNextWindowPos(ImVec2(0, Config::TITLE_BAR_HEIGHT), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(io.DisplaySize.x, io.DisplaySize.y - Config::TITLE_BAR_HEIGHT), ImGuiCond_Always);
+
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoTitleBar |
+        ImGuiWindowFlags_NoResize |
+        ImGuiWindowFlags_NoMove |
+        ImGuiWindowFlags_NoCollapse |
+        ImGuiWindowFlags_NoBackground |
+        ImGuiWindowFlags_NoInputs |
+        ImGuiWindowFlags_NoBringToFrontOnFocus;
+
+    ImGui::Begin("##startupSkeleton", nullptr, flags);
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    // Gentle pulse so the placeholders read as "loading"
+    float alpha = 0.6F + 0.4F * std::sin(static_cast<float>(ImGui::GetTime()) * Config::Startup::SKELETON_PULSE_SPEED);
+
+    StartupSkeleton::drawSidebar(drawList, 0.0F, leftSidebarWidth, alpha);
+    StartupSkeleton::drawSidebar(drawList, io.DisplaySize.x - rightSidebarWidth, rightSidebarWidth, alpha);
+
+    // Input box placeholder at the bottom of the chat area
+    float chatLeft = leftSidebarWidth;
+    float chatRight = io.DisplaySize.x - rightSidebarWidth;
+    float contentWidth = std::fmin(Config::CHAT_WINDOW_CONTENT_WIDTH, chatRight - chatLeft - 2 * Config::FRAME_PADDING_X);
+    float contentLeft = chatLeft + (chatRight - chatLeft - contentWidth) / Config::HALF_DIVISOR;
+    float inputBottom = io.DisplaySize.y - Config::BOTTOM_MARGIN;
+
+    StartupSkeleton::drawPlaceholder(drawList,
+        ImVec2(contentLeft, inputBottom - Config::INPUT_HEIGHT),
+        ImVec2(contentLeft + contentWidth, inputBottom), alpha);
+
+    ImGui::PushFont(FontsManager::GetInstance().GetMarkdownFont(FontsManager::REGULAR));
+    const char* loadingText = "Loading...";
+    ImVec2 textSize = ImGui::CalcTextSize(loadingText);
+    drawList->AddText(
+        ImVec2(chatLeft + (chatRight - chatLeft - textSize.x) / Config::HALF_DIVISOR,
+               Config::TITLE_BAR_HEIGHT + (io.DisplaySize.y - Config::TITLE_BAR_HEIGHT - textSize.y) / Config::HALF_DIVISOR),
+        ImGui::GetColorU32(ImGuiCol_TextDisabled),
+        loadingText);
+    ImGui::PopFont();
+
+    ImGui::End();
+
+    // Keep animating even though there is no user input in power saving mode
+    ImGui::SetMaxWaitBeforeNextFrame(Config::TARGET_FRAME_TIME);
+}
@@ -0,0 +1,593 @@
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "config.hpp"
+#include "ui/gap_buffer.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <cctype>
+#include <algorithm>
+#include <functional>
+
+/**
+ * @brief Text, cursor and undo history of a TextEditor, kept by the caller across frames.
+ */
+struct TextEditorState
+{
+    struct Edit
+    {
+        size_t pos;
+        std::string removed;
+        std::string inserted;
+        size_t cursorBefore;
+        bool typing;            // typed characters, merged with the following ones on undo
+    };
+
+    GapBuffer buffer;
+    size_t cursor = 0;
+    size_t anchor = 0;          // other end of the selection, equal to cursor when nothing is selected
+    float preferredX = -1.0F;   // column kept while moving up and down
+    float scrollX = 0.0F;
+    bool focused = false;
+    bool selecting = false;     // mouse drag in progress
+    bool scrollToCursor = false;
+    double lastEditTime = 0.0;  // restarts the caret blink
+
+    std::vector<Edit> undoStack;
+    std::vector<Edit> redoStack;
+    std::string scratch;        // line being measured or drawn
+};
+
+/**
+ * @brief Configuration of a multiline TextEditor, mirroring InputFieldConfig.
+ *
+ * Enter submits through processInput; Ctrl+Enter and Shift+Enter insert a newline.
+ */
+struct TextEditorConfig
+{
+    const char *id;
+    ImVec2 size;
+    TextEditorState &state;
+    bool &focusInputField;
+    const char *placeholderText = "";
+    std::function<void(const std::string &)> processInput;
+    float frameRounding = Config::InputField::FRAME_ROUNDING;
+    ImVec2 padding = ImVec2(Config::FRAME_PADDING_X, Config::FRAME_PADDING_Y);
+    ImVec4 backgroundColor = Config::InputField::INPUT_FIELD_BG_COLOR;
+    ImVec4 textColor = ImVec4(1.0F, 1.0F, 1.0F, 1.0F);
+
+    TextEditorConfig(
+        const char *id,
+        const ImVec2 &size,
+        TextEditorState &state,
+        bool &focusInputField)
+        : id(id),
+          size(size),
+          state(state),
+          focusInputField(focusInputField) {}
+};
+
+/**
+ * @brief A multiline text input without a size limit.
+ *
+ * Text lives in a GapBuffer, so typing and deleting cost the same at any document size,
+ * and only the lines inside the view are measured and drawn. Long lines scroll
+ * horizontally, as in InputTextMultiline.
+ */
+namespace TextEditor
+{
+    inline bool isContinuationByte(char c)
+    {
+        return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+    }
+
+    inline bool isWordCharacter(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+    }
+
+    inline size_t nextCharacter(const GapBuffer &buffer, size_t pos)
+    {
+        if (pos >= buffer.size())
+            return buffer.size();
+        ++pos;
+        while (pos < buffer.size() && isContinuationByte(buffer.at(pos)))
+            ++pos;
+        return pos;
+    }
+
+    inline size_t previousCharacter(const GapBuffer &buffer, size_t pos)
+    {
+        if (pos == 0)
+            return 0;
+        --pos;
+        while (pos > 0 && isContinuationByte(buffer.at(pos)))
+            --pos;
+        return pos;
+    }
+
+    inline size_t nextWord(const GapBuffer &buffer, size_t pos)
+    {
+        while (pos < buffer.size() && isWordCharacter(buffer.at(pos)))
+            ++pos;
+        while (pos < buffer.size() && !isWordCharacter(buffer.at(pos)))
+            ++pos;
+        return pos;
+    }
+
+    inline size_t previousWord(const GapBuffer &buffer, size_t pos)
+    {
+        while (pos > 0 && !isWordCharacter(buffer.at(pos - 1)))
+            --pos;
+        while (pos > 0 && isWordCharacter(buffer.at(pos - 1)))
+            --pos;
+        return pos;
+    }
+
+    inline float measure(const std::string &text, size_t count)
+    {
+        return ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, 0.0F, text.data(), text.data() + count).x;
+    }
+
+    // Horizontal offset of a position within its line
+    inline float getColumnX(TextEditorState &state, size_t pos)
+    {
+        const size_t lineStart = state.buffer.getLineStart(state.buffer.getLineOfPosition(pos));
+        state.buffer.copyTo(state.scratch, lineStart, pos - lineStart);
+        return measure(state.scratch, state.scratch.size());
+    }
+
+    // Closest character boundary to x on a line
+    inline size_t getPositionAtX(TextEditorState &state, size_t line, float x)
+    {
+        const size_t lineStart = state.buffer.getLineStart(line);
+        state.buffer.copyTo(state.scratch, lineStart, state.buffer.getLineEnd(line) - lineStart);
+
+        ImFont *font = ImGui::GetFont();
+        const float scale = ImGui::GetFontSize() / font->FontSize;
+        const char *begin = state.scratch.data();
+        const char *end = begin + state.scratch.size();
+        const char *p = begin;
+        float width = 0.0F;
+        while (p < end)
+        {
+            unsigned int c = 0;
+            const int length = std::max(1, ImTextCharFromUtf8(&c, p, end));
+            const float advance = font->GetCharAdvance(static_cast<ImWchar>(c)) * scale;
+            if (width + advance * 0.5F > x)
+                break;
+            width += advance;
+            p += length;
+        }
+        return lineStart + static_cast<size_t>(p - begin);
+    }
+
+    inline bool hasSelection(const TextEditorState &state)
+    {
+        return state.cursor != state.anchor;
+    }
+
+    inline void moveCursor(TextEditorState &state, size_t pos, bool extendSelection)
+    {
+        state.cursor = pos;
+        if (!extendSelection)
+            state.anchor = pos;
+        state.scrollToCursor = true;
+        state.lastEditTime = ImGui::GetTime();
+    }
+
+    inline void replaceSelection(TextEditorState &state, std::string_view text, bool typing)
+    {
+        const size_t start = std::min(state.cursor, state.anchor);
+        const size_t end = std::max(state.cursor, state.anchor);
+        if (start == end && text.empty())
+            return;
+
+        TextEditorState::Edit edit{ start, state.buffer.substr(start, end - start), std::string(text), state.cursor, typing };
+        state.buffer.erase(start, end - start);
+        state.buffer.insert(start, text);
+
+        // A run of typed characters undoes as one step
+        TextEditorState::Edit *last = state.undoStack.empty() ? nullptr : &state.undoStack.back();
+        if (typing && edit.removed.empty() && last && last->typing && last->pos + last->inserted.size() == start)
+        {
+            last->inserted += edit.inserted;
+        }
+        else
+        {
+            state.undoStack.push_back(std::move(edit));
+            if (state.undoStack.size() > Config::InputField::UNDO_LIMIT)
+                state.undoStack.erase(state.undoStack.begin());
+        }
+        state.redoStack.clear();
+
+        state.preferredX = -1.0F;
+        moveCursor(state, start + text.size(), false);
+    }
+
+    inline void eraseRange(TextEditorState &state, size_t from, size_t to)
+    {
+        state.anchor = from;
+        state.cursor = to;
+        replaceSelection(state, {}, false);
+    }
+
+    inline void undo(TextEditorState &state)
+    {
+        if (state.undoStack.empty())
+            return;
+
+        TextEditorState::Edit edit = std::move(state.undoStack.back());
+        state.undoStack.pop_back();
+        state.buffer.erase(edit.pos, edit.inserted.size());
+        state.buffer.insert(edit.pos, edit.removed);
+        moveCursor(state, std::min(edit.cursorBefore, state.buffer.size()), false);
+        state.redoStack.push_back(std::move(edit));
+    }
+
+    inline void redo(TextEditorState &state)
+    {
+        if (state.redoStack.empty())
+            return;
+
+        TextEditorState::Edit edit = std::move(state.redoStack.back());
+        state.redoStack.pop_back();
+        state.buffer.erase(edit.pos, edit.removed.size());
+        state.buffer.insert(edit.pos, edit.inserted);
+        moveCursor(state, edit.pos + edit.inserted.size(), false);
+        edit.typing = false;
+        state.undoStack.push_back(std::move(edit));
+    }
+
+    inline void clear(TextEditorState &state)
+    {
+        state.buffer.clear();
+        state.undoStack.clear();
+        state.redoStack.clear();
+        state.cursor = state.anchor = 0;
+        state.scrollX = 0.0F;
+        state.preferredX = -1.0F;
+    }
+
+    // Replaces the text with a fresh document, the cursor at its end and nothing to undo
+    inline void setText(TextEditorState &state, std::string_view text)
+    {
+        clear(state);
+        state.buffer.insert(0, text);
+        state.cursor = state.anchor = state.buffer.size();
+        state.scrollToCursor = true;
+    }
+
+    // Moves the cursor by whole lines, keeping its column
+    inline void moveLines(TextEditorState &state, long delta, bool extendSelection)
+    {
+        const size_t line = state.buffer.getLineOfPosition(state.cursor);
+        if (state.preferredX < 0.0F)
+            state.preferredX = getColumnX(state, state.cursor);
+
+        const long lastLine = static_cast<long>(state.buffer.getLineCount()) - 1;
+        const long target = std::clamp(static_cast<long>(line) + delta, 0L, lastLine);
+        size_t pos;
+        if (target == static_cast<long>(line))
+            pos = delta < 0 ? 0 : state.buffer.size();
+        else
+            pos = getPositionAtX(state, static_cast<size_t>(target), state.preferredX);
+        moveCursor(state, pos, extendSelection);
+    }
+
+    /**
+     * @brief Applies this frame's keyboard input to a focused editor.
+     *
+     * @return true when Enter was pressed to submit.
+     */
+    inline bool handleKeyboard(TextEditorState &state, long visibleLines)
+    {
+        ImGuiIO &io = ImGui::GetIO();
+        const bool ctrl = io.KeyCtrl;
+        const bool shift = io.KeyShift;
+        GapBuffer &buffer = state.buffer;
+        const size_t selectionStart = std::min(state.cursor, state.anchor);
+        const size_t selectionEnd = std::max(state.cursor, state.anchor);
+
+        if (ImGui::IsKeyPressed(ImGuiKey_LeftArrow))
+        {
+            state.preferredX = -1.0F;
+            if (hasSelection(state) && !shift)
+                moveCursor(state, selectionStart, false);
+            else
+                moveCursor(state, ctrl ? previousWord(buffer, state.cursor) : previousCharacter(buffer, state.cursor), shift);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_RightArrow))
+        {
+            state.preferredX = -1.0F;
+            if (hasSelection(state) && !shift)
+                moveCursor(state, selectionEnd, false);
+            else
+                moveCursor(state, ctrl ? nextWord(buffer, state.cursor) : nextCharacter(buffer, state.cursor), shift);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_UpArrow))
+        {
+            moveLines(state, -1, shift);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_DownArrow))
+        {
+            moveLines(state, 1, shift);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_PageUp))
+        {
+            moveLines(state, -visibleLines, shift);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_PageDown))
+        {
+            moveLines(state, visibleLines, shift);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_Home))
+        {
+            state.preferredX = -1.0F;
+            moveCursor(state, ctrl ? 0 : buffer.getLineStart(buffer.getLineOfPosition(state.cursor)), shift);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_End))
+        {
+            state.preferredX = -1.0F;
+            moveCursor(state, ctrl ? buffer.size() : buffer.getLineEnd(buffer.getLineOfPosition(state.cursor)), shift);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_Backspace))
+        {
+            if (hasSelection(state))
+                replaceSelection(state, {}, false);
+            else if (state.cursor > 0)
+                eraseRange(state, ctrl ? previousWord(buffer, state.cursor) : previousCharacter(buffer, state.cursor), state.cursor);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_Delete))
+        {
+            if (hasSelection(state))
+                replaceSelection(state, {}, false);
+            else if (state.cursor < buffer.size())
+                eraseRange(state, state.cursor, ctrl ? nextWord(buffer, state.cursor) : nextCharacter(buffer, state.cursor));
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_Enter) || ImGui::IsKeyPressed(ImGuiKey_KeypadEnter))
+        {
+            if (!ctrl && !shift)
+                return true;
+            replaceSelection(state, "\n", false);
+        }
+        else if (ctrl && ImGui::IsKeyPressed(ImGuiKey_A, false))
+        {
+            state.anchor = 0;
+            state.cursor = buffer.size();
+        }
+        else if (ctrl && (ImGui::IsKeyPressed(ImGuiKey_C, false) || ImGui::IsKeyPressed(ImGuiKey_X, false)))
+        {
+            if (hasSelection(state))
+            {
+                ImGui::SetClipboardText(buffer.substr(selectionStart, selectionEnd - selectionStart).c_str());
+                if (ImGui::IsKeyPressed(ImGuiKey_X, false))
+                    replaceSelection(state, {}, false);
+            }
+        }
+        else if (ctrl && ImGui::IsKeyPressed(ImGuiKey_V))
+        {
+            if (const char *clipboard = ImGui::GetClipboardText())
+            {
+                std::string text(clipboard);
+                text.erase(std::remove(text.begin(), text.end(), '\r'), text.end());
+                replaceSelection(state, text, false);
+            }
+        }
+        else if (ctrl && ImGui::IsKeyPressed(ImGuiKey_Z))
+        {
+            if (shift)
+                redo(state);
+            else
+                undo(state);
+        }
+        else if (ctrl && ImGui::IsKeyPressed(ImGuiKey_Y))
+        {
+            redo(state);
+        }
+
+        // Typed characters; Ctrl+Alt is AltGr on some layouts and still types
+        if ((!ctrl || io.KeyAlt) && !io.InputQueueCharacters.empty())
+        {
+            std::string typed;
+            char encoded[5];
+            for (ImWchar c : io.InputQueueCharacters)
+            {
+                if (c < 0x20 || c == 0x7F)
+                    continue;
+                typed += ImTextCharToUtf8(encoded, c);
+            }
+
+            // Tab and Escape also arrive as characters; alone they must not delete a selection
+            if (typed.empty())
+                return false;
+            replaceSelection(state, typed, true);
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Renders a multiline text editor with the specified configuration.
+     */
+    inline void render(const TextEditorConfig &config)
+    {
+        TextEditorState &state = config.state;
+        ImGuiIO &io = ImGui::GetIO();
+
+        ImGui::PushStyleColor(ImGuiCol_ChildBg, config.backgroundColor);
+        ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, config.frameRounding);
+        ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, config.padding);
+        ImGui::BeginChild(config.id, config.size, ImGuiChildFlags_AlwaysUseWindowPadding, ImGuiWindowFlags_NoNav);
+        ImGui::PopStyleVar(2);
+        ImGui::PopStyleColor();
+
+        ImGuiWindow *window = ImGui::GetCurrentWindow();
+        const ImVec2 viewMin(window->InnerRect.Min.x + config.padding.x, window->InnerRect.Min.y + config.padding.y);
+        const ImVec2 viewMax(window->InnerRect.Max.x - config.padding.x, window->InnerRect.Max.y - config.padding.y);
+        const float viewWidth = std::max(1.0F, viewMax.x - viewMin.x);
+        const float viewHeight = std::max(1.0F, viewMax.y - viewMin.y);
+        const float lineHeight = ImGui::GetTextLineHeight();
+        const ImVec2 origin = ImGui::GetCursorScreenPos();  // top-left of the first line, scrolled
+
+        if (config.focusInputField)
+        {
+            state.focused = true;
+            state.scrollToCursor = true;
+            config.focusInputField = false;
+        }
+
+        // Mouse: click to place the cursor, drag or shift-click to select, double-click for a word
+        const bool hovered = ImGui::IsWindowHovered() && window->InnerRect.Contains(io.MousePos);
+        if (hovered)
+        {
+            ImGui::SetMouseCursor(ImGuiMouseCursor_TextInput);
+        }
+
+        auto positionAtMouse = [&]()
+            {
+                const float y = (io.MousePos.y - origin.y) / lineHeight;
+                const size_t line = static_cast<size_t>(std::clamp(y, 0.0F, static_cast<float>(state.buffer.getLineCount() - 1)));
+                return getPositionAtX(state, line, io.MousePos.x - origin.x + state.scrollX);
+            };
+
+        if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+        {
+            state.focused = hovered;
+            if (hovered)
+            {
+                const size_t pos = positionAtMouse();
+                state.preferredX = -1.0F;
+                if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+                {
+                    state.anchor = pos;
+                    while (state.anchor > 0 && isWordCharacter(state.buffer.at(state.anchor - 1)))
+                        --state.anchor;
+                    size_t end = pos;
+                    while (end < state.buffer.size() && isWordCharacter(state.buffer.at(end)))
+                        ++end;
+                    moveCursor(state, end, true);
+                }
+                else
+                {
+                    moveCursor(state, pos, io.KeyShift);
+                    state.selecting = true;
+                }
+            }
+        }
+        if (state.selecting)
+        {
+            if (ImGui::IsMouseDown(ImGuiMouseButton_Left))
+                moveCursor(state, positionAtMouse(), true);
+            else
+                state.selecting = false;
+        }
+
+        bool submit = false;
+        if (state.focused)
+        {
+            submit = handleKeyboard(state, std::max(1L, static_cast<long>(viewHeight / lineHeight)));
+
+            // Let the platform show its text input and IME, and keep the caret blinking
+            ImGui::GetCurrentContext()->WantTextInputNextFrame = 1;
+            ImGui::SetMaxWaitBeforeNextFrame(Config::InputField::CARET_BLINK_PERIOD / 2.0);
+        }
+
+        if (submit && config.processInput)
+        {
+            std::string input = state.buffer.toString();
+            input.erase(0, input.find_first_not_of(" \n\r\t"));
+            input.erase(input.find_last_not_of(" \n\r\t") + 1);
+
+            if (!input.empty())
+            {
+                config.processInput(input);
+                clear(state);
+            }
+            config.focusInputField = true;
+        }
+
+        const size_t lineCount = state.buffer.getLineCount();
+        const size_t cursorLine = state.buffer.getLineOfPosition(state.cursor);
+        if (state.scrollToCursor)
+        {
+            const float top = cursorLine * lineHeight;
+            if (top < ImGui::GetScrollY())
+                ImGui::SetScrollY(top);
+            else if (top + lineHeight > ImGui::GetScrollY() + viewHeight)
+                ImGui::SetScrollY(top + lineHeight - viewHeight);
+
+            const float cursorX = getColumnX(state, state.cursor);
+            if (cursorX < state.scrollX)
+                state.scrollX = std::max(0.0F, cursorX - viewWidth * 0.25F);
+            else if (cursorX > state.scrollX + viewWidth - 2.0F)
+                state.scrollX = cursorX - viewWidth * 0.75F;
+
+            state.scrollToCursor = false;
+        }
+
+        // Draw only the lines inside the view
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        drawList->PushClipRect(viewMin, viewMax, true);
+
+        const float fontSize = ImGui::GetFontSize();
+        const ImU32 textColor = ImGui::ColorConvertFloat4ToU32(config.textColor);
+        const ImU32 selectionColor = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+        const size_t selectionStart = std::min(state.cursor, state.anchor);
+        const size_t selectionEnd = std::max(state.cursor, state.anchor);
+        const size_t firstLine = std::min(lineCount - 1, static_cast<size_t>(ImGui::GetScrollY() / lineHeight));
+        const size_t lastLine = std::min(lineCount, firstLine + static_cast<size_t>(viewHeight / lineHeight) + 2);
+
+        for (size_t line = firstLine; line < lastLine; ++line)
+        {
+            const size_t lineStart = state.buffer.getLineStart(line);
+            const size_t lineEnd = state.buffer.getLineEnd(line);
+            state.buffer.copyTo(state.scratch, lineStart, lineEnd - lineStart);
+            const ImVec2 linePos(origin.x - state.scrollX, origin.y + line * lineHeight);
+
+            if (selectionStart < selectionEnd && selectionStart <= lineEnd && selectionEnd > lineStart)
+            {
+                const float x0 = measure(state.scratch, std::max(selectionStart, lineStart) - lineStart);
+                float x1 = measure(state.scratch, std::min(selectionEnd, lineEnd) - lineStart);
+                if (selectionEnd > lineEnd)
+                    x1 += fontSize * 0.4F;  // the newline is selected too
+                drawList->AddRectFilled(ImVec2(linePos.x + x0, linePos.y), ImVec2(linePos.x + x1, linePos.y + lineHeight), selectionColor);
+            }
+
+            drawList->AddText(ImGui::GetFont(), fontSize, linePos, textColor,
+                state.scratch.data(), state.scratch.data() + state.scratch.size());
+        }
+
+        if (state.focused)
+        {
+            const ImVec2 caretPos(origin.x - state.scrollX + getColumnX(state, state.cursor), origin.y + cursorLine * lineHeight);
+            const double sinceEdit = ImGui::GetTime() - state.lastEditTime;
+            if (std::fmod(sinceEdit, Config::InputField::CARET_BLINK_PERIOD) < Config::InputField::CARET_ON_TIME)
+            {
+                drawList->AddLine(caretPos, ImVec2(caretPos.x, caretPos.y + lineHeight), textColor, 1.0F);
+            }
+
+            ImGuiPlatformImeData &imeData = ImGui::GetCurrentContext()->PlatformImeData;
+            imeData.WantVisible = true;
+            imeData.InputPos = ImVec2(caretPos.x - 1.0F, caretPos.y - ImGui::GetStyle().FramePadding.y);
+            imeData.InputLineHeight = lineHeight;
+        }
+
+        if (state.buffer.empty())
+        {
+            drawList->AddText(ImGui::GetFont(), fontSize, origin, ImGui::GetColorU32(ImVec4(0.7f, 0.7f, 0.7f, 1.0f)),
+                config.placeholderText, nullptr, viewWidth);
+        }
+
+        drawList->PopClipRect();
+
+        // Reserve the full height so the child scrolls over the whole text
+        ImGui::Dummy(ImVec2(1.0F, lineCount * lineHeight));
+        ImGui::EndChild();
+    }
+} // namespace TextEditor
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <functional>
 #include <algorithm>
@@ -77,6 +78,57 @@ struct LabelConfig
     std::optional<ImVec4> color = ImVec4(1.0F, 1.0F, 1.0F, 1.0F);
 };
 
+/**
+ * @brief Look of a button drawn with Button::draw.
+ *
+ * Holds the same settings as ButtonConfig as plain values, so a style can be built on the
+ * stack every frame; the id, label and click handling are passed to or returned by the call.
+ */
+struct ButtonStyle
+{
+    const char* icon = nullptr;         // e.g. ICON_CI_COPY
+    float gap = 5.0F;
+    FontsManager::FontType fontType = FontsManager::REGULAR;
+    FontsManager::IconType iconType = FontsManager::CODICON;
+    FontsManager::SizeLevel fontSize = FontsManager::MD;
+    ImVec4 backgroundColor = Config::Color::TRANSPARENT_COL;
+    ImVec4 hoverColor = Config::Color::SECONDARY;
+    ImVec4 activeColor = Config::Color::PRIMARY;
+    ImVec4 textColor = ImVec4(1.0F, 1.0F, 1.0F, 1.0F);
+    ImVec4 borderColor = Config::Color::TRANSPARENT_COL;
+    float borderSize = 0.0F;
+    ButtonState state = ButtonState::NORMAL;
+    Alignment alignment = Alignment::CENTER;
+    const char* tooltip = nullptr;
+};
+
+/**
+ * @brief Look of a label drawn with Label::draw; the plain-value counterpart of LabelConfig.
+ */
+struct LabelStyle
+{
+    const char* icon = nullptr;
+    ImVec2 size;
+    float iconPaddingX = 5.0F;
+    float iconPaddingY = 5.0F;
+    float gap = 5.0F;
+    FontsManager::FontType fontType = FontsManager::REGULAR;
+    FontsManager::IconType iconType = FontsManager::CODICON;
+    FontsManager::SizeLevel fontSize = FontsManager::MD;
+    Alignment alignment = Alignment::CENTER;
+    ImVec4 color = ImVec4(1.0F, 1.0F, 1.0F, 1.0F);
+};
+
+/**
+ * @brief Id of one of many widgets of the same kind, such as the delete button of each row.
+ *
+ * Hashes the index into the id of the name instead of formatting "name + index" strings.
+ */
+ImGuiID makeWidgetId(const char* name, int index)
+{
+    return ImHashData(&index, sizeof(index), ImGui::GetID(name));
+}
+
 /**
  * @brief A struct to store the configuration for an input field
  *
@@ -86,11 +138,11 @@ struct LabelConfig
  */
 struct InputFieldConfig
 {
-    std::string id;
+    const char *id;
     ImVec2 size;
     std::string &inputTextBuffer;
     bool &focusInputField;
-    std::string placeholderText = "";
+    const char *placeholderText = "";
     ImGuiInputTextFlags flags = ImGuiInputTextFlags_None;
     std::function<void(const std::string &)> processInput;
     float frameRounding = Config::InputField::FRAME_ROUNDING;
@@ -102,7 +154,7 @@ struct InputFieldConfig
 
     // Constructor
     InputFieldConfig(
-        const std::string &id,
+        const char *id,
         const ImVec2 &size,
         std::string &inputTextBuffer,
         bool &focusInputField)
@@ -127,59 +179,104 @@ struct ModalConfig
 
 namespace Label
 {
+    LabelStyle toStyle(const LabelConfig &config)
+    {
+        LabelStyle style;
+        style.icon = config.icon.has_value() ? config.icon->c_str() : nullptr;
+        style.size = config.size;
+        style.iconPaddingX = config.iconPaddingX.value_or(5.0F);
+        style.iconPaddingY = config.iconPaddingY.value_or(5.0F);
+        style.gap = config.gap.value_or(5.0F);
+        style.fontType = config.fontType.value_or(FontsManager::REGULAR);
+        style.iconType = config.iconType.value_or(FontsManager::CODICON);
+        style.fontSize = config.fontSize.value_or(FontsManager::MD);
+        style.alignment = config.alignment.value_or(Alignment::CENTER);
+        style.color = config.color.value_or(ImVec4(1.0F, 1.0F, 1.0F, 1.0F));
+        return style;
+    }
+
     /**
-     * @brief Renders a label with the specified configuration.
+     * @brief Number of leading bytes of text that fit in maxWidth with the current font,
+     * ending on a UTF-8 character boundary.
+     */
+    size_t fitText(std::string_view text, float maxWidth)
+    {
+        size_t left = 0;
+        size_t right = text.size();
+        while (left < right)
+        {
+            size_t mid = (left + right + 1) / 2;
+            if (ImGui::CalcTextSize(text.data(), text.data() + mid).x <= maxWidth)
+            {
+                left = mid;
+            }
+            else
+            {
+                right = mid - 1;
+            }
+        }
+
+        while (left > 0 && left < text.size() && (static_cast<unsigned char>(text[left]) & 0xC0) == 0x80)
+        {
+            --left;
+        }
+        return left;
+    }
+
+    /**
+     * @brief Renders a label at the cursor. Does not allocate.
      *
-     * @param config The configuration for the label.
+     * @param label The text of the label; it does not need to be null-terminated.
+     * @param style The look of the label.
      */
-    void render(const LabelConfig &config)
+    void draw(std::string_view label, const LabelStyle &style = LabelStyle())
     {
-        bool hasIcon = !config.icon.value().empty();
+        bool hasIcon = style.icon != nullptr && style.icon[0] != '\0';
 
-        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + config.iconPaddingX.value());
-        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + config.iconPaddingY.value());
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + style.iconPaddingX);
+        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + style.iconPaddingY);
 
         if (hasIcon)
         {
-            ImFont *iconFont = FontsManager::GetInstance().GetIconFont(config.iconType.value(), config.fontSize.value());
+            ImFont *iconFont = FontsManager::GetInstance().GetIconFont(style.iconType, style.fontSize);
             ImGui::PushFont(iconFont);
 
             // Set icon color
-            ImGui::PushStyleColor(ImGuiCol_Text, config.color.value());
+            ImGui::PushStyleColor(ImGuiCol_Text, style.color);
 
             // Render icon
-            ImGui::Text("%s", config.icon.value().c_str());
-            ImGui::SameLine(0, (config.size.x / 4) + config.gap.value());
+            ImGui::TextUnformatted(style.icon);
+            ImGui::SameLine(0, (style.size.x / 4) + style.gap);
 
             ImGui::PopFont();       // Pop icon font
             ImGui::PopStyleColor(); // Pop icon color
         }
 
         // Render label text with specified font type
-        ImGui::PushFont(FontsManager::GetInstance().GetMarkdownFont(config.fontType.value(), config.fontSize.value()));
+        ImGui::PushFont(FontsManager::GetInstance().GetMarkdownFont(style.fontType, style.fontSize));
 
         // Set label color
-        ImGui::PushStyleColor(ImGuiCol_Text, config.color.value());
+        ImGui::PushStyleColor(ImGuiCol_Text, style.color);
 
-        ImGui::Text("%s", config.label.c_str());
+        ImGui::TextUnformatted(label.data(), label.data() + label.size());
 
         ImGui::PopFont();
         ImGui::PopStyleColor();
     }
 
     /**
-     * @brief Renders a label with the specified configuration inside a rectangle.
+     * @brief Renders a label inside a rectangle, cutting it short with "..." if it does not
+     * fit. Does not allocate.
      *
-     * @param config The configuration for the input field.
+     * @param label The text of the label; it does not need to be null-terminated.
      * @param rectMin The minimum position of the rectangle.
      * @param rectMax The maximum position of the rectangle.
-     *
-     * @see Config::LabelConfig
+     * @param style The look of the label.
      */
-    void render(const LabelConfig &config, ImVec2 rectMin, ImVec2 rectMax)
+    void draw(std::string_view label, ImVec2 rectMin, ImVec2 rectMax, const LabelStyle &style = LabelStyle())
     {
-        bool hasIcon = !config.icon.value().empty();
-        bool hasLabel = !config.label.empty();
+        bool hasIcon = style.icon != nullptr && style.icon[0] != '\0';
+        bool hasLabel = !label.empty();
 
         // Compute the size of the rectangle
         ImVec2 rectSize = ImVec2(rectMax.x - rectMin.x, rectMax.y - rectMin.y);
@@ -192,60 +289,37 @@ namespace Label
         float iconPlusGapWidth = 0.0f;
         if (hasIcon)
         {
-            ImGui::PushFont(FontsManager::GetInstance().GetIconFont(config.iconType.value(), config.fontSize.value()));
+            ImGui::PushFont(FontsManager::GetInstance().GetIconFont(style.iconType, style.fontSize));
 
-            iconSize = ImGui::CalcTextSize(config.icon.value().c_str());
+            iconSize = ImGui::CalcTextSize(style.icon);
             ImGui::PopFont();
 
             // Add gap to icon width if we have both icon and label
-            iconPlusGapWidth = hasLabel ? (iconSize.x + config.gap.value_or(0.0f)) : iconSize.x;
+            iconPlusGapWidth = hasLabel ? (iconSize.x + style.gap) : iconSize.x;
         }
 
         // Calculate available width for label
-        float availableLabelWidth = rectSize.x - iconPlusGapWidth - (2 * config.gap.value_or(5.0f));
+        float availableLabelWidth = rectSize.x - iconPlusGapWidth - (2 * style.gap);
 
-        // Calculate label size and prepare truncated text if needed
+        // Calculate label size and how much of the label fits
         ImVec2 labelSize(0, 0);
-        std::string truncatedLabel;
+        size_t visibleLength = label.size();
+        bool truncated = false;
         if (hasLabel)
         {
-            ImGui::PushFont(FontsManager::GetInstance().GetMarkdownFont(config.fontType.value(), config.fontSize.value()));
+            ImGui::PushFont(FontsManager::GetInstance().GetMarkdownFont(style.fontType, style.fontSize));
 
-            labelSize = ImGui::CalcTextSize(config.label.c_str());
+            labelSize = ImGui::CalcTextSize(label.data(), label.data() + label.size());
 
-            // If label is too wide, we need to truncate it
+            // If label is too wide, show as much as fits followed by an ellipsis
             if (labelSize.x > availableLabelWidth)
             {
                 float ellipsisWidth = ImGui::CalcTextSize("...").x;
-                float targetWidth = availableLabelWidth - ellipsisWidth;
-
-                // Binary search to find the right truncation point
-                size_t left = 0;
-                size_t right = config.label.length();
-                truncatedLabel = config.label;
+                visibleLength = fitText(label, availableLabelWidth - ellipsisWidth);
+                truncated = true;
 
-                while (left < right)
-                {
-                    size_t mid = (left + right + 1) / 2;
-                    std::string testStr = config.label.substr(0, mid);
-                    float testWidth = ImGui::CalcTextSize(testStr.c_str()).x;
-
-                    if (testWidth <= targetWidth)
-                    {
-                        left = mid;
-                    }
-                    else
-                    {
-                        right = mid - 1;
-                    }
-                }
-
-                truncatedLabel = config.label.substr(0, left) + "...";
-                labelSize = ImGui::CalcTextSize(truncatedLabel.c_str());
-            }
-            else
-            {
-                truncatedLabel = config.label;
+                labelSize = ImGui::CalcTextSize(label.data(), label.data() + visibleLength);
+                labelSize.x += ellipsisWidth;
             }
 
             ImGui::PopFont();
@@ -260,17 +334,16 @@ namespace Label
 
         // Calculate horizontal offset based on alignment
         float horizontalOffset;
-        Alignment alignment = config.alignment.value_or(Alignment::LEFT);
-        switch (alignment)
+        switch (style.alignment)
         {
         case Alignment::CENTER:
             horizontalOffset = rectMin.x + (rectSize.x - contentWidth) / 2.0f;
             break;
         case Alignment::RIGHT:
-            horizontalOffset = rectMin.x + (rectSize.x - contentWidth) - config.gap.value_or(5.0f);
+            horizontalOffset = rectMin.x + (rectSize.x - contentWidth) - style.gap;
             break;
         default:
-            horizontalOffset = rectMin.x + config.gap.value_or(5.0f);
+            horizontalOffset = rectMin.x + style.gap;
             break;
         }
 
@@ -280,30 +353,36 @@ namespace Label
         // Now render the icon and/or label
         if (hasIcon)
         {
-            ImGui::PushFont(FontsManager::GetInstance().GetIconFont(config.iconType.value(), config.fontSize.value()));
+            ImGui::PushFont(FontsManager::GetInstance().GetIconFont(style.iconType, style.fontSize));
 
             // Set icon color
-            ImGui::PushStyleColor(ImGuiCol_Text, config.color.value());
+            ImGui::PushStyleColor(ImGuiCol_Text, style.color);
 
-            ImGui::TextUnformatted(config.icon.value().c_str());
+            ImGui::TextUnformatted(style.icon);
             if (hasLabel)
             {
-                ImGui::SameLine(0.0f, config.gap.value_or(0.0f));
+                ImGui::SameLine(0.0f, style.gap);
             }
 
             ImGui::PopFont();
             ImGui::PopStyleColor();
         }
 
-        // Render truncated label text with specified font weight, if it exists
+        // Render the visible part of the label with specified font weight, if it exists
         if (hasLabel)
         {
-            ImGui::PushFont(FontsManager::GetInstance().GetMarkdownFont(config.fontType.value(), config.fontSize.value()));
+            ImGui::PushFont(FontsManager::GetInstance().GetMarkdownFont(style.fontType, style.fontSize));
 
             // Set label color
-            ImGui::PushStyleColor(ImGuiCol_Text, config.color.value());
+            ImGui::PushStyleColor(ImGuiCol_Text, style.color);
+
+            ImGui::TextUnformatted(label.data(), label.data() + visibleLength);
+            if (truncated)
+            {
+                ImGui::SameLine(0.0f, 0.0f);
+                ImGui::TextUnformatted("...");
+            }
 
-            ImGui::TextUnformatted(truncatedLabel.c_str());
             ImGui::PopFont();
             ImGui::PopStyleColor();
         }
@@ -312,6 +391,50 @@ namespace Label
         ImGui::PopClipRect();
     }
 
+    /**
+     * @brief Renders a label with the specified configuration.
+     *
+     * @param config The configuration for the label.
+     */
+    void render(const LabelConfig &config)
+    {
+        draw(config.label, toStyle(config));
+    }
+
+    /**
+     * @brief Renders a label with the specified configuration inside a rectangle.
+     *
+     * @param config The configuration for the input field.
+     * @param rectMin The minimum position of the rectangle.
+     * @param rectMax The maximum position of the rectangle.
+     *
+     * @see Config::LabelConfig
+     */
+    void render(const LabelConfig &config, ImVec2 rectMin, ImVec2 rectMax)
+    {
+        LabelStyle style = toStyle(config);
+        style.alignment = config.alignment.value_or(Alignment::LEFT);
+        draw(config.label, rectMin, rectMax, style);
+    }
+
+    /**
+     * @brief Display text of an id such as "##random_seed": hashes are dropped and underscores
+     * become spaces. The text is written to buffer and cut to fit it.
+     */
+    template <size_t N>
+    std::string_view fromId(const char *id, char (&buffer)[N])
+    {
+        size_t length = 0;
+        for (const char *c = id; *c != '\0' && length < N; ++c)
+        {
+            if (*c != '#')
+            {
+                buffer[length++] = *c == '_' ? ' ' : *c;
+            }
+        }
+        return std::string_view(buffer, length);
+    }
+
     void renderMultiline(const LabelConfig &config, std::optional<int> maxLines = std::nullopt)
     {
         bool hasIcon = !config.icon.value().empty();
@@ -416,35 +539,36 @@ namespace Label
 namespace Button
 {
     /**
-     * @brief Renders a single button with the specified configuration.
+     * @brief Renders a button. Does not allocate.
      *
-     * @param config The configuration for the button.
+     * @param id The id of the button, see makeWidgetId for buttons repeated per row.
+     * @param label The text of the button; it does not need to be null-terminated.
+     * @param size The size of the button.
+     * @param style The look and state of the button.
+     * @return true if the button was clicked while in the NORMAL state.
      */
-    void render(const ButtonConfig &config)
+    bool draw(ImGuiID id, std::string_view label, ImVec2 size, const ButtonStyle &style = ButtonStyle())
     {
-        // Handle button state and styles as before
-        ButtonState currentState = config.state.value_or(ButtonState::NORMAL);
-
-        switch (currentState)
+        switch (style.state)
         {
         case ButtonState::DISABLED:
-            ImGui::PushStyleColor(ImGuiCol_Button, config.activeColor.value());
-            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, config.activeColor.value());
-            ImGui::PushStyleColor(ImGuiCol_ButtonActive, config.activeColor.value());
+            ImGui::PushStyleColor(ImGuiCol_Button, style.activeColor);
+            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, style.activeColor);
+            ImGui::PushStyleColor(ImGuiCol_ButtonActive, style.activeColor);
 
             ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5F);
             break;
         case ButtonState::ACTIVE:
-            ImGui::PushStyleColor(ImGuiCol_Button, config.activeColor.value());
-            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, config.activeColor.value());
-            ImGui::PushStyleColor(ImGuiCol_ButtonActive, config.activeColor.value());
+            ImGui::PushStyleColor(ImGuiCol_Button, style.activeColor);
+            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, style.activeColor);
+            ImGui::PushStyleColor(ImGuiCol_ButtonActive, style.activeColor);
 
             ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 1.0F);
             break;
         default:
-            ImGui::PushStyleColor(ImGuiCol_Button, config.backgroundColor.value());
-            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, config.hoverColor.value());
-            ImGui::PushStyleColor(ImGuiCol_ButtonActive, config.activeColor.value());
+            ImGui::PushStyleColor(ImGuiCol_Button, style.backgroundColor);
+            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, style.hoverColor);
+            ImGui::PushStyleColor(ImGuiCol_ButtonActive, style.activeColor);
 
             ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 1.0F);
             break;
@@ -454,43 +578,94 @@ namespace Button
         ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, Config::Button::RADIUS);
 
         // Set the border size and color for the button
-        ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, config.borderSize.value_or(0.0F));
-        ImGui::PushStyleColor(ImGuiCol_Border, config.borderColor.value_or(Config::Color::TRANSPARENT_COL));
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, style.borderSize);
+        ImGui::PushStyleColor(ImGuiCol_Border, style.borderColor);
+
+        // Render the frame with an empty label under the given id
+        ImGui::PushOverrideID(id);
+        bool clicked = ImGui::Button("##button", size) && style.state == ButtonState::NORMAL;
+        ImGui::PopID();
 
-        // Render the button with an empty label
-        if (ImGui::Button(config.id.c_str(), config.size) &&
-            config.onClick && currentState != ButtonState::DISABLED && currentState != ButtonState::ACTIVE)
+        if (style.tooltip != nullptr && style.tooltip[0] != '\0' && ImGui::IsItemHovered())
         {
-            config.onClick();
+            ImGui::SetTooltip("%s", style.tooltip);
         }
 
-		if (!config.tooltip.value().empty() && ImGui::IsItemHovered())
-		{
-			ImGui::SetTooltip(config.tooltip.value().c_str());
-		}
-
-        // Get the rectangle of the button
-        ImVec2 buttonMin = ImGui::GetItemRectMin();
-        ImVec2 buttonMax = ImGui::GetItemRectMax();
-
-        // Prepare the label configuration
-        LabelConfig labelConfig;
-        labelConfig.id = config.id;
-        labelConfig.label = config.label.value_or("");
-        labelConfig.icon = config.icon.value_or("");
-        labelConfig.size = config.size;
-        labelConfig.fontType = config.fontType.value_or(FontsManager::REGULAR);
-        labelConfig.iconType = config.iconType.value_or(FontsManager::CODICON);
-        labelConfig.gap = config.gap.value_or(5.0f);
-        labelConfig.alignment = config.alignment.value_or(Alignment::CENTER);
-        labelConfig.color = config.textColor.value_or(ImVec4(1.0f, 1.0f, 1.0f, 1.0f));
-
         // Render the label inside the button's rectangle
-        Label::render(labelConfig, buttonMin, buttonMax);
+        LabelStyle labelStyle;
+        labelStyle.icon = style.icon;
+        labelStyle.size = size;
+        labelStyle.gap = style.gap;
+        labelStyle.fontType = style.fontType;
+        labelStyle.iconType = style.iconType;
+        labelStyle.fontSize = style.fontSize;
+        labelStyle.alignment = style.alignment;
+        labelStyle.color = style.textColor;
+        Label::draw(label, ImGui::GetItemRectMin(), ImGui::GetItemRectMax(), labelStyle);
 
         // Pop styles
         ImGui::PopStyleColor(4);
         ImGui::PopStyleVar(3);
+
+        return clicked;
+    }
+
+    bool draw(const char *id, std::string_view label, ImVec2 size, const ButtonStyle &style = ButtonStyle())
+    {
+        return draw(ImGui::GetID(id), label, size, style);
+    }
+
+    /**
+     * @brief Lays out buttons from left to right, like renderGroup, as they are drawn.
+     */
+    class Row
+    {
+    public:
+        Row(float startX, float startY, float spacing = Config::Button::SPACING)
+            : m_x(startX), m_y(startY), m_spacing(spacing) {}
+
+        template <typename Id>
+        bool draw(Id id, std::string_view label, ImVec2 size, const ButtonStyle &style = ButtonStyle())
+        {
+            ImGui::SetCursorPos(ImVec2(m_x, m_y));
+            m_x += size.x + m_spacing;
+            return Button::draw(id, label, size, style);
+        }
+
+    private:
+        float m_x;
+        float m_y;
+        float m_spacing;
+    };
+
+    /**
+     * @brief Renders a single button with the specified configuration.
+     *
+     * @param config The configuration for the button.
+     */
+    void render(const ButtonConfig &config)
+    {
+        ButtonStyle style;
+        style.icon = config.icon.has_value() ? config.icon->c_str() : nullptr;
+        style.gap = config.gap.value_or(5.0F);
+        style.fontType = config.fontType.value_or(FontsManager::REGULAR);
+        style.iconType = config.iconType.value_or(FontsManager::CODICON);
+        style.fontSize = config.fontSize.value_or(FontsManager::MD);
+        style.backgroundColor = config.backgroundColor.value_or(Config::Color::TRANSPARENT_COL);
+        style.hoverColor = config.hoverColor.value_or(Config::Color::SECONDARY);
+        style.activeColor = config.activeColor.value_or(Config::Color::PRIMARY);
+        style.textColor = config.textColor.value_or(ImVec4(1.0F, 1.0F, 1.0F, 1.0F));
+        style.borderColor = config.borderColor.value_or(Config::Color::TRANSPARENT_COL);
+        style.borderSize = config.borderSize.value_or(0.0F);
+        style.state = config.state.value_or(ButtonState::NORMAL);
+        style.alignment = config.alignment.value_or(Alignment::CENTER);
+        style.tooltip = config.tooltip.has_value() ? config.tooltip->c_str() : nullptr;
+
+        std::string_view label = config.label.has_value() ? std::string_view(*config.label) : std::string_view();
+        if (draw(config.id.c_str(), label, config.size, style) && config.onClick)
+        {
+            config.onClick();
+        }
     }
 
     /**
@@ -604,7 +779,7 @@ namespace InputField
         ImGui::PushTextWrapPos(ImGui::GetCursorPosX() + config.size.x - 15);
 
         // Draw the input field
-        if (ImGui::InputTextMultiline(config.id.c_str(), config.inputTextBuffer.data(), Config::InputField::TEXT_SIZE, config.size, config.flags) && config.processInput)
+        if (ImGui::InputTextMultiline(config.id, config.inputTextBuffer.data(), Config::InputField::TEXT_SIZE, config.size, config.flags) && config.processInput)
         {
             InputField::handleSubmission(config.inputTextBuffer.data(), config.focusInputField, config.processInput,
                                          (config.flags & ImGuiInputTextFlags_CtrlEnterForNewLine) ||
@@ -640,7 +815,7 @@ namespace InputField
                 ImGui::GetFontSize(),
                 placeholderPos,
                 placeholderColor,
-                config.placeholderText.c_str(),
+                config.placeholderText,
                 nullptr,
                 wrapWidth);
         }
@@ -698,7 +873,7 @@ namespace InputField
         ImGuiInputTextFlags flags = config.flags | ImGuiInputTextFlags_CallbackResize;
 
         // Draw the input field
-        if (ImGui::InputText(config.id.c_str(), (char *)config.inputTextBuffer.c_str(), config.inputTextBuffer.capacity() + 1, flags, callback, &user_data) && config.processInput)
+        if (ImGui::InputText(config.id, (char *)config.inputTextBuffer.c_str(), config.inputTextBuffer.capacity() + 1, flags, callback, &user_data) && config.processInput)
         {
             handleSubmission((char *)config.inputTextBuffer.c_str(), config.focusInputField, config.processInput, false);
         }
@@ -723,7 +898,7 @@ namespace InputField
             ImU32 placeholderColor = ImGui::GetColorU32(ImVec4(0.7f, 0.7f, 0.7f, 1.0f));
 
             // Render the placeholder text
-            drawList->AddText(placeholderPos, placeholderColor, config.placeholderText.c_str());
+            drawList->AddText(placeholderPos, placeholderColor, config.placeholderText);
         }
 
         // Restore original style
@@ -747,18 +922,10 @@ namespace Slider
      */
     void render(const char *label, float &value, float minValue, float maxValue, const float sliderWidth, const char *format = "%.2f", const float paddingX = 5.0F, const float inputWidth = 32.0F)
     {
-        // Get the render label by stripping ## from the label and replacing _ with space
-        std::string renderLabel = label;
-        renderLabel.erase(std::remove(renderLabel.begin(), renderLabel.end(), '#'), renderLabel.end());
-        std::replace(renderLabel.begin(), renderLabel.end(), '_', ' ');
-
         // Apply horizontal padding and render label
         ImGui::SetCursorPosX(ImGui::GetCursorPosX() + paddingX);
-        LabelConfig labelConfig;
-        labelConfig.id = label;
-        labelConfig.label = renderLabel;
-        labelConfig.size = ImVec2(0, 0);
-        Label::render(labelConfig);
+        char renderLabel[64];
+        Label::draw(Label::fromId(label, renderLabel));
 
         // Move the cursor to the right edge minus the input field width and padding
         ImGui::SameLine();
@@ -786,7 +953,8 @@ namespace Slider
 
         // Render the input field with the adjusted width
         ImGui::PushItemWidth(adjustedInputWidth);
-        if (ImGui::InputFloat((std::string(label) + "_input").c_str(), &value, 0.0f, 0.0f, format))
+        ImGui::PushID(label);
+        if (ImGui::InputFloat("##input", &value, 0.0f, 0.0f, format))
         {
             // Clamp the value within the specified range
             if (value < minValue)
@@ -794,6 +962,7 @@ namespace Slider
             if (value > maxValue)
                 value = maxValue;
         }
+        ImGui::PopID();
         ImGui::PopItemWidth();
 
         // Restore previous styling
@@ -843,18 +1012,10 @@ namespace IntInputField
      */
     void render(const char *label, int &value, const float inputWidth, const float paddingX = 5.0F)
     {
-        // Get the render label by stripping ## from the label and replacing _ with space
-        std::string renderLabel = label;
-        renderLabel.erase(std::remove(renderLabel.begin(), renderLabel.end(), '#'), renderLabel.end());
-        std::replace(renderLabel.begin(), renderLabel.end(), '_', ' ');
-
         // Apply horizontal padding and render label
         ImGui::SetCursorPosX(ImGui::GetCursorPosX() + paddingX);
-        LabelConfig labelConfig;
-        labelConfig.id = label;
-        labelConfig.label = renderLabel;
-        labelConfig.size = ImVec2(0, 0);
-        Label::render(labelConfig);
+        char renderLabel[64];
+        Label::draw(Label::fromId(label, renderLabel));
 
         ImGui::SetCursorPosY(ImGui::GetCursorPosY());
         ImGui::SetCursorPosX(ImGui::GetCursorPosX() + paddingX);
@@ -9,6 +9,8 @@
 #include <imgui_impl_opengl3.h>
 #include <imgui_internal.h>
 
+#include "profiling/memory_tracker.hpp"
+
 GLuint g_shaderProgram = 0;
 GLuint g_gradientTexture = 0;
 
@@ -113,6 +115,8 @@ namespace GradientBackground {
 
         // Upload the gradient data to the texture
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, gradientData.data());
+        Profiling::MemoryTracker::getInstance().set(
+            Profiling::MemorySubsystem::GradientTexture, static_cast<int64_t>(width) * height * 4);
 
         // Set texture parameters
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -241,6 +245,7 @@ namespace GradientBackground {
         {
             glDeleteTextures(1, &g_gradientTexture);
             g_gradientTexture = 0;
+            Profiling::MemoryTracker::getInstance().set(Profiling::MemorySubsystem::GradientTexture, 0);
         }
         if (g_quadVAO != 0)
         {
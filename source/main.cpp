@@ -6,19 +6,27 @@
 
 #include "ui/fonts.hpp"
 #include "ui/title_bar.hpp"
-#include "ui/chat/chat_history_sidebar.hpp"
-#include "ui/chat/chat_section.hpp"
-#include "ui/chat/preset_sidebar.hpp"
+#include "ui/playground.hpp"
+#include "ui/startup_skeleton.hpp"
+#include "ui/performance_overlay.hpp"
 
 #include "chat/chat_manager.hpp"
+#include "chat/chat_title_generator.hpp"
+#include "chat/chat_history_summarizer.hpp"
 #include "model/preset_manager.hpp"
 #include "model/model_manager.hpp"
 
+#include "profiling/startup_timeline.hpp"
+#include "profiling/trace.hpp"
+#include "profiling/frame_stats.hpp"
+#include "profiling/memory_tracker.hpp"
+
 #include "nfd.h"
 
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <future>
 #include <imgui.h>
 #include <imgui_impl_win32.h>
 #include <imgui_impl_opengl3.h>
@@ -124,11 +132,44 @@ void InitializeGradientBackground(int display_w, int display_h)
     GradientBackground::setupFullScreenQuad();
 }
 
-void renderPlayground(float& chatHistorySidebarWidth, float& modelPresetSidebarWidth)
+template <typename T>
+bool IsFutureReady(const std::future<T>& future)
 {
-    renderChatHistorySidebar(chatHistorySidebarWidth);
-    renderModelPresetSidebar(modelPresetSidebarWidth);
-    renderChatWindow(Config::INPUT_HEIGHT, chatHistorySidebarWidth, modelPresetSidebarWidth);
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// Applies streamed output to the chats once per frame, batching all deltas of a job
+void DrainTokenStreams()
+{
+    auto& chatManager = Chat::ChatManager::getInstance();
+    auto& modelManager = Model::ModelManager::getInstance();
+
+    modelManager.drainTokenStreams(
+        [&chatManager](const int jobId, const std::string& delta, const bool finished, const bool succeeded) {
+            if (!delta.empty())
+            {
+                chatManager.appendJobOutput(jobId, delta);
+            }
+
+            if (finished)
+            {
+                std::string chatName = chatManager.getChatNameByJobId(jobId);
+                chatManager.finishJob(jobId);
+
+                // Name new chats once their first reply is complete
+                if (succeeded)
+                {
+                    Chat::ChatTitleGenerator::getInstance().onResponseCompleted(chatName);
+                    Chat::ChatHistorySummarizer::getInstance().onResponseCompleted(chatName);
+                }
+            }
+        });
+
+    // Keep frames coming while output streams in, even without user input
+    if (modelManager.hasActiveTokenStreams())
+    {
+        ImGui::SetMaxWaitBeforeNextFrame(Config::TokenStream::DRAIN_INTERVAL);
+    }
 }
 
 void StartNewFrame() {
@@ -138,6 +179,26 @@ void StartNewFrame() {
     ImGui::NewFrame();
 }
 
+// The atlas is uploaded by the OpenGL backend on the first frame, so it is reported afterwards
+bool ReportFontAtlasMemory()
+{
+    const ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (atlas->TexWidth <= 0 || atlas->TexHeight <= 0)
+    {
+        return false;
+    }
+
+    const int64_t pixels = static_cast<int64_t>(atlas->TexWidth) * atlas->TexHeight;
+    int64_t bytes = pixels * 4; // RGBA32 texture on the GPU
+    if (atlas->TexPixelsRGBA32)
+        bytes += pixels * 4;
+    if (atlas->TexPixelsAlpha8)
+        bytes += pixels;
+
+    Profiling::MemoryTracker::getInstance().set(Profiling::MemorySubsystem::FontAtlas, bytes);
+    return true;
+}
+
 void EnforceFrameRate(const std::chrono::time_point<std::chrono::high_resolution_clock>& frameStartTime)
 {
     auto frameEndTime = std::chrono::high_resolution_clock::now();
@@ -161,6 +222,10 @@ void HandleException(const std::exception& e)
     int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 #endif
 {
+    auto& timeline = Profiling::StartupTimeline::getInstance();
+    timeline.mark("process_start");
+    KOLOSAL_TRACE_THREAD_NAME("Main");
+
     try 
     {
         // Create the window
@@ -175,46 +240,24 @@ void HandleException(const std::exception& e)
         // Initialize cleanup using RAII
         ScopedCleanup cleanup;
 
+        timeline.mark("window_created");
+
         // Initialize ImGui
         InitializeImGui(*window);
 
-        // Initialize the chat manager, preset manager, and model manager
-        Chat::initializeChatManager();
-        Model::initializePresetManager();
-        Model::initializeModelManager();
-
-		// TODO: encapsulate to have a cleaner code
-        Model::ModelManager::getInstance().setStreamingCallback(
-            [](const std::string& partialOutput, const int jobId) {
-                // Grab the current chat by the tracked jobId:
-                auto& chatManager = Chat::ChatManager::getInstance();
-				std::string chatName = chatManager.getChatNameByJobId(jobId);
-
-                // Append partial output to the *last assistant message*,
-                // or create a new one if the last role isn't "assistant."
-                Chat::ChatHistory chat = chatManager.getChat(chatName).value();
-                if (!chat.messages.empty() && chat.messages.back().role == "assistant")
-                {
-                    // Append to the existing assistant message
-                    chat.messages.back().content = partialOutput;
-					chatManager.updateChat(chatName, chat);
-                }
-                else
-                {
-                    // If, for some reason, we don't have an assistant message to update:
-                    // create a new message with role "assistant"
-                    Chat::Message assistantMsg;
-                    assistantMsg.id = static_cast<int>(chat.messages.size()) + 1;
-                    assistantMsg.role = "assistant";
-                    assistantMsg.content = partialOutput;
-					chatManager.addMessage(chatName, assistantMsg);
-                }
-            }
-        );
-
-        // Initialize NFD (Native File Dialog)
+        // Initialize NFD (Native File Dialog). This makes the main thread a COM STA, which has
+        // to happen before the model manager's warm-up thread sets the process-wide COM
+        // security for its GPU probe
         NFD_Init();
 
+        // Initialize the chat manager, preset manager, and model manager in parallel;
+        // the UI shows a skeleton until all three are ready
+        std::future<void> chatManagerReady   = std::async(std::launch::async, Chat::initializeChatManager);
+        std::future<void> presetManagerReady = std::async(std::launch::async, Model::initializePresetManager);
+        std::future<void> modelManagerReady  = std::async(std::launch::async, Model::initializeModelManager);
+        bool managersReady = false;
+        bool interactive = false;
+
         // Get initial window size
         int display_w = window->getWidth();
         int display_h = window->getHeight();
@@ -229,26 +272,91 @@ void HandleException(const std::exception& e)
         float chatHistorySidebarWidth = Config::ChatHistorySidebar::SIDEBAR_WIDTH;
         float modelPresetSidebarWidth = Config::ModelPresetSidebar::SIDEBAR_WIDTH;
 
+        bool showPerformanceOverlay = false;
+        bool fontAtlasReported = false;
+
         // Enter the main loop
         while (!window->shouldClose()) 
         {
+            KOLOSAL_TRACE_SCOPE("Frame", "frame");
             auto frameStartTime = std::chrono::high_resolution_clock::now();
 
-            window->processEvents();
+            if (!managersReady &&
+                IsFutureReady(chatManagerReady) &&
+                IsFutureReady(presetManagerReady) &&
+                IsFutureReady(modelManagerReady))
+            {
+                // Rethrow any initialization failure on the main thread
+                chatManagerReady.get();
+                presetManagerReady.get();
+                modelManagerReady.get();
+
+                managersReady = true;
+                timeline.mark("managers_ready");
+            }
+
+            {
+                Profiling::ScopedFrameStage stage(Profiling::FrameStage::ProcessEvents);
+                window->processEvents();
+            }
 
             // Update window state transition
             transitionManager.updateTransition();
 
-            StartNewFrame();
+            {
+                Profiling::ScopedFrameStage stage(Profiling::FrameStage::NewFrame);
+                StartNewFrame();
+            }
 
-            // Render title bar
-            titleBar(window->getNativeHandle());
+            if (!fontAtlasReported)
+            {
+                fontAtlasReported = ReportFontAtlasMemory();
+            }
+
+            {
+                Profiling::ScopedFrameStage stage(Profiling::FrameStage::BuildUI);
 
-			// Render the chat section
-            renderPlayground(chatHistorySidebarWidth, modelPresetSidebarWidth);
+                // Render title bar
+                titleBar(window->getNativeHandle());
+
+                // Render the chat section, or its placeholder while the managers load
+                if (managersReady)
+                {
+                    DrainTokenStreams();
+                    renderPlayground(chatHistorySidebarWidth, modelPresetSidebarWidth);
+                }
+                else
+                {
+                    renderStartupSkeleton(chatHistorySidebarWidth, modelPresetSidebarWidth);
+                }
+
+                if (ImGui::IsKeyPressed(Config::PerformanceOverlay::TOGGLE_KEY, false))
+                {
+                    showPerformanceOverlay = !showPerformanceOverlay;
+                }
+                if (showPerformanceOverlay)
+                {
+                    renderPerformanceOverlay(managersReady);
+                }
+
+                if (ImGui::IsKeyPressed(Config::Memory::DUMP_KEY, false))
+                {
+                    Profiling::MemoryTracker::getInstance().dump(std::cout);
+                }
+            }
+
+#ifdef KOLOSAL_ENABLE_TRACING
+            if (ImGui::IsKeyPressed(Config::Tracing::DUMP_KEY, false))
+            {
+                Profiling::Tracer::getInstance().dumpChromeTrace(Config::Tracing::DUMP_FILE);
+            }
+#endif
 
             // Render the ImGui frame
-            ImGui::Render();
+            {
+                Profiling::ScopedFrameStage stage(Profiling::FrameStage::ImGuiRender);
+                ImGui::Render();
+            }
 
             // Get updated window size
             int new_display_w = window->getWidth();
@@ -262,20 +370,51 @@ void HandleException(const std::exception& e)
                 glViewport(0, 0, display_w, display_h);
             }
 
-            GradientBackground::renderGradientBackground(
-                display_w,
-                display_h,
-                transitionManager.getTransitionProgress(),
-                transitionManager.getEasedProgress()
-            );
+            {
+                Profiling::ScopedFrameStage stage(Profiling::FrameStage::RenderGradient);
+                GradientBackground::renderGradientBackground(
+                    display_w,
+                    display_h,
+                    transitionManager.getTransitionProgress(),
+                    transitionManager.getEasedProgress()
+                );
+            }
+
+            {
+                Profiling::ScopedFrameStage stage(Profiling::FrameStage::RenderDrawData);
+                ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            }
+
+            {
+                Profiling::ScopedFrameStage stage(Profiling::FrameStage::SwapBuffers);
+                openglContext->swapBuffers();
+            }
+
+            timeline.mark("first_frame");
 
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            // Interactive once a message can be sent: the selected model is warm, or there is
+            // no model to wait for
+            if (managersReady && !interactive)
+            {
+                auto& modelManager = Model::ModelManager::getInstance();
+                if (modelManager.isModelReady() || !modelManager.getCurrentModelName().has_value())
+                {
+                    timeline.mark("interactive");
+                    interactive = true;
+                }
+            }
 
-            openglContext->swapBuffers();
+            Profiling::FrameStats::getInstance().endFrame(
+                std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - frameStartTime).count());
 
-            EnforceFrameRate(frameStartTime);
+            {
+                KOLOSAL_TRACE_SCOPE("EnforceFrameRate", "frame");
+                EnforceFrameRate(frameStartTime);
+            }
         }
 
+        timeline.save();
+
         return 0;
     }
     catch (const std::exception& e) {